@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <pthread.h>
+#include "admission.h"
+#include "logger.h"
+#include "metrics.h"
+
+#define ADMISSION_BUCKETS 4096      // Hash buckets (power of two)
+#define ADMISSION_STRIPES 64        // Bucket locks; bucket i is guarded by stripe i % ADMISSION_STRIPES
+
+// ========================================================================== //
+//                             CONFIGURATION                                  //
+// ========================================================================== //
+
+static int admission_enabled = 0;   // Set once by admission_init(), before the daemon starts
+static double client_rate = ADMISSION_DEFAULT_RATE;
+static double client_burst = ADMISSION_DEFAULT_BURST;
+static size_t max_in_flight = ADMISSION_DEFAULT_INFLIGHT;
+
+// Quarters of max_in_flight each class may fill, indexed by AdmissionClass
+static const size_t class_share[ADMISSION_CLASS_COUNT] = { 2, 3, 4 };
+
+// Counters, accessed with __atomic builtins
+static size_t in_flight = 0;
+static size_t client_count = 0;
+static unsigned long long rate_limited_count = 0;
+static unsigned long long shed_count[ADMISSION_CLASS_COUNT];
+
+static int parse_rate_limit(const char* value) {
+    if (0 == strcmp(value, "0")) {
+        client_rate = 0;
+        return 1;
+    }
+    char* end;
+    double rate = strtod(value, &end);
+    if (end == value || *end != '/' || rate <= 0) return 0;
+    const char* burst_str = end + 1;
+    double burst = strtod(burst_str, &end);
+    if (end == burst_str || *end != '\0' || burst < 1) return 0;
+    client_rate = rate;
+    client_burst = burst;
+    return 1;
+}
+
+void admission_init(void) {
+    const char* rate_env = getenv("MENTOR_RATE_LIMIT");
+    if (rate_env && *rate_env && !parse_rate_limit(rate_env)) {
+        LOG_WARN("Ignoring invalid MENTOR_RATE_LIMIT '%s' (expected <rate>/<burst> or 0)", rate_env);
+    }
+    const char* inflight_env = getenv("MENTOR_MAX_INFLIGHT");
+    if (inflight_env && *inflight_env) {
+        char* end;
+        long value = strtol(inflight_env, &end, 10);
+        if (*end != '\0' || value < 0) LOG_WARN("Ignoring invalid MENTOR_MAX_INFLIGHT '%s'", inflight_env);
+        else max_in_flight = (size_t)value;
+    }
+    admission_enabled = 1;
+    if (client_rate > 0) LOG_INFO("Rate limit: %.1f requests/s per client, bursts of %.0f", client_rate, client_burst);
+    else LOG_INFO("Rate limit: off");
+    if (max_in_flight > 0) LOG_INFO("Load shedding above %zu requests in flight", max_in_flight);
+    else LOG_INFO("Load shedding: off");
+}
+
+// ========================================================================== //
+//                              TOKEN BUCKETS                                 //
+// ========================================================================== //
+
+typedef struct ClientBucket {
+    char key[ADMISSION_KEY_MAX];
+    double tokens;
+    uint64_t refilled_ns;           // When 'tokens' was last brought up to date
+    struct ClientBucket* next;
+} ClientBucket;
+
+static ClientBucket* buckets[ADMISSION_BUCKETS];
+static pthread_mutex_t stripes[ADMISSION_STRIPES];
+static pthread_once_t stripes_once = PTHREAD_ONCE_INIT;
+
+static void init_stripes(void) {
+    for (int i = 0; i < ADMISSION_STRIPES; ++i) pthread_mutex_init(&stripes[i], NULL);
+}
+
+static size_t key_bucket(const char* key) {
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (const unsigned char* p = (const unsigned char*)key; *p; ++p) hash = (hash ^ *p) * 16777619u;
+    return hash & (ADMISSION_BUCKETS - 1);
+}
+
+/**
+ * @brief Takes one token from the client's bucket. Returns 1 if there was one,
+ * else 0 with the seconds until there will be. Entries that have refilled
+ * completely are dropped while walking the chain: a full bucket is the same
+ * as no bucket, so forgetting it loses nothing and keeps the table small.
+ */
+static int take_token(const char* key, uint64_t now_ns, int* retry_after_s) {
+    size_t bucket = key_bucket(key);
+    uint64_t idle_full_ns = (uint64_t)(client_burst / client_rate * 1e9);
+    pthread_mutex_t* stripe = &stripes[bucket % ADMISSION_STRIPES];
+    pthread_mutex_lock(stripe);
+    ClientBucket* found = NULL;
+    for (ClientBucket** link = &buckets[bucket]; *link;) {
+        ClientBucket* entry = *link;
+        if (0 == strcmp(entry->key, key)) {
+            found = entry;
+            link = &entry->next;
+        } else if (now_ns > entry->refilled_ns && now_ns - entry->refilled_ns > idle_full_ns) {
+            *link = entry->next;
+            free(entry);
+            __atomic_sub_fetch(&client_count, 1, __ATOMIC_RELAXED);
+        } else {
+            link = &entry->next;
+        }
+    }
+    if (!found) {
+        if (__atomic_load_n(&client_count, __ATOMIC_RELAXED) >= ADMISSION_MAX_CLIENTS || !(found = malloc(sizeof(ClientBucket)))) {
+            pthread_mutex_unlock(stripe);
+            return 1; // Unmetered rather than refused: the in-flight budget still applies
+        }
+        snprintf(found->key, sizeof(found->key), "%s", key);
+        found->tokens = client_burst;
+        found->refilled_ns = now_ns;
+        found->next = buckets[bucket];
+        buckets[bucket] = found;
+        __atomic_add_fetch(&client_count, 1, __ATOMIC_RELAXED);
+    }
+    // 'now_ns' was read before the lock; another thread may have refilled later
+    if (now_ns > found->refilled_ns) {
+        double elapsed_s = (double)(now_ns - found->refilled_ns) / 1e9;
+        found->tokens = fmin(client_burst, found->tokens + elapsed_s * client_rate);
+        found->refilled_ns = now_ns;
+    }
+    int admitted = found->tokens >= 1.0;
+    if (admitted) found->tokens -= 1.0;
+    else *retry_after_s = (int)ceil((1.0 - found->tokens) / client_rate);
+    pthread_mutex_unlock(stripe);
+    return admitted;
+}
+
+// ========================================================================== //
+//                                PUBLIC API                                  //
+// ========================================================================== //
+
+AdmissionResult admission_acquire(const char* client_key, AdmissionClass cls, int* retry_after_s) {
+    if (!admission_enabled) return ADMISSION_ADMITTED;
+    int retry = 1;
+    if (client_rate > 0 && client_key) {
+        pthread_once(&stripes_once, init_stripes);
+        if (!take_token(client_key, metrics_now_ns(), &retry)) {
+            __atomic_add_fetch(&rate_limited_count, 1, __ATOMIC_RELAXED);
+            if (retry_after_s) *retry_after_s = retry < 1 ? 1 : retry;
+            return ADMISSION_RATE_LIMITED;
+        }
+    }
+    size_t now_in_flight = __atomic_add_fetch(&in_flight, 1, __ATOMIC_RELAXED);
+    if (max_in_flight > 0 && now_in_flight * 4 > max_in_flight * class_share[cls]) {
+        __atomic_sub_fetch(&in_flight, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&shed_count[cls], 1, __ATOMIC_RELAXED);
+        if (retry_after_s) *retry_after_s = 1; // Requests finish in milliseconds; capacity frees up fast
+        return ADMISSION_OVERLOADED;
+    }
+    return ADMISSION_ADMITTED;
+}
+
+void admission_release(void) {
+    if (admission_enabled) __atomic_sub_fetch(&in_flight, 1, __ATOMIC_RELAXED);
+}
+
+void admission_get_stats(AdmissionStats* stats) {
+    stats->in_flight = __atomic_load_n(&in_flight, __ATOMIC_RELAXED);
+    stats->clients = __atomic_load_n(&client_count, __ATOMIC_RELAXED);
+    stats->rate_limited = __atomic_load_n(&rate_limited_count, __ATOMIC_RELAXED);
+    for (int c = 0; c < ADMISSION_CLASS_COUNT; ++c) stats->shed[c] = __atomic_load_n(&shed_count[c], __ATOMIC_RELAXED);
+}
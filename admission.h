@@ -0,0 +1,54 @@
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <stddef.h>
+
+#define ADMISSION_KEY_MAX 64            // Client key length, NUL included
+#define ADMISSION_DEFAULT_RATE 20.0     // Requests per second each client may sustain
+#define ADMISSION_DEFAULT_BURST 60.0    // Requests a client may send at once after idling
+#define ADMISSION_DEFAULT_INFLIGHT 128  // Requests handled at once, across all clients
+#define ADMISSION_MAX_CLIENTS 65536     // Tracked clients; more are admitted unmetered
+
+/**
+ * @brief Share of the in-flight budget a request may use. When the server is
+ * busy the low classes are shed first, so mentor writes still get through
+ * while dashboards polling as mentees wait.
+ */
+typedef enum {
+    ADMISSION_LOW,      // Mentee and anonymous reads (polling): half the budget
+    ADMISSION_NORMAL,   // Mentor reads, mentee writes, login/logout: three quarters
+    ADMISSION_HIGH,     // Mentor writes: the whole budget
+    ADMISSION_CLASS_COUNT
+} AdmissionClass;
+
+typedef enum {
+    ADMISSION_ADMITTED,
+    ADMISSION_RATE_LIMITED, // Client over its token bucket: answer 429
+    ADMISSION_OVERLOADED    // Class share of the budget in use: answer 503
+} AdmissionResult;
+
+typedef struct {
+    size_t in_flight;
+    size_t clients;
+    unsigned long long rate_limited;
+    unsigned long long shed[ADMISSION_CLASS_COUNT];
+} AdmissionStats;
+
+/**
+ * @brief Enables admission control. Reads MENTOR_RATE_LIMIT ("<rate>/<burst>"
+ * per client, "0" disables rate limiting) and MENTOR_MAX_INFLIGHT ("0" disables
+ * load shedding). Until it is called every request is admitted (tools, tests).
+ */
+void admission_init(void);
+
+/**
+ * @brief Decides whether to handle a request from 'client_key' (user or
+ * address). Admitted requests hold a slot until admission_release().
+ * Otherwise '*retry_after_s' is set to when retrying makes sense.
+ */
+AdmissionResult admission_acquire(const char* client_key, AdmissionClass cls, int* retry_after_s);
+void admission_release(void);
+
+void admission_get_stats(AdmissionStats* stats);
+
+#endif // ADMISSION_H
@@ -1,13 +1,29 @@
-#define _XOPEN_SOURCE 700
+#define _GNU_SOURCE // Implies _XOPEN_SOURCE 700; also for pthread_rwlockattr_setkind_np
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>      // For strcasecmp
 #include <time.h>
 #include <limits.h>       // For INT_MAX
 #include <ctype.h>        // For tolower, isspace
+#include <pthread.h>
+#include <unistd.h>       // For pread
+#include <arpa/inet.h>    // For inet_ntop
 #include <microhttpd.h>
 #include <cjson/cJSON.h>
 #include "mentorship_data.h"
+#include "logger.h"
+#include "metrics.h"
+#include "trace.h"
+#include "memstats.h"
+#include "arena.h"
+#include "import.h"
+#include "export.h"
+#include "session.h"
+#include "password.h"
+#include "admission.h"
+#include "coalesce.h"
+#include "idempotency.h"
 #include "json_helpers.h"
 #include "api_handler.h"
 
@@ -20,17 +36,65 @@
 #define LOGOUT_ENDPOINT "/api/logout"
 #define MENTEE_API_PREFIX "/api/mentee/me/" // Prefix for mentee-specific endpoints
 #define MAX_POST_SIZE 16384                 // Max size for request bodies
+#define CONNECTION_ARENA_CHUNK (2 * MAX_POST_SIZE) // Fits a full body plus its parsed tree
 #define DATA_FILE "mentorship_data.json"    // Ensure consistency
-#define AUTH_HEADER "X-User-ID"             // Header for user authentication token/ID
+#define AUTH_HEADER MHD_HTTP_HEADER_AUTHORIZATION // Carries the session token issued at login
+#define AUTH_SCHEME "Bearer "
+#define IDEMPOTENCY_HEADER "Idempotency-Key"       // Lets clients retry creating POSTs safely
+#define REPLAYED_HEADER "Idempotent-Replayed"      // Set on responses answered from the idempotency store
+#define DEFAULT_PASSWORD "password"                // !! INSECURE DEFAULT PASSWORD !! for created mentee accounts
+#define MAX_AVAILABILITY_RANGE (31 * 24 * 60 * 60) // Longest window /api/availability will sweep
+#define MAX_AVAILABILITY_SLOTS 512
+#define SUGGEST_DEFAULT_LIMIT 10
+#define SUGGEST_MAX_LIMIT 50
+#define SEARCH_DEFAULT_LIMIT 20
+#define SEARCH_MAX_LIMIT 100
+#define SEARCH_MAX_OFFSET 10000                    // Deep pages cost a larger result heap
+#define BATCH_MAX_OPERATIONS 50
 
 // Structure to hold state for processing POST/PATCH request bodies chunk by chunk
 struct PostStatus {
-    char *buffer;       // Accumulated data buffer
-    size_t buffer_size; // Current size of the buffer
+    char *buffer;       // Accumulated data buffer (request arena)
+    size_t buffer_size; // Bytes received so far
+    size_t capacity;    // Bytes reserved: Content-Length when sent, else MAX_POST_SIZE
     int complete;       // Flag: 1 if the final chunk has been received
     int error;          // Flag: 1 if an error occurred (e.g., too large)
 };
 
+// Per-request state kept in *con_cls from the first callback until request_completed()
+struct RequestState {
+    struct PostStatus post; // Body accumulation (used for POST/PATCH only)
+    int has_body;           // 1 for POST/PATCH
+    uint64_t started_ns;    // metrics_now_ns() at the first callback
+    int route;              // Index into route_specs, or ROUTE_UNMATCHED
+    int route_id;           // "{id}" path parameter; 0 if absent or not a positive integer
+    int path_matched;       // URL matches a route template, maybe under another method (405)
+    int status;             // HTTP status queued for this request (0 = none yet)
+    TraceRequest trace;     // Phase spans for the slow-request log
+    Arena *arena;           // Body, parsed JSON and scratch strings; reset in request_completed()
+    int owns_arena;         // 1 if 'arena' was created for this request (no connection arena)
+    void *stream_ctx;       // Streaming route state (e.g. an import), owned by its handler
+    void (*stream_ctx_free)(void *stream_ctx);
+    int admitted;           // Holds an admission slot until request_completed()
+    int leads_flight;       // Computing a response identical concurrent requests will reuse
+    struct MHD_Response *shared_response; // The leader's response, kept for them by send_json_response()
+    const char *idempotency_key; // Scoped Idempotency-Key whose 2xx response send_json_response() stores
+    uint64_t idempotency_fingerprint;
+};
+
+// Request currently being handled on this thread; lets queue_response() record the status
+static __thread struct RequestState *current_request = NULL;
+
+// A POST /api/batch running its operations. While set, handlers' responses are
+// captured here instead of being queued on the connection.
+struct BatchRun {
+    SessionInfo session; // Authenticated once, for every operation
+    int status;         // Status answered by the running operation (0 = none yet)
+    cJSON *body;        // Its body; NULL for 204
+    int save_pending;   // An operation asked for a save; done once when the batch commits
+};
+static __thread struct BatchRun *current_batch = NULL;
+
 // ========================================================================== //
 //                        FORWARD DECLARATIONS (STATIC)                       //
 // ========================================================================== //
@@ -38,8 +102,21 @@ struct PostStatus {
 // --- Helper Functions ---
 static enum MHD_Result send_json_response(struct MHD_Connection *connection, int status_code, cJSON *json_root);
 static enum MHD_Result send_error_response(struct MHD_Connection *connection, int status_code, const char *message);
-static User* authenticate_request(struct MHD_Connection *connection, AppData *app_data, UserRole required_role, int *authenticated_user_id, int *authenticated_assoc_id);
+static int authenticate_request(struct MHD_Connection *connection, AppData *app_data, UserRole required_role, int *authenticated_user_id, int *authenticated_assoc_id);
 static char* generate_username_from_name(const char* full_name);
+static int parse_time_param(const char* value, time_t* out);
+static int append_meeting_json(const Meeting* meeting, void* ctx);
+static int append_mentor_meeting_reminder(const Meeting* meeting, void* ctx);
+static int append_mentee_meeting_reminder(const Meeting* meeting, void* ctx);
+static enum MHD_Result send_meeting_conflict_response(struct MHD_Connection *connection, const Meeting *conflict, int mentee_id);
+static int parse_status_param(const char* value, IssueStatus* out);
+static int parse_priority_param(const char* value, IssuePriority* out);
+static int parse_search_kinds(const char* value, unsigned int* mask_out);
+static cJSON* search_hit_to_json(const SearchHit* hit);
+static cJSON* parse_request_body(const char *upload_data, size_t upload_data_size);
+static int classify_route(const char *method, const char *url, int *route_id, int *path_matched);
+static void count_entities(const AppData *app_data, MetricsEntityCounts *counts);
+static enum MHD_Result queue_response(struct MHD_Connection *connection, unsigned int status_code, struct MHD_Response *response);
 
 // --- Auth Handlers ---
 static enum MHD_Result handle_login(struct MHD_Connection *connection, AppData *app_data, const char *upload_data, size_t upload_data_size);
@@ -47,6 +124,7 @@ static enum MHD_Result handle_logout(struct MHD_Connection *connection, AppData
 
 // --- Mentor API Handlers ---
 static enum MHD_Result handle_get_mentees(struct MHD_Connection *connection, AppData *app_data);
+static enum MHD_Result handle_get_mentee_suggestions(struct MHD_Connection *connection, AppData *app_data);
 static enum MHD_Result handle_post_mentees(struct MHD_Connection *connection, AppData *app_data, const char *upload_data, size_t upload_data_size);
 static enum MHD_Result handle_delete_mentee(struct MHD_Connection *connection, AppData *app_data, int mentee_id);
 static enum MHD_Result handle_get_meetings(struct MHD_Connection *connection, AppData *app_data);
@@ -57,6 +135,17 @@ static enum MHD_Result handle_get_issues(struct MHD_Connection *connection, AppD
 static enum MHD_Result handle_post_issues(struct MHD_Connection *connection, AppData *app_data, const char *upload_data, size_t upload_data_size); // Mentor reports issue
 static enum MHD_Result handle_patch_issue(struct MHD_Connection *connection, AppData *app_data, int issue_id, const char *upload_data, size_t upload_data_size);
 static enum MHD_Result handle_get_notifications(struct MHD_Connection *connection, AppData *app_data); // Mentor notifications
+static enum MHD_Result handle_get_dashboard(struct MHD_Connection *connection, AppData *app_data); // Mentor page bootstrap
+static enum MHD_Result handle_get_availability(struct MHD_Connection *connection, AppData *app_data);
+static enum MHD_Result handle_get_search(struct MHD_Connection *connection, AppData *app_data);
+static enum MHD_Result handle_get_metrics(struct MHD_Connection *connection, AppData *app_data); // Unauthenticated, for scrapers
+static enum MHD_Result handle_get_trace(struct MHD_Connection *connection, AppData *app_data);
+static enum MHD_Result handle_get_diagnostics(struct MHD_Connection *connection, AppData *app_data);
+static enum MHD_Result handle_import_mentees(struct MHD_Connection *connection, AppData *app_data, struct RequestState *state, const char *chunk, size_t chunk_size);
+static enum MHD_Result handle_import_meetings(struct MHD_Connection *connection, AppData *app_data, struct RequestState *state, const char *chunk, size_t chunk_size);
+static enum MHD_Result handle_import_issues(struct MHD_Connection *connection, AppData *app_data, struct RequestState *state, const char *chunk, size_t chunk_size);
+static enum MHD_Result handle_get_export(struct MHD_Connection *connection, AppData *app_data);
+static enum MHD_Result handle_post_batch(struct MHD_Connection *connection, AppData *app_data, const char *upload_data, size_t upload_data_size);
 
 // --- Mentee API Handlers ---
 static enum MHD_Result handle_get_mentee_details(struct MHD_Connection *connection, AppData *app_data);
@@ -65,41 +154,695 @@ static enum MHD_Result handle_get_mentee_issues(struct MHD_Connection *connectio
 static enum MHD_Result handle_get_mentee_mentor(struct MHD_Connection *connection, AppData *app_data);
 static enum MHD_Result handle_get_mentee_notes(struct MHD_Connection *connection, AppData *app_data);
 static enum MHD_Result handle_get_mentee_notifications(struct MHD_Connection *connection, AppData *app_data); // Mentee notifications
+static enum MHD_Result handle_get_mentee_dashboard(struct MHD_Connection *connection, AppData *app_data); // Mentee page bootstrap
 static enum MHD_Result handle_post_mentee_issue(struct MHD_Connection *connection, AppData *app_data, const char *upload_data, size_t upload_data_size); // Mentee reports issue
 
 
+// ========================================================================== //
+//                                ROUTE TABLE                                 //
+// ========================================================================== //
+
+// How a route's handler takes its arguments
+typedef enum {
+    ROUTE_ARGS_NONE,    // (connection, app_data)
+    ROUTE_ARGS_BODY,    // (connection, app_data, body, body_size)
+    ROUTE_ARGS_ID,      // (connection, app_data, id)
+    ROUTE_ARGS_ID_BODY, // (connection, app_data, id, body, body_size)
+    ROUTE_ARGS_STREAM   // (connection, app_data, state, chunk, chunk_size) per upload chunk, then (.., NULL, 0)
+} RouteArgs;
+
+typedef enum MHD_Result (*PlainRouteHandler)(struct MHD_Connection *, AppData *);
+typedef enum MHD_Result (*BodyRouteHandler)(struct MHD_Connection *, AppData *, const char *, size_t);
+typedef enum MHD_Result (*IdRouteHandler)(struct MHD_Connection *, AppData *, int);
+typedef enum MHD_Result (*IdBodyRouteHandler)(struct MHD_Connection *, AppData *, int, const char *, size_t);
+typedef enum MHD_Result (*StreamRouteHandler)(struct MHD_Connection *, AppData *, struct RequestState *, const char *, size_t);
+
+// One endpoint. "{id}" in a pattern matches one path segment and is passed to
+// the handler as a positive integer (400 if the segment is not one).
+// Stream routes see the body chunk by chunk (no MAX_POST_SIZE) without the data
+// lock held; only their final call runs under it like any other handler.
+// Shared routes are pure reads: identical concurrent requests reuse one response.
+// Idempotent routes create records and honour an Idempotency-Key header.
+// The index in route_specs is also the endpoint's metrics slot.
+struct RouteSpec {
+    const char *method;
+    const char *pattern;
+    const char *label;
+    RouteArgs args;
+    union {
+        PlainRouteHandler plain;
+        BodyRouteHandler body;
+        IdRouteHandler id;
+        IdBodyRouteHandler id_body;
+        StreamRouteHandler stream;
+    } handler;
+    unsigned int flags;
+};
+
+enum {
+    ROUTE_FLAG_SHARED = 1 << 0,     // Coalesced by dispatch_coalesced()
+    ROUTE_FLAG_IDEMPOTENT = 1 << 1  // Retries answered by dispatch_idempotent()
+};
+
+#define ROUTE(m, p, fn)         { m, p, m " " p, ROUTE_ARGS_NONE, { .plain = fn }, 0 }
+#define ROUTE_BODY(m, p, fn)    { m, p, m " " p, ROUTE_ARGS_BODY, { .body = fn }, 0 }
+#define ROUTE_ID(m, p, fn)      { m, p, m " " p, ROUTE_ARGS_ID, { .id = fn }, 0 }
+#define ROUTE_ID_BODY(m, p, fn) { m, p, m " " p, ROUTE_ARGS_ID_BODY, { .id_body = fn }, 0 }
+#define ROUTE_STREAM(m, p, fn)  { m, p, m " " p, ROUTE_ARGS_STREAM, { .stream = fn }, 0 }
+#define ROUTE_SHARED(p, fn)     { MHD_HTTP_METHOD_GET, p, MHD_HTTP_METHOD_GET " " p, ROUTE_ARGS_NONE, { .plain = fn }, ROUTE_FLAG_SHARED }
+#define ROUTE_IDEMPOTENT(p, fn) { MHD_HTTP_METHOD_POST, p, MHD_HTTP_METHOD_POST " " p, ROUTE_ARGS_BODY, { .body = fn }, ROUTE_FLAG_IDEMPOTENT }
+static const struct RouteSpec route_specs[] = {
+    ROUTE_BODY(MHD_HTTP_METHOD_POST, "/api/login", handle_login),
+    ROUTE(MHD_HTTP_METHOD_POST, "/api/logout", handle_logout),
+    ROUTE_SHARED("/api/mentee/me/details", handle_get_mentee_details),
+    ROUTE_SHARED("/api/mentee/me/meetings", handle_get_mentee_meetings),
+    ROUTE_SHARED("/api/mentee/me/issues", handle_get_mentee_issues),
+    ROUTE_SHARED("/api/mentee/me/mentor", handle_get_mentee_mentor),
+    ROUTE_SHARED("/api/mentee/me/notes", handle_get_mentee_notes),
+    ROUTE_SHARED("/api/mentee/me/notifications", handle_get_mentee_notifications),
+    ROUTE_SHARED("/api/mentee/me/dashboard", handle_get_mentee_dashboard),
+    ROUTE_IDEMPOTENT("/api/mentee/me/issues", handle_post_mentee_issue),
+    ROUTE_SHARED("/api/mentees", handle_get_mentees),
+    ROUTE_SHARED("/api/mentees/suggest", handle_get_mentee_suggestions),
+    ROUTE_SHARED("/api/meetings", handle_get_meetings),
+    ROUTE_SHARED("/api/issues", handle_get_issues),
+    ROUTE_SHARED("/api/notifications", handle_get_notifications),
+    ROUTE_SHARED("/api/dashboard", handle_get_dashboard),
+    ROUTE_SHARED("/api/availability", handle_get_availability),
+    ROUTE_SHARED("/api/search", handle_get_search),
+    ROUTE(MHD_HTTP_METHOD_GET, "/api/metrics", handle_get_metrics),
+    ROUTE(MHD_HTTP_METHOD_GET, "/api/trace", handle_get_trace),
+    ROUTE(MHD_HTTP_METHOD_GET, "/api/diagnostics", handle_get_diagnostics),
+    ROUTE(MHD_HTTP_METHOD_GET, "/api/export", handle_get_export),
+    ROUTE_IDEMPOTENT("/api/mentees", handle_post_mentees),
+    ROUTE_IDEMPOTENT("/api/meetings", handle_post_meetings),
+    ROUTE_IDEMPOTENT("/api/issues", handle_post_issues),
+    ROUTE_BODY(MHD_HTTP_METHOD_POST, "/api/batch", handle_post_batch),
+    ROUTE_ID_BODY(MHD_HTTP_METHOD_PATCH, "/api/meetings/{id}", handle_patch_meeting),
+    ROUTE_ID_BODY(MHD_HTTP_METHOD_PATCH, "/api/issues/{id}", handle_patch_issue),
+    ROUTE_STREAM(MHD_HTTP_METHOD_POST, "/api/import/mentees", handle_import_mentees),
+    ROUTE_STREAM(MHD_HTTP_METHOD_POST, "/api/import/meetings", handle_import_meetings),
+    ROUTE_STREAM(MHD_HTTP_METHOD_POST, "/api/import/issues", handle_import_issues),
+    ROUTE_ID(MHD_HTTP_METHOD_DELETE, "/api/mentees/{id}", handle_delete_mentee),
+    ROUTE_ID(MHD_HTTP_METHOD_DELETE, "/api/meetings/{id}", handle_delete_meeting),
+    { MHD_HTTP_METHOD_OPTIONS, NULL, "OPTIONS *", ROUTE_ARGS_NONE, { NULL }, 0 }, // Answered by the CORS preflight code
+};
+#undef ROUTE
+#undef ROUTE_BODY
+#undef ROUTE_ID
+#undef ROUTE_ID_BODY
+#undef ROUTE_STREAM
+#undef ROUTE_SHARED
+#undef ROUTE_IDEMPOTENT
+#define ROUTE_COUNT ((int)(sizeof(route_specs) / sizeof(route_specs[0])))
+#define ROUTE_UNMATCHED ROUTE_COUNT // Metrics slot for anything not in the table
+
 // ========================================================================== //
 //                         HELPER FUNCTION IMPLEMENTATIONS                    //
 // ========================================================================== //
 
+/**
+ * @brief Builds the {"error": message} body every error response uses.
+ */
+static cJSON *error_body(const char *message) {
+    cJSON *error_json = cJSON_CreateObject();
+    if (error_json && !cJSON_AddStringToObject(error_json, "error", message)) {
+        cJSON_Delete(error_json);
+        return NULL;
+    }
+    return error_json;
+}
+
+/**
+ * @brief Records a batch operation's answer in place of queueing it. Takes 'body'.
+ */
+static void capture_batch_response(int status_code, cJSON *body) {
+    cJSON_Delete(current_batch->body); // Handlers answer once, but never leak an earlier answer
+    current_batch->status = status_code;
+    current_batch->body = body;
+}
+
+/**
+ * @brief Saves AppData after a mutation, or defers the save to the end of the
+ * running batch so the whole batch is written once.
+ */
+static int persist_app_data(const AppData *app_data) {
+    if (current_batch) {
+        current_batch->save_pending = 1;
+        return 1;
+    }
+    return save_data_to_file(app_data, DATA_FILE);
+}
+
+/**
+ * @brief Queues 'response' and remembers the status for the request metrics.
+ * All responses go through here instead of calling MHD_queue_response directly.
+ */
+static enum MHD_Result queue_response(struct MHD_Connection *connection, unsigned int status_code, struct MHD_Response *response) {
+    if (current_batch) {
+        // Only JSON and empty responses are captured (see capture_batch_response); raw ones can't be embedded
+        capture_batch_response(MHD_HTTP_NOT_IMPLEMENTED, error_body("Response cannot be embedded in a batch"));
+        return MHD_YES;
+    }
+    enum MHD_Result ret = MHD_queue_response(connection, status_code, response);
+    if (ret == MHD_YES && current_request) current_request->status = (int)status_code;
+    return ret;
+}
+
+// ========================================================================== //
+//                               ROUTE TRIE                                   //
+// ========================================================================== //
+
+// route_specs compiled into a trie of path segments on first use. Matching
+// walks one node per segment and binary-searches its literal children, so the
+// cost depends on the URL's depth, not on how many routes there are.
+#define ROUTE_METHOD_COUNT 4 // GET, POST, PATCH, DELETE
+
+struct RouteNode {
+    char *segment;                  // Literal segment; NULL for the root and "{id}" nodes
+    struct RouteNode **children;    // Literal children, sorted by segment
+    int child_count;
+    struct RouteNode *param_child;  // "{id}" child
+    int routes[ROUTE_METHOD_COUNT]; // route_specs index per method, -1 if none
+};
+
+static struct RouteNode *route_root = NULL;
+static int options_route = ROUTE_UNMATCHED;
+static pthread_once_t route_trie_once = PTHREAD_ONCE_INIT;
+
+static int route_method_index(const char *method) {
+    if (0 == strcmp(method, MHD_HTTP_METHOD_GET)) return 0;
+    if (0 == strcmp(method, MHD_HTTP_METHOD_POST)) return 1;
+    if (0 == strcmp(method, MHD_HTTP_METHOD_PATCH)) return 2;
+    if (0 == strcmp(method, MHD_HTTP_METHOD_DELETE)) return 3;
+    return -1;
+}
+
+static struct RouteNode *route_node_create(const char *segment, size_t len) {
+    struct RouteNode *node = calloc(1, sizeof(struct RouteNode));
+    if (!node) return NULL;
+    for (int m = 0; m < ROUTE_METHOD_COUNT; ++m) node->routes[m] = -1;
+    if (segment) {
+        node->segment = malloc(len + 1);
+        if (!node->segment) { free(node); return NULL; }
+        memcpy(node->segment, segment, len);
+        node->segment[len] = '\0';
+    }
+    return node;
+}
+
+/**
+ * @brief Compares the segment [s, s + len) with a NUL-terminated node segment.
+ */
+static int compare_segment(const char *s, size_t len, const char *segment) {
+    int cmp = strncmp(s, segment, len);
+    if (cmp != 0) return cmp;
+    return segment[len] == '\0' ? 0 : -1;
+}
+
+/**
+ * @brief Binary search for a literal child. Sets *slot to the insert position if absent.
+ */
+static struct RouteNode *route_find_child(const struct RouteNode *node, const char *s, size_t len, int *slot) {
+    int lo = 0, hi = node->child_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = compare_segment(s, len, node->children[mid]->segment);
+        if (cmp == 0) return node->children[mid];
+        if (cmp < 0) hi = mid;
+        else lo = mid + 1;
+    }
+    if (slot) *slot = lo;
+    return NULL;
+}
+
+static struct RouteNode *route_add_child(struct RouteNode *node, const char *s, size_t len) {
+    if (len == 4 && 0 == strncmp(s, "{id}", 4)) {
+        if (!node->param_child) node->param_child = route_node_create(NULL, 0);
+        return node->param_child;
+    }
+    int slot = 0;
+    struct RouteNode *child = route_find_child(node, s, len, &slot);
+    if (child) return child;
+    child = route_node_create(s, len);
+    struct RouteNode **grown = child ? realloc(node->children, (size_t)(node->child_count + 1) * sizeof(*grown)) : NULL;
+    if (!grown) {
+        if (child) free(child->segment);
+        free(child);
+        return NULL;
+    }
+    memmove(grown + slot + 1, grown + slot, (size_t)(node->child_count - slot) * sizeof(*grown));
+    grown[slot] = child;
+    node->children = grown;
+    node->child_count++;
+    return child;
+}
+
+static void build_route_trie(void) {
+    route_root = route_node_create(NULL, 0);
+    for (int i = 0; route_root && i < ROUTE_COUNT; ++i) {
+        const struct RouteSpec *spec = &route_specs[i];
+        if (!spec->pattern) {
+            if (0 == strcmp(spec->method, MHD_HTTP_METHOD_OPTIONS)) options_route = i;
+            continue;
+        }
+        int method = route_method_index(spec->method);
+        struct RouteNode *node = route_root;
+        for (const char *p = spec->pattern; node && *p == '/'; ) {
+            const char *segment = ++p;
+            while (*p && *p != '/') p++;
+            node = route_add_child(node, segment, (size_t)(p - segment));
+        }
+        if (!node || method < 0) {
+            LOG_ERROR("[ROUTER] Failed to compile route %s", spec->label);
+            continue;
+        }
+        if (node->routes[method] >= 0) LOG_WARN("[ROUTER] Route %s shadows %s", spec->label, route_specs[node->routes[method]].label);
+        node->routes[method] = i;
+    }
+    if (!route_root) LOG_ERROR("[ROUTER] Failed to allocate the route trie; every request will 404");
+}
+
+/**
+ * @brief Matches the remaining path 'p' below 'node'. Literal segments win over
+ * "{id}", falling back to it when the literal branch has no route for the method.
+ */
+static int route_match(const struct RouteNode *node, const char *p, int method, const char **param, int *path_matched) {
+    if (*p == '\0') {
+        for (int m = 0; m < ROUTE_METHOD_COUNT; ++m) {
+            if (node->routes[m] >= 0) *path_matched = 1;
+        }
+        return method >= 0 ? node->routes[method] : -1;
+    }
+    if (*p != '/') return -1;
+    const char *segment = ++p;
+    while (*p && *p != '/') p++;
+    size_t len = (size_t)(p - segment);
+    if (len == 0) return -1; // Empty segment ("//" or a trailing slash)
+
+    const struct RouteNode *child = route_find_child(node, segment, len, NULL);
+    int route = child ? route_match(child, p, method, param, path_matched) : -1;
+    if (route < 0 && node->param_child) {
+        route = route_match(node->param_child, p, method, param, path_matched);
+        if (route >= 0) *param = segment;
+    }
+    return route;
+}
+
+/**
+ * @brief Parses a "{id}" segment: a positive decimal int, else 0.
+ */
+static int parse_route_id(const char *segment) {
+    long value = 0;
+    const char *p = segment;
+    for (; *p >= '0' && *p <= '9'; ++p) {
+        value = value * 10 + (*p - '0');
+        if (value > INT_MAX) return 0;
+    }
+    return (p != segment && (*p == '\0' || *p == '/')) ? (int)value : 0;
+}
+
+/**
+ * @brief Maps a request to its route_specs index (ROUTE_UNMATCHED if none) and
+ * extracts its "{id}" parameter. *path_matched tells 405 apart from 404.
+ */
+static int classify_route(const char *method, const char *url, int *route_id, int *path_matched) {
+    pthread_once(&route_trie_once, build_route_trie);
+    *route_id = 0;
+    *path_matched = 0;
+    if (0 == strcmp(method, MHD_HTTP_METHOD_OPTIONS)) return options_route;
+    if (!route_root || !url) return ROUTE_UNMATCHED;
+
+    const char *param = NULL;
+    int route = route_match(route_root, url, route_method_index(method), &param, path_matched);
+    if (route < 0) return ROUTE_UNMATCHED;
+    if (param) *route_id = parse_route_id(param);
+    return route;
+}
+
+/**
+ * @brief Calls the route's handler with the arguments its RouteArgs asks for.
+ */
+static enum MHD_Result dispatch_route(struct MHD_Connection *connection, AppData *app_data, const struct RouteSpec *spec,
+                                      int route_id, const char *body, size_t body_size) {
+    switch (spec->args) {
+    case ROUTE_ARGS_NONE:
+        return spec->handler.plain(connection, app_data);
+    case ROUTE_ARGS_BODY:
+        return spec->handler.body(connection, app_data, body, body_size);
+    case ROUTE_ARGS_ID:
+    case ROUTE_ARGS_ID_BODY:
+        if (route_id <= 0) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid ID format in path");
+        if (spec->args == ROUTE_ARGS_ID) return spec->handler.id(connection, app_data, route_id);
+        return spec->handler.id_body(connection, app_data, route_id, body, body_size);
+    case ROUTE_ARGS_STREAM:
+        return spec->handler.stream(connection, app_data, current_request, NULL, 0);
+    }
+    return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Route misconfigured");
+}
+
+// ========================================================================== //
+//                               DATA LOCKING                                 //
+// ========================================================================== //
+
+// MHD runs one thread per connection and every handler works on the shared
+// AppData, so readers (GET, logout) take this lock shared and mutations take it
+// exclusively for the whole handler, including the save that follows them.
+// Login locks only around its user lookup.
+static pthread_rwlock_t app_data_lock;
+static pthread_once_t app_data_lock_once = PTHREAD_ONCE_INIT;
+
+// Bumped each time the lock is taken exclusively, so it differs between any two
+// readers that may have seen different data. Written and read under the lock.
+static unsigned long long data_version = 0;
+
+static void init_app_data_lock(void) {
+    pthread_rwlockattr_t attr;
+    pthread_rwlockattr_init(&attr);
+    // glibc prefers readers by default, which starves writers under steady polling
+    pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+    pthread_rwlock_init(&app_data_lock, &attr);
+    pthread_rwlockattr_destroy(&attr);
+}
+
+/**
+ * @brief GET and the auth endpoints only read AppData; everything else writes.
+ */
+static int request_mutates_data(const char *method, const char *url) {
+    if (0 == strcmp(method, MHD_HTTP_METHOD_GET) || 0 == strcmp(method, MHD_HTTP_METHOD_HEAD)) return 0;
+    if (0 == strcmp(url, LOGIN_ENDPOINT) || 0 == strcmp(url, LOGOUT_ENDPOINT)) return 0;
+    return 1;
+}
+
+static void lock_app_data(int exclusive) {
+    pthread_once(&app_data_lock_once, init_app_data_lock);
+    uint64_t start = metrics_now_ns();
+    if (exclusive) {
+        pthread_rwlock_wrlock(&app_data_lock);
+        data_version++;
+    } else {
+        pthread_rwlock_rdlock(&app_data_lock);
+    }
+    trace_record("lock_wait", start, metrics_now_ns());
+}
+
+static void unlock_app_data(void) {
+    pthread_rwlock_unlock(&app_data_lock);
+}
+
+int api_check_consistency(AppData *app_data, char *problem, size_t problem_cap) {
+    lock_app_data(0);
+    int ok = check_app_data_consistency(app_data, problem, problem_cap);
+    unlock_app_data();
+    return ok;
+}
+
+/**
+ * @brief Gathers collection sizes from the indexes (no list walks except users).
+ */
+static void count_entities(const AppData *app_data, MetricsEntityCounts *counts) {
+    memset(counts, 0, sizeof(*counts));
+    counts->mentees = skiplist_size(app_data->mentees_by_id);
+    counts->meetings = skiplist_size(app_data->meetings_by_time);
+    for (int s = 0; s < ISSUE_STATUS_COUNT; ++s) {
+        for (int p = 0; p < ISSUE_PRIORITY_COUNT; ++p) counts->issues += (size_t)app_data->issue_bucket_counts[s][p];
+    }
+    for (const User* user = app_data->users_head; user; user = user->next) counts->users++;
+    counts->search_documents = search_index_document_count(app_data->search_index);
+    counts->search_terms = search_index_term_count(app_data->search_index);
+}
+
+// ========================================================================== //
+//                              REQUEST ARENAS                                //
+// ========================================================================== //
+
+// Each connection owns an arena (MHD_OPTION_NOTIFY_CONNECTION) that holds the
+// RequestState, the body and the parsed request JSON of its current request.
+// request_completed() resets it in one step, so a request costs no malloc or
+// free once the connection's first chunk exists.
+
+// Set while parse_request_body() runs so the cJSON hooks allocate from the arena
+static __thread int json_parse_in_arena = 0;
+static pthread_once_t json_hooks_once = PTHREAD_ONCE_INIT;
+
+static void* json_malloc(size_t size) {
+    if (json_parse_in_arena && current_request) return arena_alloc(current_request->arena, size);
+    return malloc(size);
+}
+
+/**
+ * @brief Arena memory is released with the request, so cJSON_Delete() on a
+ * parsed body only frees what came from the heap.
+ */
+static void json_free(void *ptr) {
+    if (current_request && arena_owns(current_request->arena, ptr)) return;
+    free(ptr);
+}
+
+static void install_json_hooks(void) {
+    cJSON_Hooks hooks = { json_malloc, json_free };
+    cJSON_InitHooks(&hooks);
+}
+
+void connection_notify(void *cls, struct MHD_Connection *connection,
+                       void **socket_context, enum MHD_ConnectionNotificationCode toe) {
+    (void)cls; (void)connection;
+    if (toe == MHD_CONNECTION_NOTIFY_STARTED) {
+        *socket_context = arena_create(CONNECTION_ARENA_CHUNK); // NULL falls back to per-request arenas
+    } else if (toe == MHD_CONNECTION_NOTIFY_CLOSED) {
+        arena_free(*socket_context);
+        *socket_context = NULL;
+    }
+}
+
+/**
+ * @brief Allocates the RequestState from the connection's arena, or from a
+ * fresh arena when the daemon was started without connection_notify().
+ */
+static struct RequestState* create_request_state(struct MHD_Connection *connection) {
+    const union MHD_ConnectionInfo *info = MHD_get_connection_info(connection, MHD_CONNECTION_INFO_SOCKET_CONTEXT);
+    Arena *arena = info ? info->socket_context : NULL;
+    int owns_arena = 0;
+    if (!arena) {
+        arena = arena_create(sizeof(struct RequestState) + MAX_POST_SIZE);
+        if (!arena) return NULL;
+        owns_arena = 1;
+    }
+    struct RequestState *state = arena_alloc(arena, sizeof(struct RequestState));
+    if (!state) {
+        if (owns_arena) arena_free(arena);
+        return NULL;
+    }
+    memset(state, 0, sizeof(*state));
+    state->arena = arena;
+    state->owns_arena = owns_arena;
+    return state;
+}
+
+static void release_request_state(struct RequestState *state) {
+    if (state->stream_ctx_free) state->stream_ctx_free(state->stream_ctx);
+    if (state->owns_arena) arena_free(state->arena);
+    else arena_reset(state->arena); // Also releases 'state'
+}
+
+/**
+ * @brief Reserves the body buffer up front: Content-Length bytes when the
+ * client sent it, MAX_POST_SIZE otherwise. Returns 0 if the body is too large.
+ */
+static int reserve_request_body(struct MHD_Connection *connection, struct RequestState *state) {
+    struct PostStatus *post = &state->post;
+    post->capacity = MAX_POST_SIZE;
+    const char *length = MHD_lookup_connection_value(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_CONTENT_LENGTH);
+    if (length && *length) {
+        char *endptr;
+        unsigned long long declared = strtoull(length, &endptr, 10);
+        if (*endptr == '\0') {
+            if (declared > MAX_POST_SIZE) {
+                LOG_ERROR("[ROUTER] Error: Content-Length %llu exceeds MAX_POST_SIZE (%d).", declared, MAX_POST_SIZE);
+                return 0;
+            }
+            post->capacity = (size_t)declared;
+        }
+    }
+    if (post->capacity > 0) {
+        post->buffer = arena_alloc(state->arena, post->capacity);
+        if (!post->buffer) {
+            LOG_ERROR("[ROUTER] Error: Failed to reserve %zu bytes for the request body.", post->capacity);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Scratch memory that lives until the current request completes.
+ * Only valid inside a handler (current_request is set).
+ */
+static char* request_strdup(const char *s) {
+    return current_request ? arena_strdup(current_request->arena, s) : NULL;
+}
+
+// ========================================================================== //
+//                              RESPONSE CACHE                                //
+// ========================================================================== //
+
+#define CORS_ALLOWED_METHODS "GET, POST, PATCH, DELETE, OPTIONS"
+#define CORS_ALLOWED_HEADERS "Content-Type, " AUTH_HEADER ", " IDEMPOTENCY_HEADER
+
+struct HeaderPair {
+    const char *name;
+    const char *value;
+};
+
+// Header sets shared by every response of a kind; NULL-terminated
+static const struct HeaderPair json_headers[] = {
+    { MHD_HTTP_HEADER_CONTENT_TYPE, "application/json" },
+    { "Access-Control-Allow-Origin", "*" },
+    { "Access-Control-Allow-Methods", CORS_ALLOWED_METHODS },
+    { "Access-Control-Allow-Headers", CORS_ALLOWED_HEADERS },
+    { "Access-Control-Expose-Headers", "Content-Type, Authorization, Retry-After, " REPLAYED_HEADER }, // Expose headers client might need
+    { NULL, NULL }
+};
+static const struct HeaderPair no_content_headers[] = {
+    { "Access-Control-Allow-Origin", "*" },
+    { "Access-Control-Allow-Methods", CORS_ALLOWED_METHODS },
+    { "Access-Control-Allow-Headers", CORS_ALLOWED_HEADERS },
+    { NULL, NULL }
+};
+static const struct HeaderPair preflight_headers[] = {
+    { "Access-Control-Allow-Origin", "*" },
+    { "Access-Control-Allow-Methods", CORS_ALLOWED_METHODS },
+    { "Access-Control-Allow-Headers", CORS_ALLOWED_HEADERS },
+    { "Access-Control-Max-Age", "86400" }, // Cache preflight for 1 day
+    { NULL, NULL }
+};
+
+static void add_headers(struct MHD_Response *response, const struct HeaderPair *headers) {
+    for (; headers->name; ++headers) MHD_add_response_header(response, headers->name, headers->value);
+}
+
+// Errors common enough to keep a ready-made response for. Anything else is
+// built per request by send_error_response().
+struct CachedError {
+    int status;
+    const char *message;
+    struct MHD_Response *response;
+};
+static struct CachedError cached_errors[] = {
+    { MHD_HTTP_UNAUTHORIZED, "Unauthorized", NULL },
+    { MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required", NULL },
+    { MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentee role required", NULL },
+    { MHD_HTTP_UNAUTHORIZED, "Invalid username or password", NULL },
+    { MHD_HTTP_UNAUTHORIZED, "Invalid credentials for the selected role", NULL },
+    { MHD_HTTP_BAD_REQUEST, "Missing request body", NULL },
+    { MHD_HTTP_BAD_REQUEST, "Missing body", NULL },
+    { MHD_HTTP_BAD_REQUEST, "Invalid JSON", NULL },
+    { MHD_HTTP_BAD_REQUEST, "Invalid JSON data", NULL },
+    { MHD_HTTP_BAD_REQUEST, "Invalid ID format in path", NULL },
+    { MHD_HTTP_BAD_REQUEST, "Mentee not found", NULL },
+    { MHD_HTTP_NOT_FOUND, "Endpoint not found", NULL },
+    { MHD_HTTP_NOT_FOUND, "Mentee association missing", NULL },
+    { MHD_HTTP_NOT_FOUND, "Meeting not found", NULL },
+    { MHD_HTTP_NOT_FOUND, "Issue not found", NULL },
+    { MHD_HTTP_NOT_FOUND, "Mentee not found or deletion failed", NULL },
+    { MHD_HTTP_NOT_FOUND, "Meeting not found or deletion failed", NULL },
+    { MHD_HTTP_METHOD_NOT_ALLOWED, "Method Not Allowed on this API path", NULL },
+    { MHD_HTTP_CONTENT_TOO_LARGE, "Request body too large", NULL },
+    { MHD_HTTP_INTERNAL_SERVER_ERROR, "Internal Server Error", NULL },
+};
+#define CACHED_ERROR_COUNT ((int)(sizeof(cached_errors) / sizeof(cached_errors[0])))
+
+static struct MHD_Response *preflight_response = NULL;
+static struct MHD_Response *no_content_response = NULL;
+static pthread_once_t response_cache_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Builds a response over a buffer that lives for the whole process.
+ * MHD reference-counts responses, so one can be queued on many connections.
+ */
+static struct MHD_Response *create_persistent_response(const char *body, const struct HeaderPair *headers) {
+    struct MHD_Response *response = MHD_create_response_from_buffer(body ? strlen(body) : 0, (void *)body, MHD_RESPMEM_PERSISTENT);
+    if (response) add_headers(response, headers);
+    return response;
+}
+
+static void build_response_cache(void) {
+    preflight_response = create_persistent_response(NULL, preflight_headers);
+    no_content_response = create_persistent_response(NULL, no_content_headers);
+    for (int i = 0; i < CACHED_ERROR_COUNT; ++i) {
+        cJSON *error_json = cJSON_CreateObject();
+        char *body = NULL;
+        if (error_json && cJSON_AddStringToObject(error_json, "error", cached_errors[i].message)) {
+            body = cJSON_PrintUnformatted(error_json); // Kept for the life of the process
+        }
+        cJSON_Delete(error_json);
+        if (body) cached_errors[i].response = create_persistent_response(body, json_headers);
+        if (!cached_errors[i].response) {
+            LOG_WARN("[API] Could not cache the %d '%s' response; it will be built per request.", cached_errors[i].status, cached_errors[i].message);
+            free(body);
+        }
+    }
+}
+
+static struct MHD_Response *find_cached_error(int status_code, const char *message) {
+    pthread_once(&response_cache_once, build_response_cache);
+    for (int i = 0; i < CACHED_ERROR_COUNT; ++i) {
+        const struct CachedError *entry = &cached_errors[i];
+        if (entry->status == status_code && (entry->message == message || 0 == strcmp(entry->message, message))) return entry->response;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Queues a cached response (e.g. &preflight_response) once the cache is
+ * built. The cache keeps its reference, so there is nothing to destroy.
+ */
+static enum MHD_Result queue_cached_response(struct MHD_Connection *connection, unsigned int status_code, struct MHD_Response **slot) {
+    if (current_batch) {
+        capture_batch_response((int)status_code, NULL);
+        return MHD_YES;
+    }
+    pthread_once(&response_cache_once, build_response_cache);
+    if (!*slot) return MHD_NO;
+    return queue_response(connection, status_code, *slot);
+}
+
 /**
  * @brief Sends a JSON response with appropriate headers. Frees json_root.
  */
 static enum MHD_Result send_json_response(struct MHD_Connection *connection, int status_code, cJSON *json_root) {
+    if (current_batch) {
+        capture_batch_response(status_code, json_root); // Printed once, with the whole batch
+        return MHD_YES;
+    }
+    TraceSpan serialize_span = trace_begin("serialize");
     char *json_string = cJSON_PrintUnformatted(json_root);
     cJSON_Delete(json_root); // Free the cJSON object immediately
+    trace_end(serialize_span);
     struct MHD_Response *response = NULL;
     enum MHD_Result ret = MHD_NO;
 
     if (!json_string) {
-        fprintf(stderr, "[API] Error: Failed to print JSON.\n");
+        LOG_ERROR("[API] Error: Failed to print JSON.");
         return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Internal Server Error: JSON generation failed");
     }
 
+    if (current_request && current_request->idempotency_key && status_code >= 200 && status_code < 300) {
+        idempotency_store(current_request->idempotency_key, current_request->idempotency_fingerprint,
+                          (unsigned int)status_code, json_string, strlen(json_string));
+    }
     response = MHD_create_response_from_buffer(strlen(json_string), json_string, MHD_RESPMEM_MUST_FREE); // MHD will free json_string
 
     if (response) {
-        MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_TYPE, "application/json");
-        // Add CORS headers - adjust origin and headers as needed for security
-        MHD_add_response_header(response, "Access-Control-Allow-Origin", "*");
-        MHD_add_response_header(response, "Access-Control-Allow-Methods", "GET, POST, PATCH, DELETE, OPTIONS");
-        MHD_add_response_header(response, "Access-Control-Allow-Headers", "Content-Type, Authorization, " AUTH_HEADER);
-        MHD_add_response_header(response, "Access-Control-Expose-Headers", "Content-Type, Authorization"); // Expose headers client might need
-
-        ret = MHD_queue_response(connection, status_code, response);
-        MHD_destroy_response(response);
+        add_headers(response, json_headers); // CORS headers - adjust origin and headers as needed for security
+        ret = queue_response(connection, status_code, response);
+        if (ret == MHD_YES && current_request && current_request->leads_flight && !current_request->shared_response) {
+            current_request->shared_response = response; // Destroyed by the flight once its waiters are done
+        } else {
+            MHD_destroy_response(response);
+        }
     } else {
-        fprintf(stderr, "[API] Error: Failed to create MHD response.\n");
+        LOG_ERROR("[API] Error: Failed to create MHD response.");
         free(json_string); // Need to free if MHD_create_response failed
     }
     return ret;
@@ -109,10 +852,20 @@ static enum MHD_Result send_json_response(struct MHD_Connection *connection, int
  * @brief Sends a standardized error JSON response.
  */
 static enum MHD_Result send_error_response(struct MHD_Connection *connection, int status_code, const char *message) {
+    if (!message) message = "Unknown error";
+    if (current_batch) {
+        capture_batch_response(status_code, error_body(message));
+        return MHD_YES;
+    }
+    struct MHD_Response *cached = find_cached_error(status_code, message);
+    if (cached) return queue_response(connection, status_code, cached);
+
     cJSON *error_json = cJSON_CreateObject();
-    if (!error_json || !cJSON_AddStringToObject(error_json, "error", message ? message : "Unknown error")) {
-        fprintf(stderr, "[API] Error: Failed creating/populating error JSON.\n");
+    if (!error_json || !cJSON_AddStringToObject(error_json, "error", message)) {
+        LOG_ERROR("[API] Error: Failed creating/populating error JSON.");
         cJSON_Delete(error_json); // Cleanup if creation failed partially
+        struct MHD_Response *fallback = find_cached_error(MHD_HTTP_INTERNAL_SERVER_ERROR, "Internal Server Error");
+        if (fallback) return queue_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, fallback);
         // Send a plain text fallback error if JSON creation fails
         const char *fallback_msg = "{\"error\":\"Internal Server Error\"}";
         struct MHD_Response *response = MHD_create_response_from_buffer(strlen(fallback_msg), (void *)fallback_msg, MHD_RESPMEM_PERSISTENT);
@@ -120,7 +873,7 @@ static enum MHD_Result send_error_response(struct MHD_Connection *connection, in
         if(response){
             MHD_add_response_header(response, "Access-Control-Allow-Origin", "*");
             MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_TYPE, "application/json");
-            ret = MHD_queue_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, response);
+            ret = queue_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, response);
             MHD_destroy_response(response);
         }
         return ret;
@@ -130,61 +883,109 @@ static enum MHD_Result send_error_response(struct MHD_Connection *connection, in
 }
 
 /**
- * @brief Authenticates a request based on the X-User-ID header and required role.
- * @return Pointer to the authenticated User struct, or NULL if authentication fails.
- * Populates authenticated_user_id and authenticated_assoc_id if pointers are provided.
+ * @brief Sends 409 Conflict describing the meeting that overlaps the requested slot.
+ * "scope" is "mentee" when the mentee is double-booked, otherwise "mentor".
  */
-static User* authenticate_request(struct MHD_Connection *connection, AppData *app_data, UserRole required_role, int *authenticated_user_id, int *authenticated_assoc_id) {
-    const char *user_id_str = MHD_lookup_connection_value(connection, MHD_HEADER_KIND, AUTH_HEADER);
-    if (!user_id_str) {
-        printf("[AUTH] Failed: Missing %s header.\n", AUTH_HEADER); fflush(stdout);
-        return NULL;
+static enum MHD_Result send_meeting_conflict_response(struct MHD_Connection *connection, const Meeting *conflict, int mentee_id) {
+    cJSON *error_json = cJSON_CreateObject();
+    cJSON *conflict_json = meeting_to_json(conflict);
+    if (!error_json || !conflict_json ||
+        !cJSON_AddStringToObject(error_json, "error", "Meeting overlaps an existing meeting") ||
+        !cJSON_AddStringToObject(error_json, "scope", conflict->mentee_id == mentee_id ? "mentee" : "mentor"))
+    {
+        cJSON_Delete(error_json); cJSON_Delete(conflict_json);
+        return send_error_response(connection, MHD_HTTP_CONFLICT, "Meeting overlaps an existing meeting");
     }
+    if (!cJSON_AddItemToObject(error_json, "conflict", conflict_json)) cJSON_Delete(conflict_json);
+    return send_json_response(connection, MHD_HTTP_CONFLICT, error_json);
+}
 
-    char *endptr;
-    long user_id_long = strtol(user_id_str, &endptr, 10);
-
-    // Validate user ID format
-    if (*endptr != '\0' || user_id_long <= 0 || user_id_long > INT_MAX) {
-        printf("[AUTH] Failed: Invalid User ID format '%s'.\n", user_id_str); fflush(stdout);
-        return NULL;
+/**
+ * @brief Validates the session token in "Authorization: Bearer <token>".
+ * @return 1 and fills 'session' if it is live, else 0.
+ */
+static int find_request_session(struct MHD_Connection *connection, SessionInfo *session) {
+    const char *auth_str = MHD_lookup_connection_value(connection, MHD_HEADER_KIND, AUTH_HEADER);
+    if (!auth_str) {
+        LOG_INFO("[AUTH] Failed: Missing %s header.", AUTH_HEADER);
+        return 0;
     }
-    int user_id = (int)user_id_long;
-
-    // Find user by ID
-    User* current_user = app_data->users_head;
-    while(current_user != NULL) {
-        if (current_user->id == user_id) {
-            // Check role match
-            if (current_user->role == required_role) {
-                 printf("[AUTH] Success: User ID %d authenticated as %s.\n", user_id, role_to_string(required_role)); fflush(stdout);
-                 // Populate output parameters if provided
-                 if (authenticated_user_id) *authenticated_user_id = user_id;
-                 if (authenticated_assoc_id) *authenticated_assoc_id = current_user->associated_id;
-                 return current_user; // Success
-            } else {
-                 // Role mismatch
-                 printf("[AUTH] Failed: User ID %d role mismatch (Required: %s, Actual: %s).\n", user_id, role_to_string(required_role), role_to_string(current_user->role)); fflush(stdout);
-                 return NULL;
-            }
-        }
-        current_user = current_user->next;
+    if (0 != strncmp(auth_str, AUTH_SCHEME, strlen(AUTH_SCHEME))) {
+        LOG_INFO("[AUTH] Failed: %s header is not a bearer token.", AUTH_HEADER);
+        return 0;
     }
+    if (!session_lookup(auth_str + strlen(AUTH_SCHEME), session)) {
+        LOG_INFO("[AUTH] Failed: Unknown or expired session token.");
+        return 0;
+    }
+    return 1;
+}
 
-    // User ID not found
-    printf("[AUTH] Failed: User ID %d not found.\n", user_id); fflush(stdout);
-    return NULL;
+/**
+ * @brief find_request_session() without the logging, for decisions taken
+ * before the handler runs; the handler authenticates (and logs) as usual.
+ */
+static int peek_request_session(struct MHD_Connection *connection, SessionInfo *session) {
+    const char *auth_str = MHD_lookup_connection_value(connection, MHD_HEADER_KIND, AUTH_HEADER);
+    return auth_str && 0 == strncmp(auth_str, AUTH_SCHEME, strlen(AUTH_SCHEME)) &&
+           session_lookup(auth_str + strlen(AUTH_SCHEME), session);
+}
+
+/**
+ * @brief Checks the session's cached role against the required one.
+ * Populates authenticated_user_id and authenticated_assoc_id if pointers are provided.
+ */
+static int check_session_role(const SessionInfo *session, UserRole required_role, int *authenticated_user_id, int *authenticated_assoc_id) {
+    if (session->role != required_role) {
+        LOG_INFO("[AUTH] Failed: User ID %d role mismatch (Required: %s, Actual: %s).", session->user_id, role_to_string(required_role), role_to_string(session->role));
+        return 0;
+    }
+    LOG_DEBUG("[AUTH] Success: User ID %d authenticated as %s.", session->user_id, role_to_string(required_role));
+    if (authenticated_user_id) *authenticated_user_id = session->user_id;
+    if (authenticated_assoc_id) *authenticated_assoc_id = session->associated_id;
+    return 1;
+}
+
+/**
+ * @brief Authenticates a request by its session token and required role. The
+ * session table caches the role and associated ID, so the user collection is
+ * not consulted. Operations of a batch reuse the session the batch validated.
+ * @return 1 if authenticated, else 0.
+ */
+static int authenticate_request(struct MHD_Connection *connection, AppData *app_data, UserRole required_role, int *authenticated_user_id, int *authenticated_assoc_id) {
+    (void)app_data;
+    if (current_batch) return check_session_role(&current_batch->session, required_role, authenticated_user_id, authenticated_assoc_id);
+    TraceSpan span = trace_begin("auth");
+    SessionInfo session;
+    int ok = find_request_session(connection, &session) &&
+             check_session_role(&session, required_role, authenticated_user_id, authenticated_assoc_id);
+    trace_end(span);
+    return ok;
+}
+
+/**
+ * @brief Parses a request body as JSON (traced as the "parse" phase).
+ * @return The parsed tree (caller deletes) or NULL if it is not valid JSON.
+ */
+static cJSON* parse_request_body(const char *upload_data, size_t upload_data_size) {
+    TraceSpan span = trace_begin("parse");
+    pthread_once(&json_hooks_once, install_json_hooks);
+    json_parse_in_arena = 1; // The tree is released with the request arena
+    cJSON *root = cJSON_ParseWithLength(upload_data, upload_data_size);
+    json_parse_in_arena = 0;
+    trace_end(span);
+    return root;
 }
 
 /**
  * @brief Generates a simple username from a full name (lowercase, no spaces).
- * Caller must free the returned string. Returns NULL on failure.
+ * The string lives in the request arena. Returns NULL on failure.
  */
 static char* generate_username_from_name(const char* full_name) {
     if (!full_name) return NULL;
-    size_t len = strlen(full_name);
-    char* username = malloc(len + 1); // Max possible length
+    char* username = request_strdup(full_name); // Max possible length
     if (!username) return NULL;
+    size_t len = strlen(full_name);
 
     size_t j = 0;
     for (size_t i = 0; i < len; ++i) {
@@ -196,27 +997,213 @@ static char* generate_username_from_name(const char* full_name) {
 
     // Optional: check if username is empty after removing spaces
     if (j == 0) {
-        free(username);
-        return safe_strdup("newuser"); // Fallback username
+        return request_strdup("newuser"); // Fallback username
     }
 
     return username;
 }
 
 
+/**
+ * @brief Parses a time query parameter: Unix seconds, "YYYY-MM-DD" or
+ * "YYYY-MM-DD HH:MM" / "YYYY-MM-DDTHH:MM" (local time). Returns 1 on success.
+ */
+static int parse_time_param(const char* value, time_t* out) {
+    if (!value || !*value || !out) return 0;
+
+    char *endptr;
+    long long seconds = strtoll(value, &endptr, 10);
+    if (*endptr == '\0') {
+        *out = (time_t)seconds;
+        return 1;
+    }
+
+    struct tm tm_val = {0};
+    const char *rest = strptime(value, "%Y-%m-%d", &tm_val);
+    if (!rest) return 0;
+    if (*rest == 'T' || *rest == ' ') {
+        rest = strptime(rest + 1, "%H:%M", &tm_val);
+        if (!rest) return 0;
+    }
+    if (*rest != '\0') return 0;
+    tm_val.tm_isdst = -1;
+    *out = mktime(&tm_val);
+    return 1;
+}
+
+// Accumulator used with for_each_meeting_in_range() to build a JSON array
+struct MeetingArrayCtx {
+    cJSON *array;
+    int limit;   // <= 0 means unlimited
+    int count;
+    int failed;
+};
+
+/**
+ * @brief MeetingVisitor that appends meeting_to_json() output to ctx->array.
+ */
+static int append_meeting_json(const Meeting* meeting, void* ctx) {
+    struct MeetingArrayCtx *acc = ctx;
+    cJSON* meeting_json = meeting_to_json(meeting);
+    if (!meeting_json || !cJSON_AddItemToArray(acc->array, meeting_json)) {
+        cJSON_Delete(meeting_json);
+        acc->failed = 1;
+        return 0;
+    }
+    acc->count++;
+    return (acc->limit <= 0 || acc->count < acc->limit);
+}
+
+/**
+ * @brief Appends a "meeting_reminder" notification object to a JSON array.
+ */
+static void append_meeting_reminder(cJSON *notifications_array, const Meeting* meeting, const char *text) {
+    cJSON* notification_obj = cJSON_CreateObject();
+    if (!notification_obj) return;
+    cJSON_AddStringToObject(notification_obj, "type", "meeting_reminder");
+    cJSON_AddStringToObject(notification_obj, "text", text);
+    cJSON_AddNumberToObject(notification_obj, "timestamp", (double)meeting->start_time);
+    cJSON_AddNumberToObject(notification_obj, "relatedId", meeting->id);
+    if (!cJSON_AddItemToArray(notifications_array, notification_obj)) cJSON_Delete(notification_obj); // Add or delete if fails
+}
+
+/** @brief MeetingVisitor: mentor-facing reminder ("Upcoming Meeting: <mentee> @ <time>"). */
+static int append_mentor_meeting_reminder(const Meeting* meeting, void* ctx) {
+    char notification_text[256];
+    snprintf(notification_text, sizeof(notification_text), "Upcoming Meeting: %s @ %s",
+             meeting->mentee_name ? meeting->mentee_name : "?",
+             meeting->time_str ? meeting->time_str : "?");
+    append_meeting_reminder(ctx, meeting, notification_text);
+    return 1;
+}
+
+/** @brief MeetingVisitor: mentee-facing reminder ("Upcoming meeting with mentor on <date> at <time>"). */
+static int append_mentee_meeting_reminder(const Meeting* meeting, void* ctx) {
+    char notification_text[256];
+    snprintf(notification_text, sizeof(notification_text), "Upcoming meeting with mentor on %s at %s",
+             meeting->date_str ? meeting->date_str : "?",
+             meeting->time_str ? meeting->time_str : "?");
+    append_meeting_reminder(ctx, meeting, notification_text);
+    return 1;
+}
+
+/**
+ * @brief Strict IssueStatus parse for query parameters ("Open", "in_progress", ...).
+ * Unlike string_to_status() it rejects unknown values instead of defaulting.
+ */
+static int parse_status_param(const char* value, IssueStatus* out) {
+    if (!value || !out) return 0;
+    if (strcasecmp(value, "in_progress") == 0) { *out = STATUS_IN_PROGRESS; return 1; }
+    for (int s = 0; s < ISSUE_STATUS_COUNT; ++s) {
+        if (strcasecmp(value, status_to_string((IssueStatus)s)) == 0) { *out = (IssueStatus)s; return 1; }
+    }
+    return 0;
+}
+
+/**
+ * @brief Strict IssuePriority parse for query parameters ("Low", "medium", ...).
+ */
+static int parse_priority_param(const char* value, IssuePriority* out) {
+    if (!value || !out) return 0;
+    for (int p = 0; p < ISSUE_PRIORITY_COUNT; ++p) {
+        if (strcasecmp(value, priority_to_string((IssuePriority)p)) == 0) { *out = (IssuePriority)p; return 1; }
+    }
+    return 0;
+}
+
+// Names accepted by /api/search?type=, indexed by SearchDocKind
+static const char* const search_kind_names[] = { "mentee", "meeting", "issue", "note" };
+
+/**
+ * @brief Parses a comma-separated 'type' list into SEARCH_KIND_BIT flags.
+ */
+static int parse_search_kinds(const char* value, unsigned int* mask_out) {
+    if (!value || !mask_out) return 0;
+    unsigned int mask = 0;
+    const char* cursor = value;
+    while (*cursor) {
+        size_t len = strcspn(cursor, ",");
+        int matched = 0;
+        for (int k = 0; k <= SEARCH_DOC_NOTE; ++k) {
+            if (len == strlen(search_kind_names[k]) && strncasecmp(cursor, search_kind_names[k], len) == 0) {
+                mask |= SEARCH_KIND_BIT(k);
+                matched = 1;
+            }
+        }
+        if (!matched) return 0;
+        cursor += len;
+        if (*cursor == ',') cursor++;
+    }
+    if (!mask) return 0;
+    *mask_out = mask;
+    return 1;
+}
+
+/**
+ * @brief Serializes a search hit as {type, id, score, item} (+ parent for notes).
+ */
+static cJSON* search_hit_to_json(const SearchHit* hit) {
+    cJSON *item = NULL;
+    switch (hit->kind) {
+        case SEARCH_DOC_MENTEE: item = mentee_to_json((const Mentee*)hit->ref); break;
+        case SEARCH_DOC_MEETING: item = meeting_to_json((const Meeting*)hit->ref); break;
+        case SEARCH_DOC_ISSUE: item = issue_to_json((const Issue*)hit->ref); break;
+        case SEARCH_DOC_NOTE: item = note_to_json((const Note*)hit->ref); break;
+    }
+    cJSON *hit_json = cJSON_CreateObject();
+    if (!item || !hit_json ||
+        !cJSON_AddStringToObject(hit_json, "type", search_kind_names[hit->kind]) ||
+        !cJSON_AddNumberToObject(hit_json, "score", hit->score))
+    {
+        cJSON_Delete(item);
+        cJSON_Delete(hit_json);
+        return NULL;
+    }
+    if (hit->kind == SEARCH_DOC_NOTE) {
+        // Notes have no ID of their own; point at the mentee/issue they belong to
+        cJSON_AddStringToObject(hit_json, "parent_type", search_kind_names[hit->owner_kind]);
+        cJSON_AddNumberToObject(hit_json, "parent_id", hit->owner_id);
+    } else {
+        cJSON_AddNumberToObject(hit_json, "id", hit->owner_id);
+    }
+    cJSON_AddItemToObject(hit_json, "item", item);
+    return hit_json;
+}
+
+
 // ========================================================================== //
 //                       LOGIN/LOGOUT HANDLERS                                //
 // ========================================================================== //
 
+static char default_hash[PASSWORD_HASH_SIZE];
+static pthread_once_t default_hash_once = PTHREAD_ONCE_INIT;
+
+static void init_default_hash(void) {
+    if (!password_hash(DEFAULT_PASSWORD, default_hash, sizeof(default_hash))) default_hash[0] = '\0';
+}
+
+/**
+ * @brief Hash of DEFAULT_PASSWORD, computed once and shared by every account
+ * created with it: a salt cannot protect a password everyone knows, and this
+ * keeps the slow hash out of handlers holding the exclusive data lock.
+ * NULL if hashing failed.
+ */
+static const char *default_password_hash(void) {
+    pthread_once(&default_hash_once, init_default_hash);
+    return default_hash[0] ? default_hash : NULL;
+}
+
 /**
- * @brief Handles POST /api/login requests.
+ * @brief Handles POST /api/login requests. The password check runs on the
+ * verification pool with the data lock released, so a burst of logins queues
+ * there instead of stalling writers (see password.h).
  */
 static enum MHD_Result handle_login(struct MHD_Connection *connection, AppData *app_data, const char *upload_data, size_t upload_data_size) {
-    printf("[API] POST /api/login\n"); fflush(stdout);
+    LOG_INFO("[API] POST /api/login");
     if (!app_data) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Internal server error (app_data null)");
     if (!upload_data || upload_data_size == 0) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Missing request body");
 
-    cJSON *root = cJSON_ParseWithLength(upload_data, upload_data_size);
+    cJSON *root = parse_request_body(upload_data, upload_data_size);
     if (!root) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid JSON data");
 
     const cJSON *username_json = cJSON_GetObjectItemCaseSensitive(root, "username");
@@ -233,47 +1220,78 @@ static enum MHD_Result handle_login(struct MHD_Connection *connection, AppData *
     }
 
     UserRole selected_role = string_to_role(role_str_val);
-    // Verify credentials using the insecure plain text comparison
-    User *user = verify_user_password(app_data, username_val, password_val);
+    // request_handler leaves login unlocked: copy what the check needs under the
+    // lock, then verify without it. Unknown names are checked against a dummy
+    // hash so they take just as long.
+    const char *dummy_hash = password_dummy_hash(); // Computed on first use, so not under the lock
+    lock_app_data(0);
+    const User *user = find_user_by_username(app_data, username_val);
+    int user_found = user != NULL;
+    char stored_hash[PASSWORD_HASH_SIZE];
+    snprintf(stored_hash, sizeof(stored_hash), "%s", user ? user->password_hash : dummy_hash);
+    SessionInfo session = { 0, ROLE_MENTEE, 0 }; // Only used when the user exists
+    if (user) session = (SessionInfo){ user->id, user->role, user->associated_id };
+    unlock_app_data();
+
+    TraceSpan verify_span = trace_begin("password");
+    PasswordResult verified = password_verify(password_val, stored_hash);
+    trace_end(verify_span);
+
+    if (verified == PASSWORD_BUSY) {
+        cJSON_Delete(root);
+        return send_error_response(connection, MHD_HTTP_SERVICE_UNAVAILABLE, "Too many logins in progress, please retry");
+    }
+    int authenticated = user_found && verified == PASSWORD_MATCH;
+    // Log before the delete: username_val points into 'root'
+    if (!authenticated) LOG_INFO("[AUTH] Login failed for user '%s': Invalid username or password.", username_val);
+    else if (session.role == selected_role) LOG_INFO("[AUTH] Login successful for user '%s' (ID: %d, Role: %s) - Role matched selection.", username_val, session.user_id, role_to_string(session.role));
+    else LOG_INFO("[AUTH] Login failed for user '%s': Role mismatch (Selected: %s, Actual: %s).", username_val, role_to_string(selected_role), role_to_string(session.role));
     cJSON_Delete(root);
 
-    if (user) {
+    if (authenticated) {
         // Check if the authenticated user's role matches the role they selected on the login form
-        if (user->role == selected_role) {
-            printf("[AUTH] Login successful for user '%s' (ID: %d, Role: %s) - Role matched selection.\n", user->username, user->id, role_to_string(user->role)); fflush(stdout);
-            // Send success response including user info
+        if (session.role == selected_role) {
+            char token[SESSION_TOKEN_LENGTH + 1];
+            if (!session_create(&session, token)) {
+                return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to create session");
+            }
+            // Send success response including user info and the token for AUTH_HEADER
             cJSON *response_json = cJSON_CreateObject();
             if (!response_json ||
                 !cJSON_AddTrueToObject(response_json, "success") ||
-                !cJSON_AddStringToObject(response_json, "role", role_to_string(user->role)) ||
-                !cJSON_AddNumberToObject(response_json, "userId", user->id) ||
-                !cJSON_AddNumberToObject(response_json, "associatedId", user->associated_id))
+                !cJSON_AddStringToObject(response_json, "token", token) ||
+                !cJSON_AddNumberToObject(response_json, "expiresIn", SESSION_TTL_SECONDS) ||
+                !cJSON_AddStringToObject(response_json, "role", role_to_string(session.role)) ||
+                !cJSON_AddNumberToObject(response_json, "userId", session.user_id) ||
+                !cJSON_AddNumberToObject(response_json, "associatedId", session.associated_id))
             {
                 cJSON_Delete(response_json);
+                session_revoke(token); // The client never saw it
                 return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed preparing success response");
             }
             return send_json_response(connection, MHD_HTTP_OK, response_json);
         } else {
-            // Password was correct, but user selected the wrong role on the form
-            printf("[AUTH] Login failed for user '%s': Role mismatch (Selected: %s, Actual: %s).\n", user->username, role_to_string(selected_role), role_to_string(user->role)); fflush(stdout);
+            // Password was correct, but user selected the wrong role on the form (logged above)
             return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Invalid credentials for the selected role");
         }
     } else {
-        // Username not found or password incorrect
-        printf("[AUTH] Login failed for user '%s': Invalid username or password.\n", username_val); fflush(stdout);
+        // Username not found or password incorrect (logged above)
         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Invalid username or password");
     }
 }
 
 /**
- * @brief Handles POST /api/logout requests. (Currently just acknowledges)
+ * @brief Handles POST /api/logout requests: revokes the session token, if any.
+ * Succeeds either way so a client can always clear its stored token.
  */
 static enum MHD_Result handle_logout(struct MHD_Connection *connection, AppData *app_data) {
-     printf("[API] POST /api/logout\n"); fflush(stdout);
-     (void)app_data; // Mark unused for now
+     LOG_INFO("[API] POST /api/logout");
+     (void)app_data; // Sessions live outside AppData
 
-     // In a real session-based system, this would invalidate the session/token.
-     // Here, we just return success as the client clears its stored ID.
+     const char *auth_str = MHD_lookup_connection_value(connection, MHD_HEADER_KIND, AUTH_HEADER);
+     if (auth_str && 0 == strncmp(auth_str, AUTH_SCHEME, strlen(AUTH_SCHEME)) && session_revoke(auth_str + strlen(AUTH_SCHEME))) {
+         LOG_INFO("[AUTH] Session revoked (%zu live).", session_count());
+     }
      cJSON *response_json = cJSON_CreateObject();
      if (!response_json || !cJSON_AddTrueToObject(response_json, "success")) {
          cJSON_Delete(response_json);
@@ -289,7 +1307,7 @@ static enum MHD_Result handle_logout(struct MHD_Connection *connection, AppData
 
 /** @brief GET /api/mentees */
 static enum MHD_Result handle_get_mentees(struct MHD_Connection *connection, AppData *app_data) {
-    printf("[API] Mentor: GET /api/mentees\n"); fflush(stdout);
+    LOG_INFO("[API] Mentor: GET /api/mentees");
     int user_id, assoc_id; // Placeholders, assoc_id not used for mentor here
     if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
@@ -299,12 +1317,56 @@ static enum MHD_Result handle_get_mentees(struct MHD_Connection *connection, App
     if (!mentees_array) {
         return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize mentee list");
     }
-    return send_json_response(connection, MHD_HTTP_OK, mentees_array);
+    return send_json_response(connection, MHD_HTTP_OK, mentees_array);
+}
+
+/** @brief GET /api/mentees/suggest?prefix=[&limit=] - Typeahead over mentee names/usernames */
+static enum MHD_Result handle_get_mentee_suggestions(struct MHD_Connection *connection, AppData *app_data) {
+    LOG_INFO("[API] Mentor: GET /api/mentees/suggest");
+    int user_id, assoc_id;
+    if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
+        return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
+    }
+
+    const char *prefix = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "prefix");
+    const char *limit_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "limit");
+    if (!prefix || strlen(prefix) == 0) {
+        return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Missing 'prefix'");
+    }
+    int limit = limit_str ? atoi(limit_str) : SUGGEST_DEFAULT_LIMIT;
+    if (limit <= 0 || limit > SUGGEST_MAX_LIMIT) {
+        return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'limit' (1-50)");
+    }
+
+    MenteeSuggestion suggestions[SUGGEST_MAX_LIMIT];
+    int count = suggest_mentees(app_data, prefix, suggestions, limit);
+
+    cJSON *suggestions_array = cJSON_CreateArray();
+    if (!suggestions_array) {
+        return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create suggestions JSON");
+    }
+    for (int i = 0; i < count; ++i) {
+        const Mentee *mentee = suggestions[i].mentee;
+        cJSON *item = cJSON_CreateObject();
+        if (!item ||
+            !cJSON_AddNumberToObject(item, "id", mentee->id) ||
+            !cJSON_AddStringToObject(item, "name", mentee->name) ||
+            !cJSON_AddStringToObject(item, "subject", mentee->subject ? mentee->subject : "") ||
+            !cJSON_AddStringToObject(item, "matched", suggestions[i].user ? "username" : "name") ||
+            (suggestions[i].user && !cJSON_AddStringToObject(item, "username", suggestions[i].user->username)) ||
+            !cJSON_AddItemToArray(suggestions_array, item))
+        {
+            cJSON_Delete(item);
+            cJSON_Delete(suggestions_array);
+            return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize suggestions");
+        }
+    }
+    return send_json_response(connection, MHD_HTTP_OK, suggestions_array);
 }
 
 /** @brief POST /api/mentees - Add Mentee AND create User account */
 static enum MHD_Result handle_post_mentees(struct MHD_Connection *connection, AppData *app_data, const char *upload_data, size_t upload_data_size) {
-    printf("[API] Mentor: POST /api/mentees\n"); fflush(stdout);
+    LOG_INFO("[API] Mentor: POST /api/mentees");
     int user_id, assoc_id;
     if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
@@ -313,7 +1375,7 @@ static enum MHD_Result handle_post_mentees(struct MHD_Connection *connection, Ap
         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Missing request body");
     }
 
-    cJSON *root = cJSON_ParseWithLength(upload_data, upload_data_size);
+    cJSON *root = parse_request_body(upload_data, upload_data_size);
     if (!root) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid JSON data");
 
     const cJSON *name_json = cJSON_GetObjectItemCaseSensitive(root, "name");
@@ -345,28 +1407,25 @@ static enum MHD_Result handle_post_mentees(struct MHD_Connection *connection, Ap
 
     // --- Create User Account for the New Mentee ---
     char* mentee_username = generate_username_from_name(new_mentee->name);
-    const char* default_password = "password"; // !! INSECURE DEFAULT PASSWORD !!
-
     if (!mentee_username) {
-         fprintf(stderr, "Warning: Failed to generate username for new mentee ID %d. User account NOT created.\n", new_mentee->id);
+         LOG_WARN("Failed to generate username for new mentee ID %d. User account NOT created.", new_mentee->id);
          // Mentee was added, but user creation failed. Proceed with success for mentee add?
          // Or maybe delete the mentee record? For now, return success for mentee add.
-         if (!save_data_to_file(app_data, DATA_FILE)) { fprintf(stderr,"Error saving data after failed user generation for mentee %d\n", new_mentee->id); }
+         if (!persist_app_data(app_data)) { LOG_ERROR("Error saving data after failed user generation for mentee %d", new_mentee->id); }
          cJSON *response_json = mentee_to_json(new_mentee);
          return send_json_response(connection, MHD_HTTP_CREATED, response_json ? response_json : cJSON_CreateObject());
     }
 
-    User* new_user = add_user(app_data, mentee_username, default_password, ROLE_MENTEE, new_mentee->id);
-    free(mentee_username); // Free the generated username string
+    User* new_user = add_user_with_hash(app_data, mentee_username, default_password_hash(), ROLE_MENTEE, new_mentee->id);
 
     if (!new_user) {
         // Log warning: Mentee was created, but user account failed (e.g., username conflict after generation?)
-        fprintf(stderr, "Warning: Mentee ID %d added, but failed to create associated user account (username conflict?).\n", new_mentee->id);
+        LOG_WARN("Mentee ID %d added, but failed to create associated user account (username conflict?).", new_mentee->id);
         // Data might have been saved by add_mentee OR add_user before failure. Explicitly save again?
-         if (!save_data_to_file(app_data, DATA_FILE)) { fprintf(stderr,"Error saving data after failed user creation for mentee %d\n", new_mentee->id); }
+         if (!persist_app_data(app_data)) { LOG_ERROR("Error saving data after failed user creation for mentee %d", new_mentee->id); }
          // Fall through to return success for the mentee creation part
     } else {
-        printf("Successfully added mentee ID %d and associated user account ID %d.\n", new_mentee->id, new_user->id);
+        LOG_INFO("Successfully added mentee ID %d and associated user account ID %d.", new_mentee->id, new_user->id);
         // Data was saved inside add_user.
     }
 
@@ -380,7 +1439,7 @@ static enum MHD_Result handle_post_mentees(struct MHD_Connection *connection, Ap
 
 /** @brief DELETE /api/mentees/:id */
 static enum MHD_Result handle_delete_mentee(struct MHD_Connection *connection, AppData *app_data, int mentee_id) {
-    printf("[API] Mentor: DELETE /api/mentees/%d\n", mentee_id); fflush(stdout);
+    LOG_INFO("[API] Mentor: DELETE /api/mentees/%d", mentee_id);
     int user_id, assoc_id;
     if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
@@ -397,44 +1456,67 @@ static enum MHD_Result handle_delete_mentee(struct MHD_Connection *connection, A
 
     if (delete_result == 1) {
         // Send 204 No Content on successful deletion
-        struct MHD_Response *response = MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT);
-        if (!response) return MHD_NO; // Internal server error creating response
-        MHD_add_response_header(response, "Access-Control-Allow-Origin", "*");
-        MHD_add_response_header(response, "Access-Control-Allow-Methods", "GET, POST, PATCH, DELETE, OPTIONS");
-        MHD_add_response_header(response, "Access-Control-Allow-Headers", "Content-Type, Authorization, " AUTH_HEADER);
-        enum MHD_Result ret = MHD_queue_response(connection, MHD_HTTP_NO_CONTENT, response);
-        MHD_destroy_response(response);
-        return ret;
+        return queue_cached_response(connection, MHD_HTTP_NO_CONTENT, &no_content_response);
     } else {
         // Mentee not found or deletion failed internally
         return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee not found or deletion failed");
     }
 }
 
-/** @brief GET /api/meetings */
+/** @brief GET /api/meetings[?from=&to=&limit=] */
 static enum MHD_Result handle_get_meetings(struct MHD_Connection *connection, AppData *app_data) {
-     printf("[API] Mentor: GET /api/meetings\n"); fflush(stdout);
+     LOG_INFO("[API] Mentor: GET /api/meetings");
      int user_id, assoc_id;
      if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
          return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
      }
-     cJSON *meetings_array = meeting_list_to_json_array(app_data->meetings_head);
-     if (!meetings_array) {
+
+     const char *from_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "from");
+     const char *to_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "to");
+     const char *limit_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "limit");
+
+     // No window requested: keep the original full-list behaviour
+     if (!from_str && !to_str && !limit_str) {
+         cJSON *meetings_array = meeting_list_to_json_array(app_data->meetings_head);
+         if (!meetings_array) {
+             return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize meeting list");
+         }
+         return send_json_response(connection, MHD_HTTP_OK, meetings_array);
+     }
+
+     // Window query served from the time index: meetings with from <= start < to
+     time_t from = 1, to = (time_t)LLONG_MAX; // start_time 0 marks unparseable dates; keep them out of windows
+     if (from_str && !parse_time_param(from_str, &from)) {
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'from' (use Unix seconds or YYYY-MM-DD[THH:MM])");
+     }
+     if (to_str && !parse_time_param(to_str, &to)) {
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'to' (use Unix seconds or YYYY-MM-DD[THH:MM])");
+     }
+     int limit = limit_str ? atoi(limit_str) : 0;
+     if (limit_str && limit <= 0) {
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'limit'");
+     }
+
+     struct MeetingArrayCtx acc = { cJSON_CreateArray(), limit, 0, 0 };
+     if (!acc.array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create meetings array");
+     for_each_meeting_in_range(app_data, 0, from, to, append_meeting_json, &acc);
+     if (acc.failed) {
+         cJSON_Delete(acc.array);
          return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize meeting list");
      }
-     return send_json_response(connection, MHD_HTTP_OK, meetings_array);
+     return send_json_response(connection, MHD_HTTP_OK, acc.array);
 }
 
 /** @brief POST /api/meetings */
 static enum MHD_Result handle_post_meetings(struct MHD_Connection *connection, AppData *app_data, const char *upload_data, size_t upload_data_size) {
-     printf("[API] Mentor: POST /api/meetings\n"); fflush(stdout);
+     LOG_INFO("[API] Mentor: POST /api/meetings");
      int user_id, assoc_id;
      if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
          return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
      }
      if (!upload_data || upload_data_size == 0) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Missing request body");
 
-     cJSON* root = cJSON_ParseWithLength(upload_data,upload_data_size);
+     cJSON* root = parse_request_body(upload_data, upload_data_size);
      if(!root) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid JSON");
 
      // Frontend sends 'mentee' field with the name
@@ -443,12 +1525,22 @@ static enum MHD_Result handle_post_meetings(struct MHD_Connection *connection, A
      const char* time_val = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(root,"time"));
      const cJSON* duration_json = cJSON_GetObjectItemCaseSensitive(root,"duration");
      const char* notes_val = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(root,"notes"));
+     int allow_conflict = cJSON_IsTrue(cJSON_GetObjectItemCaseSensitive(root,"allow_conflict")); // Flag instead of reject
 
      if(!mentee_name_val || !date_val || !time_val || !cJSON_IsNumber(duration_json) || duration_json->valueint <= 0){
          cJSON_Delete(root);
          return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Missing/invalid fields (mentee, date, time, duration)");
      }
+     if (duration_json->valuedouble > MAX_MEETING_MINUTES) {
+         cJSON_Delete(root);
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'duration' (max 1440 minutes)");
+     }
      int duration_val = duration_json->valueint;
+     time_t start_time = parse_meeting_datetime(date_val, time_val);
+     if (start_time <= 0) {
+         cJSON_Delete(root);
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid date/time (expected YYYY-MM-DD and HH:MM)");
+     }
 
      // Find mentee by name to get their ID
      Mentee* mentee = find_mentee_by_name(app_data, mentee_name_val);
@@ -457,6 +1549,13 @@ static enum MHD_Result handle_post_meetings(struct MHD_Connection *connection, A
          return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Mentee not found");
      }
 
+     // Single-mentor system: every meeting is on the mentor's schedule, so check that index
+     Meeting* conflict = find_meeting_conflict(app_data, 0, start_time, duration_val, 0);
+     if (conflict && !allow_conflict) {
+         cJSON_Delete(root);
+         return send_meeting_conflict_response(connection, conflict, mentee->id);
+     }
+
      Meeting* new_meeting = add_meeting(app_data, mentee->id, mentee_name_val, date_val, time_val, duration_val, notes_val); // Saves data
      cJSON_Delete(root);
 
@@ -464,13 +1563,17 @@ static enum MHD_Result handle_post_meetings(struct MHD_Connection *connection, A
 
      cJSON* response_json = meeting_to_json(new_meeting);
      if(!response_json) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR,"Failed to serialize new meeting");
+     if (conflict) { // Accepted with allow_conflict: flag the overlap in the response
+         cJSON* conflict_json = meeting_to_json(conflict);
+         if (conflict_json && !cJSON_AddItemToObject(response_json, "conflict", conflict_json)) cJSON_Delete(conflict_json);
+     }
 
      return send_json_response(connection, MHD_HTTP_CREATED, response_json);
 }
 
 /** @brief PATCH /api/meetings/:id */
 static enum MHD_Result handle_patch_meeting(struct MHD_Connection *connection, AppData *app_data, int meeting_id, const char *upload_data, size_t upload_data_size) {
-    printf("[API] Mentor: PATCH /api/meetings/%d\n", meeting_id); fflush(stdout);
+    LOG_INFO("[API] Mentor: PATCH /api/meetings/%d", meeting_id);
     int user_id, assoc_id;
     if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
@@ -481,7 +1584,7 @@ static enum MHD_Result handle_patch_meeting(struct MHD_Connection *connection, A
     Meeting *meeting = find_meeting_by_id(app_data, meeting_id);
     if (!meeting) return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Meeting not found");
 
-    cJSON* root = cJSON_ParseWithLength(upload_data, upload_data_size);
+    cJSON* root = parse_request_body(upload_data, upload_data_size);
     if (!root) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid JSON");
 
     // Expecting only date and time for rescheduling
@@ -493,12 +1596,23 @@ static enum MHD_Result handle_patch_meeting(struct MHD_Connection *connection, A
         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Missing 'date' or 'time' for update");
     }
 
-    int update_status = update_meeting(meeting, date_val, time_val); // Doesn't save
+    time_t start_time = parse_meeting_datetime(date_val, time_val);
+    if (start_time <= 0) {
+        cJSON_Delete(root);
+        return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid date/time (expected YYYY-MM-DD and HH:MM)");
+    }
+    Meeting* conflict = find_meeting_conflict(app_data, 0, start_time, meeting->duration_minutes, meeting->id);
+    if (conflict && !cJSON_IsTrue(cJSON_GetObjectItemCaseSensitive(root, "allow_conflict"))) {
+        cJSON_Delete(root);
+        return send_meeting_conflict_response(connection, conflict, meeting->mentee_id);
+    }
+
+    int update_status = update_meeting(app_data, meeting, date_val, time_val); // Doesn't save
     cJSON_Delete(root);
 
     if (update_status) {
-        if (!save_data_to_file(app_data, DATA_FILE)) { // Save after successful update
-            fprintf(stderr, "Warning: Failed to save data after patching meeting %d\n", meeting_id); fflush(stderr);
+        if (!persist_app_data(app_data)) { // Save after successful update
+            LOG_WARN("Failed to save data after patching meeting %d", meeting_id);
             // Continue to respond with OK, as update in memory succeeded
         }
         cJSON* response_json = meeting_to_json(meeting);
@@ -511,7 +1625,7 @@ static enum MHD_Result handle_patch_meeting(struct MHD_Connection *connection, A
 
 /** @brief DELETE /api/meetings/:id */
 static enum MHD_Result handle_delete_meeting(struct MHD_Connection *connection, AppData *app_data, int meeting_id) {
-    printf("[API] Mentor: DELETE /api/meetings/%d\n", meeting_id); fflush(stdout);
+    LOG_INFO("[API] Mentor: DELETE /api/meetings/%d", meeting_id);
     int user_id, assoc_id;
     if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
@@ -521,41 +1635,69 @@ static enum MHD_Result handle_delete_meeting(struct MHD_Connection *connection,
     int delete_result = delete_meeting(app_data, meeting_id); // This saves data
 
     if (delete_result == 1) {
-        struct MHD_Response *response = MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT);
-        if (!response) return MHD_NO;
-        MHD_add_response_header(response, "Access-Control-Allow-Origin", "*");
-        MHD_add_response_header(response, "Access-Control-Allow-Methods", "GET, POST, PATCH, DELETE, OPTIONS");
-        MHD_add_response_header(response, "Access-Control-Allow-Headers", "Content-Type, Authorization, " AUTH_HEADER);
-        enum MHD_Result ret = MHD_queue_response(connection, MHD_HTTP_NO_CONTENT, response);
-        MHD_destroy_response(response);
-        return ret;
+        return queue_cached_response(connection, MHD_HTTP_NO_CONTENT, &no_content_response);
     } else {
         return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Meeting not found or deletion failed");
     }
 }
 
-/** @brief GET /api/issues */
+/** @brief GET /api/issues[?status=&priority=] */
 static enum MHD_Result handle_get_issues(struct MHD_Connection *connection, AppData *app_data) {
-     printf("[API] Mentor: GET /api/issues\n"); fflush(stdout);
+     LOG_INFO("[API] Mentor: GET /api/issues");
      int user_id, assoc_id;
      if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
          return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
      }
-     cJSON *issues_array = issue_list_to_json_array(app_data->issues_head);
-     if(!issues_array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize issue list");
+
+     const char *status_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "status");
+     const char *priority_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "priority");
+
+     // No filter requested: keep the original full-list behaviour
+     if (!status_str && !priority_str) {
+         cJSON *issues_array = issue_list_to_json_array(app_data->issues_head);
+         if(!issues_array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize issue list");
+         return send_json_response(connection, MHD_HTTP_OK, issues_array);
+     }
+
+     IssueStatus status = STATUS_OPEN;
+     IssuePriority priority = PRIORITY_MEDIUM;
+     if (status_str && !parse_status_param(status_str, &status)) {
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'status' (Open, In Progress, Resolved)");
+     }
+     if (priority_str && !parse_priority_param(priority_str, &priority)) {
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'priority' (Low, Medium, High)");
+     }
+
+     cJSON *issues_array = cJSON_CreateArray();
+     if (!issues_array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create issues array");
+
+     // Serve straight from the matching (status, priority) buckets, highest priority first
+     for (int s = 0; s < ISSUE_STATUS_COUNT; ++s) {
+         if (status_str && s != (int)status) continue;
+         for (int p = ISSUE_PRIORITY_COUNT - 1; p >= 0; --p) {
+             if (priority_str && p != (int)priority) continue;
+             for (Issue* current = issue_bucket_head(app_data, (IssueStatus)s, (IssuePriority)p); current; current = current->bucket_next) {
+                 cJSON* issue_json = issue_to_json(current);
+                 if (!issue_json || !cJSON_AddItemToArray(issues_array, issue_json)) {
+                     cJSON_Delete(issue_json); cJSON_Delete(issues_array);
+                     return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize issue list");
+                 }
+             }
+         }
+     }
      return send_json_response(connection, MHD_HTTP_OK, issues_array);
 }
 
 /** @brief POST /api/issues (Mentor reports issue for a mentee) */
 static enum MHD_Result handle_post_issues(struct MHD_Connection *connection, AppData *app_data, const char *upload_data, size_t upload_data_size) {
-     printf("[API] Mentor: POST /api/issues\n"); fflush(stdout);
+     LOG_INFO("[API] Mentor: POST /api/issues");
      int user_id, assoc_id;
      if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
      }
      if (!upload_data || upload_data_size == 0) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Missing body");
 
-     cJSON* root = cJSON_ParseWithLength(upload_data,upload_data_size);
+     cJSON* root = parse_request_body(upload_data, upload_data_size);
      if(!root) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid JSON");
 
      const char* mentee_name_val = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(root,"mentee"));
@@ -587,7 +1729,7 @@ static enum MHD_Result handle_post_issues(struct MHD_Connection *connection, App
 
 /** @brief PATCH /api/issues/:id */
 static enum MHD_Result handle_patch_issue(struct MHD_Connection *connection, AppData *app_data, int issue_id, const char *upload_data, size_t upload_data_size) {
-    printf("[API] Mentor: PATCH /api/issues/%d\n", issue_id); fflush(stdout);
+    LOG_INFO("[API] Mentor: PATCH /api/issues/%d", issue_id);
     int user_id, assoc_id;
     if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
@@ -598,7 +1740,7 @@ static enum MHD_Result handle_patch_issue(struct MHD_Connection *connection, App
     Issue *issue = find_issue_by_id(app_data, issue_id);
     if (!issue) return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Issue not found");
 
-    cJSON* root = cJSON_ParseWithLength(upload_data, upload_data_size);
+    cJSON* root = parse_request_body(upload_data, upload_data_size);
     if (!root) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid JSON");
 
     const char* status_val = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(root,"status"));
@@ -610,12 +1752,12 @@ static enum MHD_Result handle_patch_issue(struct MHD_Connection *connection, App
     }
 
     IssueStatus new_status = string_to_status(status_val);
-    int update_res = update_issue_status(issue, new_status, note_text); // Doesn't save
+    int update_res = update_issue_status(app_data, issue, new_status, note_text); // Doesn't save
     cJSON_Delete(root);
 
     if (update_res) {
-        if (!save_data_to_file(app_data, DATA_FILE)) { // Save after successful update
-            fprintf(stderr, "Warning: Save failed after patching issue %d\n", issue_id); fflush(stderr);
+        if (!persist_app_data(app_data)) { // Save after successful update
+            LOG_WARN("Save failed after patching issue %d", issue_id);
         }
         cJSON* response_json = issue_to_json(issue);
         if (!response_json) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize updated issue");
@@ -625,86 +1767,774 @@ static enum MHD_Result handle_patch_issue(struct MHD_Connection *connection, App
     }
 }
 
+/** @brief GET /api/availability?from=&to=[&duration=] - Free slots on the mentor's schedule */
+static enum MHD_Result handle_get_availability(struct MHD_Connection *connection, AppData *app_data) {
+     LOG_INFO("[API] Mentor: GET /api/availability");
+     int user_id, assoc_id;
+     if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
+         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
+     }
+
+     const char *from_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "from");
+     const char *to_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "to");
+     const char *duration_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "duration");
+
+     time_t from, to;
+     if (!parse_time_param(from_str, &from) || !parse_time_param(to_str, &to) || from >= to) {
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Missing/invalid 'from' and 'to' (Unix seconds or YYYY-MM-DD[THH:MM])");
+     }
+     if (to - from > MAX_AVAILABILITY_RANGE) {
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Range too large (max 31 days)");
+     }
+     int duration = duration_str ? atoi(duration_str) : 30;
+     if (duration <= 0 || duration > MAX_MEETING_MINUTES) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'duration' (max 1440 minutes)");
+
+     TimeSlot slots[MAX_AVAILABILITY_SLOTS];
+     int slot_count = find_free_slots(app_data, from, to, duration, slots, MAX_AVAILABILITY_SLOTS);
+
+     cJSON *response_json = cJSON_CreateObject();
+     cJSON *slots_array = cJSON_AddArrayToObject(response_json, "slots");
+     if (!response_json || !slots_array ||
+         !cJSON_AddNumberToObject(response_json, "from", (double)from) ||
+         !cJSON_AddNumberToObject(response_json, "to", (double)to) ||
+         !cJSON_AddNumberToObject(response_json, "duration", duration))
+     {
+         cJSON_Delete(response_json);
+         return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create availability JSON");
+     }
+     for (int i = 0; i < slot_count; ++i) {
+         char date_buf[16], time_buf[8];
+         struct tm slot_tm;
+         localtime_r(&slots[i].start, &slot_tm);
+         strftime(date_buf, sizeof(date_buf), "%Y-%m-%d", &slot_tm);
+         strftime(time_buf, sizeof(time_buf), "%H:%M", &slot_tm);
+
+         cJSON *slot_json = cJSON_CreateObject();
+         if (!slot_json) continue;
+         cJSON_AddNumberToObject(slot_json, "start", (double)slots[i].start);
+         cJSON_AddNumberToObject(slot_json, "end", (double)slots[i].end);
+         cJSON_AddStringToObject(slot_json, "date", date_buf); // Same shape as meeting date/time
+         cJSON_AddStringToObject(slot_json, "time", time_buf);
+         cJSON_AddNumberToObject(slot_json, "minutes", (double)((slots[i].end - slots[i].start) / 60));
+         if (!cJSON_AddItemToArray(slots_array, slot_json)) cJSON_Delete(slot_json);
+     }
+     return send_json_response(connection, MHD_HTTP_OK, response_json);
+}
+
+/** @brief GET /api/search?q=[&type=&limit=&offset=] - Ranked full-text search */
+static enum MHD_Result handle_get_search(struct MHD_Connection *connection, AppData *app_data) {
+     LOG_INFO("[API] Mentor: GET /api/search");
+     int user_id, assoc_id;
+     if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
+         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
+     }
+
+     const char *query = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "q");
+     const char *type_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "type");
+     const char *limit_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "limit");
+     const char *offset_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "offset");
+
+     if (!query || strlen(query) == 0) {
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Missing search query 'q'");
+     }
+     unsigned int kind_mask = SEARCH_KIND_ALL;
+     if (type_str && !parse_search_kinds(type_str, &kind_mask)) {
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'type' (use mentee, meeting, issue, note)");
+     }
+     int limit = limit_str ? atoi(limit_str) : SEARCH_DEFAULT_LIMIT;
+     int offset = offset_str ? atoi(offset_str) : 0;
+     if (limit <= 0 || limit > SEARCH_MAX_LIMIT) {
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'limit' (1-100)");
+     }
+     if (offset < 0 || offset > SEARCH_MAX_OFFSET) {
+         return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'offset' (0-10000)");
+     }
+
+     SearchHit hits[SEARCH_MAX_LIMIT];
+     size_t total = 0;
+     size_t hit_count = search_index_query(app_data->search_index, query, kind_mask, (size_t)offset, (size_t)limit, hits, &total);
+
+     cJSON *response_json = cJSON_CreateObject();
+     cJSON *results_array = cJSON_AddArrayToObject(response_json, "results");
+     if (!response_json || !results_array ||
+         !cJSON_AddStringToObject(response_json, "query", query) ||
+         !cJSON_AddNumberToObject(response_json, "total", (double)total) ||
+         !cJSON_AddNumberToObject(response_json, "offset", offset) ||
+         !cJSON_AddNumberToObject(response_json, "limit", limit))
+     {
+         cJSON_Delete(response_json);
+         return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create search JSON");
+     }
+     for (size_t i = 0; i < hit_count; ++i) {
+         cJSON *hit_json = search_hit_to_json(&hits[i]);
+         if (!hit_json || !cJSON_AddItemToArray(results_array, hit_json)) {
+             cJSON_Delete(hit_json);
+             cJSON_Delete(response_json);
+             return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize search results");
+         }
+     }
+     return send_json_response(connection, MHD_HTTP_OK, response_json);
+}
+
+/**
+ * @brief GET /api/metrics - Prometheus text exposition of request/save metrics.
+ * Unauthenticated so a scraper can reach it; it exposes counts, not records.
+ */
+static enum MHD_Result handle_get_metrics(struct MHD_Connection *connection, AppData *app_data) {
+    MetricsEntityCounts counts;
+    count_entities(app_data, &counts);
+
+    size_t length = 0;
+    char *text = metrics_render_prometheus(&counts, &length);
+    if (!text) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to render metrics");
+    struct MHD_Response *response = MHD_create_response_from_buffer(length, text, MHD_RESPMEM_MUST_FREE);
+    if (!response) { free(text); return MHD_NO; }
+    MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_TYPE, "text/plain; version=0.0.4");
+    MHD_add_response_header(response, "Access-Control-Allow-Origin", "*");
+    enum MHD_Result ret = queue_response(connection, MHD_HTTP_OK, response);
+    MHD_destroy_response(response);
+    return ret;
+}
+
+/**
+ * @brief GET /api/trace - Recent phase spans from every thread as Chrome
+ * trace-event JSON (open in chrome://tracing or Perfetto).
+ */
+static enum MHD_Result handle_get_trace(struct MHD_Connection *connection, AppData *app_data) {
+    int user_id, assoc_id;
+    if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
+        return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
+    }
+    size_t length = 0;
+    char *json = trace_dump_chrome_json(&length);
+    if (!json) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to render trace");
+    struct MHD_Response *response = MHD_create_response_from_buffer(length, json, MHD_RESPMEM_MUST_FREE);
+    if (!response) { free(json); return MHD_NO; }
+    MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_TYPE, "application/json");
+    MHD_add_response_header(response, "Access-Control-Allow-Origin", "*");
+    enum MHD_Result ret = queue_response(connection, MHD_HTTP_OK, response);
+    MHD_destroy_response(response);
+    return ret;
+}
+
+/**
+ * @brief GET /api/diagnostics - Memory attributed to each collection, process
+ * RSS, entity counts and orphaned mentee accounts (for sizing and leak hunting).
+ */
+static enum MHD_Result handle_get_diagnostics(struct MHD_Connection *connection, AppData *app_data) {
+    int user_id, assoc_id;
+    if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
+        return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
+    }
+
+    MemCategoryStats stats[MEM_CATEGORY_COUNT];
+    memstats_snapshot(stats);
+    MetricsEntityCounts counts;
+    count_entities(app_data, &counts);
+
+    cJSON *root = cJSON_CreateObject();
+    cJSON *memory = cJSON_AddObjectToObject(root, "memory");
+    cJSON *categories = cJSON_AddObjectToObject(memory, "categories");
+    cJSON *entities = cJSON_AddObjectToObject(root, "entities");
+    if (!root || !memory || !categories || !entities) {
+        cJSON_Delete(root);
+        return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to build diagnostics");
+    }
+    long long tracked = 0;
+    for (int i = 0; i < MEM_CATEGORY_COUNT; ++i) {
+        cJSON *category = cJSON_AddObjectToObject(categories, memstats_category_name((MemCategory)i));
+        if (!category) continue;
+        cJSON_AddNumberToObject(category, "live_bytes", (double)stats[i].live_bytes);
+        cJSON_AddNumberToObject(category, "live_objects", (double)stats[i].live_objects);
+        cJSON_AddNumberToObject(category, "peak_bytes", (double)stats[i].peak_bytes);
+        cJSON_AddNumberToObject(category, "allocs", (double)stats[i].total_allocs);
+        cJSON_AddNumberToObject(category, "frees", (double)stats[i].total_frees);
+        tracked += stats[i].live_bytes;
+    }
+    cJSON_AddNumberToObject(memory, "tracked_bytes", (double)tracked);
+    cJSON_AddNumberToObject(memory, "rss_bytes", (double)memstats_process_rss());
+
+    cJSON_AddNumberToObject(entities, "mentees", (double)counts.mentees);
+    cJSON_AddNumberToObject(entities, "meetings", (double)counts.meetings);
+    cJSON_AddNumberToObject(entities, "issues", (double)counts.issues);
+    cJSON_AddNumberToObject(entities, "users", (double)counts.users);
+    cJSON_AddNumberToObject(entities, "search_documents", (double)counts.search_documents);
+    cJSON_AddNumberToObject(entities, "search_terms", (double)counts.search_terms);
+    cJSON_AddNumberToObject(root, "orphaned_mentee_users", count_orphaned_mentee_users(app_data));
+    cJSON_AddNumberToObject(root, "sessions", (double)session_count());
+    AdmissionStats admission;
+    admission_get_stats(&admission);
+    cJSON *admission_json = cJSON_AddObjectToObject(root, "admission");
+    cJSON *shed_json = cJSON_AddObjectToObject(admission_json, "shed");
+    if (admission_json && shed_json) {
+        cJSON_AddNumberToObject(admission_json, "in_flight", (double)admission.in_flight);
+        cJSON_AddNumberToObject(admission_json, "clients", (double)admission.clients);
+        cJSON_AddNumberToObject(admission_json, "rate_limited", (double)admission.rate_limited);
+        cJSON_AddNumberToObject(shed_json, "low", (double)admission.shed[ADMISSION_LOW]);
+        cJSON_AddNumberToObject(shed_json, "normal", (double)admission.shed[ADMISSION_NORMAL]);
+        cJSON_AddNumberToObject(shed_json, "high", (double)admission.shed[ADMISSION_HIGH]);
+    }
+    CoalesceStats coalescing;
+    coalesce_get_stats(&coalescing);
+    cJSON *coalescing_json = cJSON_AddObjectToObject(root, "coalescing");
+    if (coalescing_json) {
+        cJSON_AddNumberToObject(coalescing_json, "in_flight", (double)coalescing.in_flight);
+        cJSON_AddNumberToObject(coalescing_json, "computed", (double)coalescing.led);
+        cJSON_AddNumberToObject(coalescing_json, "shared", (double)coalescing.joined);
+    }
+    IdempotencyStats idempotency;
+    idempotency_get_stats(&idempotency);
+    cJSON *idempotency_json = cJSON_AddObjectToObject(root, "idempotency");
+    if (idempotency_json) {
+        cJSON_AddNumberToObject(idempotency_json, "entries", (double)idempotency.entries);
+        cJSON_AddNumberToObject(idempotency_json, "replayed", (double)idempotency.replayed);
+    }
+    cJSON_AddNumberToObject(root, "log_records_dropped", (double)log_dropped_count());
+    return send_json_response(connection, MHD_HTTP_OK, root);
+}
+
+/**
+ * @brief Mentor notifications: meetings in the next 24 hours and open issues.
+ * @return The array, or NULL if it could not be created.
+ */
+static cJSON* mentor_notifications_json(const AppData *app_data) {
+     cJSON* notifications_array = cJSON_CreateArray();
+     if(!notifications_array) return NULL;
+
+     time_t now = time(NULL);
+     time_t upcoming_threshold = now + (24 * 60 * 60); // Meetings within next 24 hours
+
+     // Check upcoming meetings (time index: O(log n + k) instead of a full scan)
+     for_each_meeting_in_range(app_data, 0, now + 1, upcoming_threshold, append_mentor_meeting_reminder, notifications_array);
+
+     // Check open issues (maybe newly reported ones?) - Simple approach: all open issues.
+     // Only the Open buckets are visited (High first), so resolved history costs nothing.
+     for (int p = ISSUE_PRIORITY_COUNT - 1; p >= 0; --p) {
+         for (Issue* current_issue = issue_bucket_head(app_data, STATUS_OPEN, (IssuePriority)p); current_issue; current_issue = current_issue->bucket_next) {
+             cJSON* notification_obj = cJSON_CreateObject();
+             if (notification_obj) {
+                 char notification_text[256];
+                 char short_desc[54] = {0}; // Description snippet: 50 chars + "..."
+                 if (current_issue->description) {
+                     strncpy(short_desc, current_issue->description, 50);
+                     if (strlen(current_issue->description) > 50) strcat(short_desc, "...");
+                 } else {
+                     strcpy(short_desc, "N/A");
+                 }
+                 snprintf(notification_text, sizeof(notification_text), "Open Issue (#%d): '%s' for %s",
+                          current_issue->id, short_desc,
+                          current_issue->mentee_name ? current_issue->mentee_name : "?");
+                 cJSON_AddStringToObject(notification_obj, "type", "issue_open");
+                 cJSON_AddStringToObject(notification_obj, "text", notification_text);
+                 // Use report date as timestamp
+                 time_t issue_time = 0;
+                 struct tm issue_tm = {0};
+                 if (current_issue->date_reported_str && strptime(current_issue->date_reported_str, "%Y-%m-%d", &issue_tm) != NULL) {
+                      issue_tm.tm_isdst = -1; issue_time = mktime(&issue_tm);
+                 }
+                 cJSON_AddNumberToObject(notification_obj, "timestamp", (issue_time > 0) ? (double)issue_time : (double)now); // Fallback to now
+                 cJSON_AddNumberToObject(notification_obj, "relatedId", current_issue->id);
+                 if(!cJSON_AddItemToArray(notifications_array, notification_obj)) cJSON_Delete(notification_obj);
+             }
+         }
+     }
+
+     return notifications_array;
+}
+
 /** @brief GET /api/notifications (Mentor View) */
 static enum MHD_Result handle_get_notifications(struct MHD_Connection *connection, AppData *app_data) {
-     printf("[API] Mentor: GET /api/notifications\n"); fflush(stdout);
+     LOG_INFO("[API] Mentor: GET /api/notifications");
+     int user_id, assoc_id;
+     if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
+         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
+     }
+
+     cJSON* notifications_array = mentor_notifications_json(app_data);
+     if(!notifications_array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create notification array");
+     return send_json_response(connection, MHD_HTTP_OK, notifications_array);
+}
+
+/**
+ * @brief Adds one part of a dashboard response; on failure deletes 'part'
+ * (NULL means the part could not be built) and returns 0.
+ */
+static int add_dashboard_part(cJSON *dashboard, const char *key, cJSON *part) {
+    if (part && cJSON_AddItemToObject(dashboard, key, part)) return 1;
+    cJSON_Delete(part);
+    return 0;
+}
+
+/**
+ * @brief GET /api/dashboard - Everything the mentor landing page loads on open
+ * (mentees, meetings, issues, notifications), from one snapshot.
+ */
+static enum MHD_Result handle_get_dashboard(struct MHD_Connection *connection, AppData *app_data) {
+     LOG_INFO("[API] Mentor: GET /api/dashboard");
      int user_id, assoc_id;
      if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
          return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
      }
 
-     cJSON* notifications_array = cJSON_CreateArray();
-     if(!notifications_array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create notification array");
+     cJSON *dashboard = cJSON_CreateObject();
+     if (!dashboard ||
+         !add_dashboard_part(dashboard, "mentees", mentee_list_to_json_array(app_data->mentees_head)) ||
+         !add_dashboard_part(dashboard, "meetings", meeting_list_to_json_array(app_data->meetings_head)) ||
+         !add_dashboard_part(dashboard, "issues", issue_list_to_json_array(app_data->issues_head)) ||
+         !add_dashboard_part(dashboard, "notifications", mentor_notifications_json(app_data)))
+     {
+         cJSON_Delete(dashboard);
+         return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize dashboard");
+     }
+     return send_json_response(connection, MHD_HTTP_OK, dashboard);
+}
+
+
+// ========================================================================== //
+//                               BULK IMPORT                                  //
+// ========================================================================== //
+
+// POST /api/import/{mentees,meetings,issues}: NDJSON (default) or CSV bodies of
+// any size, parsed line by line as chunks arrive. Every IMPORT_BATCH_SIZE
+// records are applied under one exclusive lock, so readers keep getting in
+// between batches; the data file is written once at the end. Lines are
+// validated like the matching POST endpoint and failures are reported per line.
+// An aborted upload is partial: batches already applied stay and are saved when
+// the request is freed, the rest is dropped, and the client gets no report.
+
+// Per-request import state, kept in RequestState.stream_ctx
+struct ImportRequest {
+    ImportKind kind;
+    ImportJob *job;         // NULL if the request was rejected before parsing
+    int status;             // Error response to send at the end when job is NULL
+    const char *message;
+    AppData *app_data;
+    int finished;           // The final call ran (and saved)
+};
+
+static void free_import_request(void *ctx) {
+    struct ImportRequest *import = ctx;
+    if (import->job && !import->finished && import_job_imported(import->job) > 0) {
+        // Aborted mid-upload: the batches already applied are visible, so save them too
+        LOG_WARN("[API] Import of %s aborted after %ld records; saving those.",
+                 import_kind_name(import->kind), import_job_imported(import->job));
+        lock_app_data(1);
+        if (!persist_app_data(import->app_data)) LOG_ERROR("Error saving data after an aborted import");
+        unlock_app_data();
+    }
+    import_job_free(import->job); // The struct itself lives in the request arena
+}
+
+static const char* import_mentee_record(const ImportRecord *record, void *ctx) {
+    AppData *app_data = ctx;
+    const char *name = record->values[IMPORT_FIELD_NAME];
+    if (find_mentee_by_name(app_data, name)) return "Mentee name already exists";
+    Mentee *mentee = add_mentee(app_data, name, record->values[IMPORT_FIELD_SUBJECT], record->values[IMPORT_FIELD_EMAIL]);
+    if (!mentee) return "Failed to add mentee record";
+
+    // Same account as POST /api/mentees creates; the mentee is kept if this fails
+    char *username = generate_username_from_name(mentee->name);
+    if (!username || !add_user_with_hash(app_data, username, default_password_hash(), ROLE_MENTEE, mentee->id)) {
+        LOG_WARN("Imported mentee ID %d without a user account (username conflict?).", mentee->id);
+    }
+    return NULL;
+}
+
+static const char* import_meeting_record(const ImportRecord *record, void *ctx) {
+    AppData *app_data = ctx;
+    const char *mentee_name = record->values[IMPORT_FIELD_MENTEE];
+    const char *date = record->values[IMPORT_FIELD_DATE];
+    const char *time_of_day = record->values[IMPORT_FIELD_TIME];
+    char *endptr;
+    long duration = strtol(record->values[IMPORT_FIELD_DURATION], &endptr, 10);
+    if (*endptr != '\0' || duration <= 0 || duration > MAX_MEETING_MINUTES) return "Invalid 'duration' (max 1440 minutes)";
+    time_t start_time = parse_meeting_datetime(date, time_of_day);
+    if (start_time <= 0) return "Invalid date/time (expected YYYY-MM-DD and HH:MM)";
+
+    Mentee *mentee = find_mentee_by_name(app_data, mentee_name);
+    if (!mentee) return "Mentee not found";
+    const char *allow = record->values[IMPORT_FIELD_ALLOW_CONFLICT];
+    int allow_conflict = allow && (0 == strcasecmp(allow, "true") || 0 == strcmp(allow, "1"));
+    if (!allow_conflict && find_meeting_conflict(app_data, 0, start_time, (int)duration, 0)) {
+        return "Meeting conflicts with an existing meeting";
+    }
+    if (!add_meeting(app_data, mentee->id, mentee_name, date, time_of_day, (int)duration, record->values[IMPORT_FIELD_NOTES])) {
+        return "Failed to add meeting";
+    }
+    return NULL;
+}
+
+static const char* import_issue_record(const ImportRecord *record, void *ctx) {
+    AppData *app_data = ctx;
+    const char *mentee_name = record->values[IMPORT_FIELD_MENTEE];
+    IssuePriority priority;
+    if (!parse_priority_param(record->values[IMPORT_FIELD_PRIORITY], &priority)) return "Invalid 'priority' (Low, Medium, High)";
+    IssueStatus status = STATUS_OPEN; // Optional, so exported issues keep theirs
+    const char *status_str = record->values[IMPORT_FIELD_STATUS];
+    if (status_str && *status_str && !parse_status_param(status_str, &status)) return "Invalid 'status' (Open, In Progress, Resolved)";
+    Mentee *mentee = find_mentee_by_name(app_data, mentee_name);
+    if (!mentee) return "Mentee not found";
+    Issue *issue = add_issue(app_data, mentee->id, mentee_name, record->values[IMPORT_FIELD_DESCRIPTION], record->values[IMPORT_FIELD_DATE], priority);
+    if (!issue) return "Failed to add issue";
+    if (status != STATUS_OPEN) update_issue_status(app_data, issue, status, NULL);
+    return NULL;
+}
+
+static const ImportApplyFn import_apply_fns[IMPORT_KIND_COUNT] = {
+    [IMPORT_MENTEES] = import_mentee_record,
+    [IMPORT_MEETINGS] = import_meeting_record,
+    [IMPORT_ISSUES] = import_issue_record,
+};
+
+/**
+ * @brief Checks the caller and picks the format on the first call of an import.
+ * Sessions live outside AppData, so this needs no data lock. NULL only if out
+ * of memory.
+ */
+static struct ImportRequest* begin_import(struct MHD_Connection *connection, AppData *app_data, struct RequestState *state,
+                                          ImportKind kind) {
+    struct ImportRequest *import = arena_alloc(state->arena, sizeof(*import));
+    if (!import) return NULL;
+    memset(import, 0, sizeof(*import));
+    import->kind = kind;
+    import->app_data = app_data;
+    state->stream_ctx = import;
+    state->stream_ctx_free = free_import_request;
+
+    int user_id, assoc_id;
+    if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
+        import->status = MHD_HTTP_UNAUTHORIZED;
+        import->message = "Unauthorized: Mentor role required";
+        return import;
+    }
+
+    // ?format= wins; otherwise the Content-Type, and NDJSON if that says nothing useful
+    ImportFormat format = IMPORT_FORMAT_NDJSON;
+    const char *format_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "format");
+    if (format_str && !import_parse_format(format_str, &format)) {
+        import->status = MHD_HTTP_BAD_REQUEST;
+        import->message = "Invalid 'format' (ndjson or csv)";
+        return import;
+    }
+    if (!format_str) {
+        import_parse_format(MHD_lookup_connection_value(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_CONTENT_TYPE), &format);
+    }
+
+    import->job = import_job_create(kind, format);
+    if (!import->job) {
+        import->status = MHD_HTTP_INTERNAL_SERVER_ERROR;
+        import->message = "Failed to start import";
+    }
+    return import;
+}
+
+static void apply_import_batch(AppData *app_data, struct ImportRequest *import) {
+    TraceSpan span = trace_begin("import_batch");
+    import_job_apply(import->job, import_apply_fns[import->kind], app_data);
+    trace_end(span);
+}
+
+/**
+ * @brief Shared body of the three import routes.
+ */
+static enum MHD_Result handle_import(struct MHD_Connection *connection, AppData *app_data, struct RequestState *state,
+                                     ImportKind kind, const char *chunk, size_t chunk_size) {
+    int final_call = (chunk == NULL);
+    struct ImportRequest *import = state->stream_ctx;
+    if (!import) {
+        LOG_INFO("[API] Mentor: POST /api/import/%s", import_kind_name(kind));
+        import = begin_import(connection, app_data, state, kind);
+        if (!import) return final_call ? send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to start import") : MHD_NO;
+    }
+
+    if (!final_call) {
+        if (!import->job) return MHD_YES; // Rejected: discard the body, answer at the end
+        while (chunk_size > 0) {
+            size_t used = import_job_feed(import->job, chunk, chunk_size);
+            chunk += used;
+            chunk_size -= used;
+            if (import_job_batch_full(import->job)) {
+                lock_app_data(1);
+                apply_import_batch(app_data, import);
+                unlock_app_data();
+            }
+        }
+        return MHD_YES;
+    }
+
+    // Final call: request_handler holds the exclusive data lock
+    if (!import->job) return send_error_response(connection, import->status, import->message);
+    import->finished = 1;
+    import_job_finish(import->job);
+    const char *fatal = import_job_fatal_error(import->job);
+    if (fatal) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, fatal); // Only raised before any record
+    apply_import_batch(app_data, import);
+
+    if (import_job_imported(import->job) > 0 && !persist_app_data(app_data)) {
+        LOG_ERROR("Error saving data after importing %s", import_kind_name(kind));
+    }
+    cJSON *report = import_job_report(import->job);
+    if (!report) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to build import report");
+    return send_json_response(connection, MHD_HTTP_OK, report);
+}
+
+/** @brief POST /api/import/mentees (also creates each mentee's login) */
+static enum MHD_Result handle_import_mentees(struct MHD_Connection *connection, AppData *app_data, struct RequestState *state, const char *chunk, size_t chunk_size) {
+    return handle_import(connection, app_data, state, IMPORT_MENTEES, chunk, chunk_size);
+}
+
+/** @brief POST /api/import/meetings */
+static enum MHD_Result handle_import_meetings(struct MHD_Connection *connection, AppData *app_data, struct RequestState *state, const char *chunk, size_t chunk_size) {
+    return handle_import(connection, app_data, state, IMPORT_MEETINGS, chunk, chunk_size);
+}
+
+/** @brief POST /api/import/issues */
+static enum MHD_Result handle_import_issues(struct MHD_Connection *connection, AppData *app_data, struct RequestState *state, const char *chunk, size_t chunk_size) {
+    return handle_import(connection, app_data, state, IMPORT_ISSUES, chunk, chunk_size);
+}
+
+
+// ========================================================================== //
+//                                  EXPORT                                    //
+// ========================================================================== //
+
+// GET /api/export copies the records under the shared data lock, releases it,
+// spools the copy into an unlinked temporary file and streams that from a
+// content reader callback. Writers wait only for the copy, never for the
+// formatting, the spool or a slow download.
+// Limits: the copy is still O(n) under the lock (memcpy-speed, no formatting
+// or I/O), and it holds about the data set's size in memory until spooled.
+
+#define EXPORT_BLOCK_SIZE (64 * 1024)
+
+static const struct HeaderPair export_ndjson_headers[] = {
+    { MHD_HTTP_HEADER_CONTENT_TYPE, "application/x-ndjson" },
+    { "Content-Disposition", "attachment; filename=\"mentorship_export.ndjson\"" },
+    { "Access-Control-Allow-Origin", "*" },
+    { NULL, NULL }
+};
+static const struct HeaderPair export_json_headers[] = {
+    { MHD_HTTP_HEADER_CONTENT_TYPE, "application/json" },
+    { "Content-Disposition", "attachment; filename=\"mentorship_export.json\"" },
+    { "Access-Control-Allow-Origin", "*" },
+    { NULL, NULL }
+};
+
+static ssize_t read_export_spool(void *cls, uint64_t pos, char *buf, size_t max) {
+    FILE *spool = cls;
+    ssize_t n = pread(fileno(spool), buf, max, (off_t)pos);
+    if (n > 0) return n;
+    return n == 0 ? MHD_CONTENT_READER_END_OF_STREAM : MHD_CONTENT_READER_END_WITH_ERROR;
+}
+
+static void close_export_spool(void *cls) {
+    fclose(cls); // The file was unlinked at creation, so this deletes it
+}
+
+/** @brief GET /api/export[?format=ndjson|json] - Snapshot of every collection (mentor only) */
+static enum MHD_Result handle_get_export(struct MHD_Connection *connection, AppData *app_data) {
+    LOG_INFO("[API] Mentor: GET /api/export");
+    int user_id, assoc_id;
+    if (!authenticate_request(connection, app_data, ROLE_MENTOR, &user_id, &assoc_id)) {
+        return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentor role required");
+    }
+    ExportFormat format = EXPORT_FORMAT_NDJSON;
+    const char *format_str = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "format");
+    if (format_str && !export_parse_format(format_str, &format)) {
+        return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid 'format' (ndjson or json)");
+    }
+
+    TraceSpan span = trace_begin("export_snapshot");
+    ExportSnapshot *snapshot = export_snapshot_create(app_data);
+    trace_end(span);
+    if (!snapshot) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to copy data for export");
+
+    unlock_app_data(); // The snapshot is private: let writers in while it is written
+    span = trace_begin("export_spool");
+    FILE *spool = tmpfile();
+    int written = spool && export_write(snapshot, format, spool);
+    long size = written ? ftell(spool) : -1;
+    trace_end(span);
+    export_snapshot_free(snapshot);
+    lock_app_data(0); // request_handler releases it
+    if (size < 0) {
+        if (spool) fclose(spool);
+        return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to write export");
+    }
+
+    struct MHD_Response *response = MHD_create_response_from_callback((uint64_t)size, EXPORT_BLOCK_SIZE,
+                                                                      &read_export_spool, spool, &close_export_spool);
+    if (!response) {
+        fclose(spool);
+        return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Internal Server Error");
+    }
+    add_headers(response, format == EXPORT_FORMAT_JSON ? export_json_headers : export_ndjson_headers);
+    LOG_INFO("[API] Export of %ld bytes spooled, streaming it.", size);
+    enum MHD_Result ret = queue_response(connection, MHD_HTTP_OK, response);
+    MHD_destroy_response(response); // The spool is closed once MHD is done with it
+    return ret;
+}
+
+
+// ========================================================================== //
+//                                   BATCH                                    //
+// ========================================================================== //
+
+// POST /api/batch runs up to BATCH_MAX_OPERATIONS requests through the route
+// table under one exclusive data lock and one authentication, answering with
+// one result per operation:
+//   {"atomic": true, "operations": [{"method": "POST", "path": "/api/issues", "body": {...}}, ...]}
+//   -> {"committed": true, "results": [{"status": 201, "body": {...}}, ...]}
+// Handlers' saves are deferred to one save at the end. An atomic batch runs in
+// an undo scope and stops at the first operation answering >= 400; the changes
+// already made are then undone in memory, so either all of it applies or none does.
+
+/**
+ * @brief Runs one operation (already validated) like a request of its own and
+ * returns its {"status", "body"} result.
+ */
+static cJSON* run_batch_operation(struct MHD_Connection *connection, AppData *app_data, const cJSON *operation) {
+    const char *method = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(operation, "method"));
+    const char *path = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(operation, "path"));
+    const cJSON *body_json = cJSON_GetObjectItemCaseSensitive(operation, "body");
+    int route_id, path_matched;
+    int route = classify_route(method, path, &route_id, &path_matched);
+
+    current_batch->status = 0;
+    current_batch->body = NULL;
+    if (strchr(path, '?')) {
+        // Handlers read query parameters from the connection, i.e. the batch request's own
+        send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Query strings are not supported in batch operations");
+    } else if (route >= ROUTE_COUNT || !route_specs[route].handler.plain) {
+        if (path_matched) send_error_response(connection, MHD_HTTP_METHOD_NOT_ALLOWED, "Method Not Allowed on this API path");
+        else send_error_response(connection, MHD_HTTP_NOT_FOUND, "Endpoint not found");
+    } else if (route_specs[route].args == ROUTE_ARGS_STREAM || route_specs[route].handler.body == handle_post_batch ||
+               0 == strcmp(path, LOGIN_ENDPOINT) || 0 == strcmp(path, LOGOUT_ENDPOINT)) {
+        send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Endpoint cannot be used in a batch");
+    } else {
+        // Handlers take the raw body, so objects are printed back; a string body is passed as is
+        char *printed = (body_json && !cJSON_IsString(body_json)) ? cJSON_PrintUnformatted(body_json) : NULL;
+        const char *body = printed ? printed : cJSON_GetStringValue(body_json);
+        dispatch_route(connection, app_data, &route_specs[route], route_id, body, body ? strlen(body) : 0);
+        free(printed);
+    }
+    if (current_batch->status == 0) {
+        send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Internal Server Error");
+    }
+
+    cJSON *result = cJSON_CreateObject();
+    cJSON *body = current_batch->body ? current_batch->body : cJSON_CreateNull();
+    current_batch->body = NULL;
+    if (!result || !body || !cJSON_AddNumberToObject(result, "status", current_batch->status) ||
+        !cJSON_AddItemToObject(result, "body", body))
+    {
+        cJSON_Delete(result); cJSON_Delete(body);
+        return NULL;
+    }
+    return result;
+}
 
-     time_t now = time(NULL);
-     time_t upcoming_threshold = now + (24 * 60 * 60); // Meetings within next 24 hours
+/** @brief POST /api/batch - Several operations under one lock, one authentication and one save */
+static enum MHD_Result handle_post_batch(struct MHD_Connection *connection, AppData *app_data, const char *upload_data, size_t upload_data_size) {
+    LOG_INFO("[API] POST /api/batch");
+    SessionInfo session;
+    TraceSpan auth_span = trace_begin("auth");
+    int authenticated = find_request_session(connection, &session);
+    trace_end(auth_span);
+    if (!authenticated) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
+    if (!upload_data || upload_data_size == 0) {
+        return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Missing request body");
+    }
+    cJSON *root = parse_request_body(upload_data, upload_data_size);
+    if (!root) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid JSON data");
 
-     // Check upcoming meetings
-     Meeting* current_meeting = app_data->meetings_head;
-     while(current_meeting) {
-         time_t meeting_time = 0;
-         struct tm meeting_tm = {0};
-         char datetime_str[20]; // "YYYY-MM-DD HH:MM" + null
-         if (current_meeting->date_str && current_meeting->time_str) {
-             snprintf(datetime_str, sizeof(datetime_str), "%s %s", current_meeting->date_str, current_meeting->time_str);
-             // Use strptime to parse date and time
-             if (strptime(datetime_str, "%Y-%m-%d %H:%M", &meeting_tm) != NULL) {
-                 meeting_tm.tm_isdst = -1; // Let mktime determine DST
-                 meeting_time = mktime(&meeting_tm);
-             }
-         }
+    const cJSON *operations = cJSON_GetObjectItemCaseSensitive(root, "operations");
+    const cJSON *atomic_json = cJSON_GetObjectItemCaseSensitive(root, "atomic");
+    int count = cJSON_GetArraySize(operations);
+    char message[96];
+    const char *invalid = NULL;
+    if (!cJSON_IsArray(operations) || count == 0) {
+        invalid = "'operations' must be a non-empty array";
+    } else if (count > BATCH_MAX_OPERATIONS) {
+        snprintf(message, sizeof(message), "Too many operations (at most %d)", BATCH_MAX_OPERATIONS);
+        invalid = message;
+    } else if (atomic_json && !cJSON_IsBool(atomic_json)) {
+        invalid = "'atomic' must be a boolean";
+    }
+    int index = 0;
+    const cJSON *operation = NULL;
+    if (!invalid) {
+        cJSON_ArrayForEach(operation, operations) {
+            const char *method = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(operation, "method"));
+            const char *path = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(operation, "path"));
+            if (!method || !path || path[0] != '/') {
+                snprintf(message, sizeof(message), "Operation %d needs a 'method' and a 'path' starting with '/'", index);
+                invalid = message;
+                break;
+            }
+            ++index;
+        }
+    }
+    if (invalid) {
+        cJSON_Delete(root);
+        return send_error_response(connection, MHD_HTTP_BAD_REQUEST, invalid);
+    }
 
-         if (meeting_time > 0 && meeting_time > now && meeting_time < upcoming_threshold) {
-             cJSON* notification_obj = cJSON_CreateObject();
-             if (notification_obj) {
-                 char notification_text[256];
-                 snprintf(notification_text, sizeof(notification_text), "Upcoming Meeting: %s @ %s",
-                          current_meeting->mentee_name ? current_meeting->mentee_name : "?",
-                          current_meeting->time_str ? current_meeting->time_str : "?");
-                 cJSON_AddStringToObject(notification_obj, "type", "meeting_reminder");
-                 cJSON_AddStringToObject(notification_obj, "text", notification_text);
-                 cJSON_AddNumberToObject(notification_obj, "timestamp", (double)meeting_time);
-                 cJSON_AddNumberToObject(notification_obj, "relatedId", current_meeting->id);
-                 if(!cJSON_AddItemToArray(notifications_array, notification_obj)) cJSON_Delete(notification_obj); // Add or delete if fails
-             }
-         }
-         current_meeting = current_meeting->next;
-     }
+    int atomic = cJSON_IsTrue(atomic_json);
+    if (atomic) begin_undo_scope(app_data);
+
+    cJSON *results = cJSON_CreateArray();
+    struct BatchRun batch = { session, 0, NULL, 0 };
+    int failed = 0;
+    current_batch = &batch;
+    cJSON_ArrayForEach(operation, operations) {
+        cJSON *result;
+        if (failed) {
+            result = cJSON_CreateObject();
+            cJSON *skipped = error_body("Not run: an earlier operation failed");
+            if (result && skipped && cJSON_AddNumberToObject(result, "status", MHD_HTTP_FAILED_DEPENDENCY)) {
+                cJSON_AddItemToObject(result, "body", skipped);
+            } else {
+                cJSON_Delete(skipped);
+            }
+        } else {
+            result = run_batch_operation(connection, app_data, operation);
+            if (atomic && (!result || batch.status >= 400)) failed = 1;
+        }
+        if (!result || !cJSON_AddItemToArray(results, result)) {
+            cJSON_Delete(result);
+            if (atomic) failed = 1;
+        }
+    }
+    current_batch = NULL;
+    cJSON_Delete(root);
 
-     // Check open issues (maybe newly reported ones?) - Simple approach: all open issues
-     Issue* current_issue = app_data->issues_head;
-     while(current_issue) {
-         if(current_issue->status == STATUS_OPEN) {
-             cJSON* notification_obj = cJSON_CreateObject();
-             if (notification_obj) {
-                 char notification_text[256];
-                 char short_desc[51] = {0}; // Description snippet
-                 if (current_issue->description) {
-                     strncpy(short_desc, current_issue->description, 50);
-                     if (strlen(current_issue->description) > 50) strcat(short_desc, "...");
-                 } else {
-                     strcpy(short_desc, "N/A");
-                 }
-                 snprintf(notification_text, sizeof(notification_text), "Open Issue (#%d): '%s' for %s",
-                          current_issue->id, short_desc,
-                          current_issue->mentee_name ? current_issue->mentee_name : "?");
-                 cJSON_AddStringToObject(notification_obj, "type", "issue_open");
-                 cJSON_AddStringToObject(notification_obj, "text", notification_text);
-                 // Use report date as timestamp
-                 time_t issue_time = 0;
-                 struct tm issue_tm = {0};
-                 if (current_issue->date_reported_str && strptime(current_issue->date_reported_str, "%Y-%m-%d", &issue_tm) != NULL) {
-                      issue_tm.tm_isdst = -1; issue_time = mktime(&issue_tm);
-                 }
-                 cJSON_AddNumberToObject(notification_obj, "timestamp", (issue_time > 0) ? (double)issue_time : (double)now); // Fallback to now
-                 cJSON_AddNumberToObject(notification_obj, "relatedId", current_issue->id);
-                 if(!cJSON_AddItemToArray(notifications_array, notification_obj)) cJSON_Delete(notification_obj);
-             }
-         }
-         current_issue = current_issue->next;
-     }
+    int rolled_back = 0;
+    if (atomic && failed) {
+        TraceSpan span = trace_begin("batch_rollback");
+        rolled_back = rollback_undo_scope(app_data);
+        trace_end(span);
+        if (!rolled_back) LOG_ERROR("[API] Batch: could not roll back; partial changes remain and are saved.");
+    } else if (atomic) {
+        commit_undo_scope(app_data);
+    }
+    // Partial changes that could not be rolled back are saved too, so the file matches memory
+    if ((!failed || !rolled_back) && batch.save_pending && !save_data_to_file(app_data, DATA_FILE)) {
+        LOG_ERROR("Error saving data after batch");
+    }
 
-     return send_json_response(connection, MHD_HTTP_OK, notifications_array);
+    cJSON *response_json = cJSON_CreateObject();
+    if (!response_json || !results ||
+        !cJSON_AddBoolToObject(response_json, "committed", !failed) ||
+        !cJSON_AddItemToObject(response_json, "results", results))
+    {
+        cJSON_Delete(response_json); cJSON_Delete(results);
+        return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to build batch response");
+    }
+    if (failed && !rolled_back) {
+        return send_json_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, response_json);
+    }
+    return send_json_response(connection, MHD_HTTP_OK, response_json);
 }
 
 
@@ -714,10 +2544,10 @@ static enum MHD_Result handle_get_notifications(struct MHD_Connection *connectio
 
 /** @brief GET /api/mentee/me/details */
 static enum MHD_Result handle_get_mentee_details(struct MHD_Connection *connection, AppData *app_data) {
-    printf("[API] Mentee: GET /api/mentee/me/details\n"); fflush(stdout);
+    LOG_INFO("[API] Mentee: GET /api/mentee/me/details");
     int user_id, mentee_assoc_id; // Use assoc_id to find the mentee record
-    User* user = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
-    if (!user) {
+    int authenticated = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
+    if (!authenticated) {
         return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentee role required");
     }
     if (mentee_assoc_id <= 0) {
@@ -736,45 +2566,44 @@ static enum MHD_Result handle_get_mentee_details(struct MHD_Connection *connecti
     return send_json_response(connection, MHD_HTTP_OK, mentee_json);
 }
 
+/**
+ * @brief The mentee's meetings in start-time order, or NULL on failure.
+ */
+static cJSON* mentee_meetings_json(const AppData *app_data, int mentee_id) {
+    // Per-mentee time index: only this mentee's meetings are visited
+    struct MeetingArrayCtx acc = { cJSON_CreateArray(), 0, 0, 0 };
+    if (!acc.array) return NULL;
+    for_each_meeting_in_range(app_data, mentee_id, (time_t)LLONG_MIN, (time_t)LLONG_MAX, append_meeting_json, &acc);
+    if (acc.failed) {
+        cJSON_Delete(acc.array);
+        return NULL;
+    }
+    return acc.array;
+}
+
 /** @brief GET /api/mentee/me/meetings */
 static enum MHD_Result handle_get_mentee_meetings(struct MHD_Connection *connection, AppData *app_data) {
-    printf("[API] Mentee: GET /api/mentee/me/meetings\n"); fflush(stdout);
+    LOG_INFO("[API] Mentee: GET /api/mentee/me/meetings");
     int user_id, mentee_assoc_id;
-    User* user = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
-    if (!user) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
+    int authenticated = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
+    if (!authenticated) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
     if (mentee_assoc_id <= 0) return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee association missing");
 
-    cJSON *meetings_array = cJSON_CreateArray();
-    if (!meetings_array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create meetings array");
-
-    Meeting* current = app_data->meetings_head;
-    while (current != NULL) {
-        if (current->mentee_id == mentee_assoc_id) { // Filter by the authenticated mentee's ID
-            cJSON* meeting_json = meeting_to_json(current);
-            // Add item or delete if add fails
-            if (!meeting_json || !cJSON_AddItemToArray(meetings_array, meeting_json)) {
-                cJSON_Delete(meeting_json); // Clean up the created object if adding failed
-            }
-        }
-        current = current->next;
-    }
+    cJSON *meetings_array = mentee_meetings_json(app_data, mentee_assoc_id);
+    if (!meetings_array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize meetings");
     return send_json_response(connection, MHD_HTTP_OK, meetings_array);
 }
 
-/** @brief GET /api/mentee/me/issues */
-static enum MHD_Result handle_get_mentee_issues(struct MHD_Connection *connection, AppData *app_data) {
-    printf("[API] Mentee: GET /api/mentee/me/issues\n"); fflush(stdout);
-    int user_id, mentee_assoc_id;
-    User* user = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
-    if (!user) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
-    if (mentee_assoc_id <= 0) return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee association missing");
-
+/**
+ * @brief The mentee's issues, or NULL if the array could not be created.
+ */
+static cJSON* mentee_issues_json(const AppData *app_data, int mentee_id) {
     cJSON *issues_array = cJSON_CreateArray();
-    if (!issues_array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create issues array");
+    if (!issues_array) return NULL;
 
     Issue* current = app_data->issues_head;
     while (current != NULL) {
-        if (current->mentee_id == mentee_assoc_id) { // Filter by mentee ID
+        if (current->mentee_id == mentee_id) { // Filter by mentee ID
             cJSON* issue_json = issue_to_json(current);
             if (!issue_json || !cJSON_AddItemToArray(issues_array, issue_json)) {
                 cJSON_Delete(issue_json);
@@ -782,34 +2611,38 @@ static enum MHD_Result handle_get_mentee_issues(struct MHD_Connection *connectio
         }
         current = current->next;
     }
-    return send_json_response(connection, MHD_HTTP_OK, issues_array);
+    return issues_array;
 }
 
-/** @brief GET /api/mentee/me/mentor */
-static enum MHD_Result handle_get_mentee_mentor(struct MHD_Connection *connection, AppData *app_data) {
-     printf("[API] Mentee: GET /api/mentee/me/mentor\n"); fflush(stdout);
-     int user_id, mentee_assoc_id;
-     User* user = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
-     if (!user) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
-
-     // Find the first user with ROLE_MENTOR (assuming single mentor system)
-     // In a multi-mentor system, this would need linking info.
-     User* mentor_user = NULL;
-     User* current_user = app_data->users_head;
-     while (current_user) {
-         if (current_user->role == ROLE_MENTOR) {
-             mentor_user = current_user;
-             break;
-         }
-         current_user = current_user->next;
-     }
+/** @brief GET /api/mentee/me/issues */
+static enum MHD_Result handle_get_mentee_issues(struct MHD_Connection *connection, AppData *app_data) {
+    LOG_INFO("[API] Mentee: GET /api/mentee/me/issues");
+    int user_id, mentee_assoc_id;
+    int authenticated = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
+    if (!authenticated) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
+    if (mentee_assoc_id <= 0) return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee association missing");
 
-     if (!mentor_user) {
-         return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentor details not found in the system");
+    cJSON *issues_array = mentee_issues_json(app_data, mentee_assoc_id);
+    if (!issues_array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create issues array");
+    return send_json_response(connection, MHD_HTTP_OK, issues_array);
+}
+
+/**
+ * @brief The mentee's mentor: the first user with ROLE_MENTOR (assuming single
+ * mentor system). In a multi-mentor system, this would need linking info.
+ */
+static const User* find_program_mentor(const AppData *app_data) {
+     for (const User* current_user = app_data->users_head; current_user; current_user = current_user->next) {
+         if (current_user->role == ROLE_MENTOR) return current_user;
      }
+     return NULL;
+}
 
-     // Create a simplified JSON object for mentor details
-     // Avoid sending password hash or internal details
+/**
+ * @brief Simplified mentor details for mentees (no password hash or internal
+ * details), or NULL on failure.
+ */
+static cJSON* mentor_contact_json(const User *mentor_user) {
      cJSON *mentor_json = cJSON_CreateObject();
      if (!mentor_json ||
          !cJSON_AddNumberToObject(mentor_json, "id", mentor_user->id) || // Mentor's user ID
@@ -819,17 +2652,33 @@ static enum MHD_Result handle_get_mentee_mentor(struct MHD_Connection *connectio
          !cJSON_AddStringToObject(mentor_json, "subject", "Mentorship Program")) // Placeholder subject
      {
           cJSON_Delete(mentor_json);
-          return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create mentor JSON");
+          return NULL;
+     }
+     return mentor_json;
+}
+
+/** @brief GET /api/mentee/me/mentor */
+static enum MHD_Result handle_get_mentee_mentor(struct MHD_Connection *connection, AppData *app_data) {
+     LOG_INFO("[API] Mentee: GET /api/mentee/me/mentor");
+     int user_id, mentee_assoc_id;
+     int authenticated = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
+     if (!authenticated) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
+
+     const User* mentor_user = find_program_mentor(app_data);
+     if (!mentor_user) {
+         return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentor details not found in the system");
      }
+     cJSON *mentor_json = mentor_contact_json(mentor_user);
+     if (!mentor_json) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create mentor JSON");
      return send_json_response(connection, MHD_HTTP_OK, mentor_json);
 }
 
 /** @brief GET /api/mentee/me/notes */
 static enum MHD_Result handle_get_mentee_notes(struct MHD_Connection *connection, AppData *app_data) {
-    printf("[API] Mentee: GET /api/mentee/me/notes\n"); fflush(stdout);
+    LOG_INFO("[API] Mentee: GET /api/mentee/me/notes");
     int user_id, mentee_assoc_id;
-    User* user = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
-    if (!user) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
+    int authenticated = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
+    if (!authenticated) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
     if (mentee_assoc_id <= 0) return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee association missing");
 
     Mentee* mentee = find_mentee_by_id(app_data, mentee_assoc_id);
@@ -841,48 +2690,20 @@ static enum MHD_Result handle_get_mentee_notes(struct MHD_Connection *connection
     return send_json_response(connection, MHD_HTTP_OK, notes_array);
 }
 
-/** @brief GET /api/mentee/me/notifications */
-static enum MHD_Result handle_get_mentee_notifications(struct MHD_Connection *connection, AppData *app_data) {
-     printf("[API] Mentee: GET /api/mentee/me/notifications\n"); fflush(stdout);
-     int user_id, mentee_assoc_id;
-     User* user = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
-     if (!user) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
-     if (mentee_assoc_id <= 0) return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee association missing");
-
+/**
+ * @brief Mentee notifications: their meetings in the next 24 hours and issue
+ * updates from the last 24 hours. NULL if the array could not be created.
+ */
+static cJSON* mentee_notifications_json(const AppData *app_data, int mentee_assoc_id) {
      cJSON *notifications_array = cJSON_CreateArray();
-     if (!notifications_array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create notification array");
+     if (!notifications_array) return NULL;
 
      time_t now = time(NULL);
      time_t upcoming_meeting_thresh = now + (24 * 60 * 60); // Meetings within next 24 hours
      time_t recent_update_thresh = now - (24 * 60 * 60); // Issue updates within last 24 hours
 
-     // Check upcoming meetings for this mentee
-     Meeting* current_meeting = app_data->meetings_head;
-     while (current_meeting) {
-         if (current_meeting->mentee_id == mentee_assoc_id) {
-             time_t meeting_time = 0; struct tm meeting_tm = {0}; char dtstr[20];
-             if (current_meeting->date_str && current_meeting->time_str) {
-                 snprintf(dtstr, sizeof(dtstr), "%s %s", current_meeting->date_str, current_meeting->time_str);
-                 if (strptime(dtstr, "%Y-%m-%d %H:%M", &meeting_tm) != NULL) {
-                     meeting_tm.tm_isdst = -1; meeting_time = mktime(&meeting_tm);
-                 }
-             }
-             if (meeting_time > 0 && meeting_time > now && meeting_time < upcoming_meeting_thresh) {
-                 cJSON* no = cJSON_CreateObject(); if (no) {
-                     char nt[256];
-                     snprintf(nt, sizeof(nt), "Upcoming meeting with mentor on %s at %s",
-                              current_meeting->date_str?current_meeting->date_str:"?",
-                              current_meeting->time_str?current_meeting->time_str:"?");
-                     cJSON_AddStringToObject(no,"type","meeting_reminder");
-                     cJSON_AddStringToObject(no,"text",nt);
-                     cJSON_AddNumberToObject(no,"timestamp",(double)meeting_time);
-                     cJSON_AddNumberToObject(no,"relatedId",current_meeting->id);
-                     if(!cJSON_AddItemToArray(notifications_array,no)) cJSON_Delete(no);
-                 }
-             }
-         }
-         current_meeting = current_meeting->next;
-     }
+     // Check upcoming meetings for this mentee (per-mentee time index)
+     for_each_meeting_in_range(app_data, mentee_assoc_id, now + 1, upcoming_meeting_thresh, append_mentee_meeting_reminder, notifications_array);
 
      // Check recent issue updates for this mentee
      Issue* current_issue = app_data->issues_head;
@@ -907,7 +2728,7 @@ static enum MHD_Result handle_get_mentee_notifications(struct MHD_Connection *co
                  if (update_time > 0 && update_time > recent_update_thresh) {
                      cJSON* no = cJSON_CreateObject(); if (no) {
                          char nt[256];
-                         char short_desc[51]={0};
+                         char short_desc[54]={0}; // 50 chars + "..."
                          if(current_issue->description){ strncpy(short_desc,current_issue->description,50); if(strlen(current_issue->description)>50) strcat(short_desc,"..."); } else strcpy(short_desc,"N/A");
                          snprintf(nt,sizeof(nt),"Issue #%d ('%s') status updated to: %s",
                                   current_issue->id, short_desc, status_to_string(current_issue->status));
@@ -922,15 +2743,58 @@ static enum MHD_Result handle_get_mentee_notifications(struct MHD_Connection *co
          }
          current_issue = current_issue->next;
      }
+     return notifications_array;
+}
+
+/** @brief GET /api/mentee/me/notifications */
+static enum MHD_Result handle_get_mentee_notifications(struct MHD_Connection *connection, AppData *app_data) {
+     LOG_INFO("[API] Mentee: GET /api/mentee/me/notifications");
+     int user_id, mentee_assoc_id;
+     int authenticated = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
+     if (!authenticated) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
+     if (mentee_assoc_id <= 0) return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee association missing");
+
+     cJSON *notifications_array = mentee_notifications_json(app_data, mentee_assoc_id);
+     if (!notifications_array) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed create notification array");
      return send_json_response(connection, MHD_HTTP_OK, notifications_array);
 }
 
+/**
+ * @brief GET /api/mentee/me/dashboard - Everything the mentee dashboard loads on
+ * open, from one snapshot and one mentee lookup. "details" carries the general
+ * notes; "mentor" is null when the system has no mentor.
+ */
+static enum MHD_Result handle_get_mentee_dashboard(struct MHD_Connection *connection, AppData *app_data) {
+     LOG_INFO("[API] Mentee: GET /api/mentee/me/dashboard");
+     int user_id, mentee_assoc_id;
+     int authenticated = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
+     if (!authenticated) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized: Mentee role required");
+     if (mentee_assoc_id <= 0) return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee association missing");
+
+     Mentee* mentee = find_mentee_by_id(app_data, mentee_assoc_id);
+     if (!mentee) return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee details not found for associated ID");
+
+     const User* mentor_user = find_program_mentor(app_data);
+     cJSON *dashboard = cJSON_CreateObject();
+     if (!dashboard ||
+         !add_dashboard_part(dashboard, "details", mentee_to_json(mentee)) ||
+         !add_dashboard_part(dashboard, "meetings", mentee_meetings_json(app_data, mentee->id)) ||
+         !add_dashboard_part(dashboard, "issues", mentee_issues_json(app_data, mentee->id)) ||
+         !add_dashboard_part(dashboard, "mentor", mentor_user ? mentor_contact_json(mentor_user) : cJSON_CreateNull()) ||
+         !add_dashboard_part(dashboard, "notifications", mentee_notifications_json(app_data, mentee->id)))
+     {
+         cJSON_Delete(dashboard);
+         return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Failed to serialize dashboard");
+     }
+     return send_json_response(connection, MHD_HTTP_OK, dashboard);
+}
+
 /** @brief POST /api/mentee/me/issues (Mentee reports issue) */
 static enum MHD_Result handle_post_mentee_issue(struct MHD_Connection *connection, AppData *app_data, const char *upload_data, size_t upload_data_size) {
-    printf("[API] Mentee: POST /api/mentee/me/issues\n"); fflush(stdout);
+    LOG_INFO("[API] Mentee: POST /api/mentee/me/issues");
     int user_id, mentee_assoc_id;
-    User* user = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
-    if (!user) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
+    int authenticated = authenticate_request(connection, app_data, ROLE_MENTEE, &user_id, &mentee_assoc_id);
+    if (!authenticated) return send_error_response(connection, MHD_HTTP_UNAUTHORIZED, "Unauthorized");
     if (mentee_assoc_id <= 0) return send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee association missing");
     if (!upload_data || upload_data_size == 0) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Missing request body");
 
@@ -938,7 +2802,7 @@ static enum MHD_Result handle_post_mentee_issue(struct MHD_Connection *connectio
     Mentee* mentee = find_mentee_by_id(app_data, mentee_assoc_id);
     if (!mentee) return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Could not find mentee profile for authenticated user");
 
-    cJSON* root = cJSON_ParseWithLength(upload_data,upload_data_size);
+    cJSON* root = parse_request_body(upload_data, upload_data_size);
     if (!root) return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid JSON");
 
     const char* description_val = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(root,"description"));
@@ -963,10 +2827,258 @@ static enum MHD_Result handle_post_mentee_issue(struct MHD_Connection *connectio
 }
 
 
+// ========================================================================== //
+//                            ADMISSION CONTROL                               //
+// ========================================================================== //
+
+/**
+ * @brief Rate-limit key: the user behind a valid session (however many tokens
+ * they hold), else the client address. Returns 0 if there is neither.
+ */
+static int admission_client_key(struct MHD_Connection *connection, const SessionInfo *session, char *key, size_t key_size) {
+    if (session) {
+        snprintf(key, key_size, "user:%d", session->user_id);
+        return 1;
+    }
+    const union MHD_ConnectionInfo *info = MHD_get_connection_info(connection, MHD_CONNECTION_INFO_CLIENT_ADDRESS);
+    const struct sockaddr *addr = info ? info->client_addr : NULL;
+    char address[INET6_ADDRSTRLEN];
+    if (!addr) return 0;
+    if (addr->sa_family == AF_INET) {
+        if (!inet_ntop(AF_INET, &((const struct sockaddr_in *)addr)->sin_addr, address, sizeof(address))) return 0;
+    } else if (addr->sa_family == AF_INET6) {
+        if (!inet_ntop(AF_INET6, &((const struct sockaddr_in6 *)addr)->sin6_addr, address, sizeof(address))) return 0;
+    } else {
+        return 0;
+    }
+    snprintf(key, key_size, "ip:%s", address);
+    return 1;
+}
+
+static AdmissionClass admission_class(const SessionInfo *session, const char *method, const char *url) {
+    if (0 == strcmp(url, LOGIN_ENDPOINT) || 0 == strcmp(url, LOGOUT_ENDPOINT)) return ADMISSION_NORMAL;
+    if (!session) return ADMISSION_LOW; // Rejected with 401 anyway, unless it is /api/metrics
+    int writes = request_mutates_data(method, url);
+    if (session->role == ROLE_MENTOR) return writes ? ADMISSION_HIGH : ADMISSION_NORMAL;
+    return writes ? ADMISSION_NORMAL : ADMISSION_LOW;
+}
+
+static enum MHD_Result send_admission_rejection(struct MHD_Connection *connection, struct RequestState *state,
+                                                unsigned int status_code, int retry_after_s) {
+    static const char rate_limited_body[] = "{\"error\":\"Too many requests\"}";
+    static const char overloaded_body[] = "{\"error\":\"Server busy, please retry\"}";
+    const char *body = status_code == MHD_HTTP_TOO_MANY_REQUESTS ? rate_limited_body : overloaded_body;
+    struct MHD_Response *response = MHD_create_response_from_buffer(strlen(body), (void *)body, MHD_RESPMEM_PERSISTENT);
+    if (!response) return MHD_NO;
+    char retry_after[16];
+    snprintf(retry_after, sizeof(retry_after), "%d", retry_after_s);
+    add_headers(response, json_headers);
+    MHD_add_response_header(response, MHD_HTTP_HEADER_RETRY_AFTER, retry_after);
+    enum MHD_Result ret = MHD_queue_response(connection, status_code, response);
+    MHD_destroy_response(response);
+    if (ret == MHD_YES) state->status = (int)status_code;
+    return ret;
+}
+
+/**
+ * @brief Runs before anything else is done for a request, so a client over
+ * its rate or a request the budget cannot take costs only a session lookup.
+ * Returns 1 to go on; otherwise 429/503 has been queued.
+ */
+static int admit_request(struct MHD_Connection *connection, struct RequestState *state, const char *method, const char *url) {
+    if (0 == strcmp(method, MHD_HTTP_METHOD_OPTIONS)) return 1; // Preflights are answered from the cache
+
+    SessionInfo session;
+    int has_session = peek_request_session(connection, &session);
+    char key[ADMISSION_KEY_MAX];
+    int has_key = admission_client_key(connection, has_session ? &session : NULL, key, sizeof(key));
+    AdmissionClass cls = admission_class(has_session ? &session : NULL, method, url);
+
+    int retry_after_s = 1;
+    AdmissionResult result = admission_acquire(has_key ? key : NULL, cls, &retry_after_s);
+    if (result == ADMISSION_ADMITTED) {
+        state->admitted = 1;
+        return 1;
+    }
+    if (result == ADMISSION_RATE_LIMITED) {
+        LOG_DEBUG("[ADMISSION] %s over its rate limit: %s %s", key, method, url);
+        send_admission_rejection(connection, state, MHD_HTTP_TOO_MANY_REQUESTS, retry_after_s);
+    } else {
+        LOG_DEBUG("[ADMISSION] Shedding %s %s (class %d).", method, url, (int)cls);
+        send_admission_rejection(connection, state, MHD_HTTP_SERVICE_UNAVAILABLE, retry_after_s);
+    }
+    return 0;
+}
+
+// ========================================================================== //
+//                           REQUEST COALESCING                               //
+// ========================================================================== //
+
+// When a class starts, dashboards ask for the same reads within the same second.
+// Identical concurrent requests to a shared route join one flight: the first
+// computes the response, the others wait and queue that same MHD_Response.
+
+struct KeyBuilder {
+    char *buf;
+    size_t len;
+    size_t cap;
+    int overflow;
+};
+
+static enum MHD_Result append_query_arg(void *cls, enum MHD_ValueKind kind, const char *key, const char *value) {
+    (void)kind;
+    struct KeyBuilder *builder = cls;
+    int n = snprintf(builder->buf + builder->len, builder->cap - builder->len, "&%s=%s", key, value ? value : "");
+    if (n < 0 || (size_t)n >= builder->cap - builder->len) {
+        builder->overflow = 1;
+        return MHD_NO;
+    }
+    builder->len += (size_t)n;
+    return MHD_YES;
+}
+
+/**
+ * @brief Flight key: route, whose data it may show (role and associated ID,
+ * which is all the handlers look at), data version and query string. Call
+ * with the data lock held. Returns 0 if the request must run alone
+ * (no session, so the handler answers 401, or an oversized query).
+ */
+static int coalescing_key(struct MHD_Connection *connection, const struct RequestState *state, char *key, size_t key_size) {
+    SessionInfo session;
+    if (!peek_request_session(connection, &session)) return 0;
+    int n = snprintf(key, key_size, "%d|%s:%d|%llu|", state->route, role_to_string(session.role),
+                     session.associated_id, data_version);
+    if (n < 0 || (size_t)n >= key_size) return 0;
+    struct KeyBuilder builder = { key, (size_t)n, key_size, 0 };
+    MHD_get_connection_values(connection, MHD_GET_ARGUMENT_KIND, append_query_arg, &builder);
+    return !builder.overflow;
+}
+
+static void destroy_shared_response(void *response) {
+    MHD_destroy_response(response);
+}
+
+/**
+ * @brief Runs a shared route, computing it or waiting for an identical request
+ * that already is. Entered with the data lock held shared; a waiter drops it
+ * while it waits, and '*data_locked' says whether it is still held.
+ */
+static enum MHD_Result dispatch_coalesced(struct MHD_Connection *connection, AppData *app_data, struct RequestState *state, int *data_locked) {
+    const struct RouteSpec *spec = &route_specs[state->route];
+    char key[COALESCE_KEY_MAX];
+    int leader = 1;
+    CoalesceFlight *flight = coalescing_key(connection, state, key, sizeof(key)) ? coalesce_join(key, &leader) : NULL;
+    if (!flight) return dispatch_route(connection, app_data, spec, state->route_id, NULL, 0);
+
+    enum MHD_Result ret;
+    if (leader) {
+        state->leads_flight = 1;
+        ret = dispatch_route(connection, app_data, spec, state->route_id, NULL, 0);
+        state->leads_flight = 0;
+        // Cached errors are not kept; their waiters will run the handler themselves
+        coalesce_finish(flight, state->shared_response, (unsigned int)state->status, destroy_shared_response);
+        state->shared_response = NULL;
+        coalesce_release(flight);
+        return ret;
+    }
+
+    unlock_app_data(); // The leader holds it for us; let writers queue behind it
+    *data_locked = 0;
+    TraceSpan span = trace_begin("coalesce_wait");
+    unsigned int status = 0;
+    struct MHD_Response *shared = coalesce_wait(flight, &status);
+    trace_end(span);
+    if (shared) {
+        ret = queue_response(connection, status, shared); // MHD keeps its own reference
+        coalesce_release(flight);
+        return ret;
+    }
+    coalesce_release(flight);
+    lock_app_data(0);
+    *data_locked = 1;
+    return dispatch_route(connection, app_data, spec, state->route_id, NULL, 0);
+}
+
+// ========================================================================== //
+//                             IDEMPOTENCY KEYS                               //
+// ========================================================================== //
+
+// Clients that time out retry their POST, which would create the record twice
+// (and save twice). With an Idempotency-Key header the first 2xx response is
+// kept, scoped to the user and route, and a retry gets it back unexecuted.
+// Errors are not kept: they created nothing, so running the retry is harmless.
+
+static enum MHD_Result send_replayed_response(struct MHD_Connection *connection, unsigned int status_code, char *body, size_t body_length) {
+    struct MHD_Response *response = MHD_create_response_from_buffer(body_length, body, MHD_RESPMEM_MUST_FREE);
+    if (!response) {
+        free(body);
+        return send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Internal Server Error");
+    }
+    add_headers(response, json_headers);
+    MHD_add_response_header(response, REPLAYED_HEADER, "true");
+    enum MHD_Result ret = queue_response(connection, status_code, response);
+    MHD_destroy_response(response);
+    return ret;
+}
+
+/**
+ * @brief Runs an idempotent route. These routes write, so the data lock is
+ * held exclusively: the lookup, the handler and the store cannot interleave
+ * with a retry of the same request, which waits and then finds the answer.
+ */
+static enum MHD_Result dispatch_idempotent(struct MHD_Connection *connection, AppData *app_data, struct RequestState *state,
+                                           const char *body, size_t body_size) {
+    const struct RouteSpec *spec = &route_specs[state->route];
+    const char *client_key = MHD_lookup_connection_value(connection, MHD_HEADER_KIND, IDEMPOTENCY_HEADER);
+    SessionInfo session;
+    // Without a session the handler answers 401 and there is nothing to keep
+    if (!client_key || !peek_request_session(connection, &session)) return dispatch_route(connection, app_data, spec, state->route_id, body, body_size);
+    size_t client_key_length = strlen(client_key);
+    if (client_key_length == 0 || client_key_length >= IDEMPOTENCY_KEY_MAX) {
+        return send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Idempotency-Key must be 1 to 255 characters");
+    }
+
+    char key[IDEMPOTENCY_SCOPED_KEY_MAX];
+    snprintf(key, sizeof(key), "%d|%d|%s", session.user_id, state->route, client_key);
+    uint64_t fingerprint = idempotency_fingerprint(body, body_size);
+    unsigned int status = 0;
+    char *stored = NULL;
+    size_t stored_length = 0;
+    switch (idempotency_lookup(key, fingerprint, &status, &stored, &stored_length)) {
+    case IDEMPOTENCY_HIT:
+        LOG_INFO("[API] Replaying the response to Idempotency-Key '%s' (user %d).", client_key, session.user_id);
+        return send_replayed_response(connection, status, stored, stored_length);
+    case IDEMPOTENCY_MISMATCH:
+        return send_error_response(connection, MHD_HTTP_UNPROCESSABLE_ENTITY, "Idempotency-Key was already used with a different request body");
+    case IDEMPOTENCY_MISS:
+        break;
+    }
+
+    state->idempotency_key = key; // Cleared again before the array goes out of scope
+    state->idempotency_fingerprint = fingerprint;
+    enum MHD_Result ret = dispatch_route(connection, app_data, spec, state->route_id, body, body_size);
+    state->idempotency_key = NULL;
+    return ret;
+}
+
 // ========================================================================== //
 //                         MAIN REQUEST HANDLER (ROUTER)                      //
 // ========================================================================== //
 
+/**
+ * @brief Hands one upload chunk to a stream route. Runs without the data lock;
+ * the handler takes it around whatever it applies.
+ */
+static enum MHD_Result stream_request_chunk(struct MHD_Connection *connection, AppData *app_data, struct RequestState *state,
+                                            const char *chunk, size_t chunk_size) {
+    current_request = state;
+    trace_attach_request(&state->trace);
+    enum MHD_Result ret = route_specs[state->route].handler.stream(connection, app_data, state, chunk, chunk_size);
+    trace_attach_request(NULL);
+    current_request = NULL;
+    return ret;
+}
+
 enum MHD_Result request_handler(void *cls, struct MHD_Connection *connection,
                                 const char *url, const char *method,
                                 const char *version, const char *upload_data,
@@ -974,94 +3086,92 @@ enum MHD_Result request_handler(void *cls, struct MHD_Connection *connection,
 
     (void)version; // Mark unused
 
-    printf("[ROUTER] %s %s\n", method, url); fflush(stdout);
     AppData *app_data = (AppData *)cls;
     enum MHD_Result ret = MHD_NO; // Default to error/unhandled
 
-    // --- CORS Preflight Handling ---
-     if (0 == strcmp(method, MHD_HTTP_METHOD_OPTIONS)) {
-         printf("[ROUTER] Handling OPTIONS request for CORS preflight.\n"); fflush(stdout);
-         struct MHD_Response *response = MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT);
-         if (!response) return MHD_NO;
-         MHD_add_response_header(response, "Access-Control-Allow-Origin", "*");
-         MHD_add_response_header(response, "Access-Control-Allow-Methods", "GET, POST, PATCH, DELETE, OPTIONS");
-         MHD_add_response_header(response, "Access-Control-Allow-Headers", "Content-Type, Authorization, " AUTH_HEADER);
-         MHD_add_response_header(response, "Access-Control-Max-Age", "86400"); // Cache preflight for 1 day
-         ret = MHD_queue_response(connection, MHD_HTTP_OK, response);
-         MHD_destroy_response(response);
-         return ret;
-     }
-
-    // --- POST/PATCH Data Accumulation ---
-    struct PostStatus *post_status = NULL;
-    if (*con_cls == NULL) {
-        // First call for this connection
-        if (0 == strcmp(method, MHD_HTTP_METHOD_POST) || 0 == strcmp(method, MHD_HTTP_METHOD_PATCH)) {
-            // Expecting body data, allocate status struct
-            post_status = malloc(sizeof(struct PostStatus));
-            if (!post_status) { fprintf(stderr,"[ROUTER] Failed malloc PostStatus\n"); return MHD_NO; }
-            post_status->buffer = NULL;
-            post_status->buffer_size = 0;
-            post_status->complete = 0;
-            post_status->error = 0;
-            *con_cls = (void *)post_status;
-            printf("[ROUTER] Initialized PostStatus for %s.\n", method); fflush(stdout);
+    // --- Per-Request State ---
+    struct RequestState *state = *con_cls;
+    if (state == NULL) {
+        // First call for this request: start timing and classify the route
+        LOG_DEBUG("[ROUTER] %s %s", method, url);
+        state = create_request_state(connection);
+        if (!state) { LOG_ERROR("[ROUTER] Failed to allocate RequestState"); return MHD_NO; }
+        state->started_ns = metrics_now_ns();
+        state->route = classify_route(method, url, &state->route_id, &state->path_matched);
+        state->has_body = (0 == strcmp(method, MHD_HTTP_METHOD_POST) || 0 == strcmp(method, MHD_HTTP_METHOD_PATCH));
+        *con_cls = state; // Freed in request_completed()
+        if (!admit_request(connection, state, method, url)) {
+            return state->status ? MHD_YES : MHD_NO; // Answered with 429/503; MHD skips any body
+        }
+        if (state->has_body && state->route < ROUTE_COUNT && route_specs[state->route].args == ROUTE_ARGS_STREAM) {
+            return MHD_YES; // Streamed to the handler, never buffered
+        }
+        if (state->has_body) {
+            // A declared oversize body is rejected without buffering any of it
+            if (!reserve_request_body(connection, state)) state->post.error = 1;
+            LOG_DEBUG("[ROUTER] Initialized PostStatus for %s (%zu bytes reserved).", method, state->post.capacity);
             return MHD_YES; // Ask for more data
-        } else {
-            // Not POST/PATCH, mark connection context as processed (simple flag)
-            *con_cls = (void*)1; // Use 1 to indicate no PostStatus needed/allocated
-             printf("[ROUTER] No PostStatus needed for %s.\n", method); fflush(stdout);
         }
     }
 
-    if (*con_cls != (void*)1) {
-        // If context is not the simple flag (1), it must be a PostStatus struct
-        post_status = *con_cls;
-         if (!post_status) { fprintf(stderr,"[ROUTER] Invalid PostStatus state\n"); return MHD_NO; } // Should not happen
-
-        if (post_status->error) {
-            printf("[ROUTER] PostStatus error flag set, ignoring data.\n"); fflush(stdout);
-             *upload_data_size = 0; // Discard any further data
-             if (*upload_data_size == 0) post_status->complete = 1; // Mark as complete on final call even if error
-             return MHD_YES;
-        }
-
-        if (*upload_data_size > 0) {
-            // Accumulate data
+    // --- POST/PATCH Data Accumulation ---
+    struct PostStatus *post_status = NULL;
+    if (state->has_body) {
+        post_status = &state->post;
+
+        if (state->route < ROUTE_COUNT && route_specs[state->route].args == ROUTE_ARGS_STREAM) {
+            if (*upload_data_size > 0) {
+                ret = stream_request_chunk(connection, app_data, state, upload_data, *upload_data_size);
+                *upload_data_size = 0;
+                return ret;
+            }
+            post_status->complete = 1; // Final call: the handler answers below
+        } else if (post_status->error) {
+            if (*upload_data_size > 0) {
+                LOG_DEBUG("[ROUTER] PostStatus error flag set, ignoring data.");
+                *upload_data_size = 0; // Discard any further data
+                return MHD_YES;
+            }
+            post_status->complete = 1; // Final call: answered with 413 below
+        } else if (*upload_data_size > 0) {
+            // Accumulate data into the buffer reserved on the first call
             size_t new_size = post_status->buffer_size + *upload_data_size;
-            if (new_size > MAX_POST_SIZE) {
-                fprintf(stderr, "[ROUTER] Error: POST data exceeds MAX_POST_SIZE (%zu > %d).\n", new_size, MAX_POST_SIZE);
-                free(post_status->buffer); // Free existing buffer
-                post_status->buffer = NULL;
+            if (new_size > post_status->capacity) {
+                LOG_ERROR("[ROUTER] Error: POST data exceeds its reserved size (%zu > %zu).", new_size, post_status->capacity);
                 post_status->buffer_size = 0;
                 post_status->error = 1;    // Set error flag
                  *upload_data_size = 0;     // Discard current chunk
                 return MHD_YES; // Still need to wait for the final call
             }
-            // Reallocate and copy
-            char *new_buffer = realloc(post_status->buffer, new_size);
-            if (!new_buffer) {
-                fprintf(stderr, "[ROUTER] Error: Failed realloc for POST buffer.\n");
-                free(post_status->buffer);
-                post_status->buffer = NULL; post_status->buffer_size = 0; post_status->error = 1; *upload_data_size = 0;
-                return MHD_YES; // Wait for final call
-            }
-            post_status->buffer = new_buffer;
             memcpy(post_status->buffer + post_status->buffer_size, upload_data, *upload_data_size);
             post_status->buffer_size = new_size;
             *upload_data_size = 0; // Indicate data was processed
-             printf("[ROUTER] Accumulated %zu bytes for POST/PATCH.\n", post_status->buffer_size); fflush(stdout);
+             LOG_DEBUG("[ROUTER] Accumulated %zu bytes for POST/PATCH.", post_status->buffer_size);
             return MHD_YES; // Ask for more data
         } else {
             // Final call (*upload_data_size == 0)
             post_status->complete = 1;
-            printf("[ROUTER] Final POST/PATCH chunk received. Total size: %zu\n", post_status->buffer_size); fflush(stdout);
+            LOG_DEBUG("[ROUTER] Final POST/PATCH chunk received. Total size: %zu", post_status->buffer_size);
+            trace_attach_request(&state->trace);
+            trace_record("body", state->started_ns, metrics_now_ns());
         }
     }
 
+    current_request = state;
+    trace_attach_request(&state->trace);
+    TraceSpan handler_span = trace_begin("handler");
+    int data_locked = 0;
+
+    // --- CORS Preflight Handling ---
+     if (0 == strcmp(method, MHD_HTTP_METHOD_OPTIONS)) {
+         LOG_DEBUG("[ROUTER] Handling OPTIONS request for CORS preflight.");
+         ret = queue_cached_response(connection, MHD_HTTP_OK, &preflight_response);
+         goto cleanup;
+     }
+
     // --- Routing Logic ---
     // At this point, for POST/PATCH, post_status->complete should be 1 if all data is ready
-    // For GET/DELETE, *con_cls is (void*)1
+    // For GET/DELETE, post_status is NULL
 
     // Check if body processing is needed but not complete/ready
      if ((0 == strcmp(method, MHD_HTTP_METHOD_POST) || 0 == strcmp(method, MHD_HTTP_METHOD_PATCH)) && (!post_status || !post_status->complete)) {
@@ -1069,101 +3179,68 @@ enum MHD_Result request_handler(void *cls, struct MHD_Connection *connection,
          // or if the final call hasn't happened yet.
          // We already returned MHD_YES above if accumulation is ongoing.
          // If we reach here unexpectedly, treat as error.
-         fprintf(stderr, "[ROUTER] Error: POST/PATCH request reached routing logic prematurely.\n");
+         LOG_ERROR("[ROUTER] Error: POST/PATCH request reached routing logic prematurely.");
          ret = send_error_response(connection, MHD_HTTP_INTERNAL_SERVER_ERROR, "Request processing error");
          goto cleanup; // Jump to cleanup
      }
 
-    // --- Authentication Endpoints ---
-    if (0 == strcmp(url, LOGIN_ENDPOINT) && 0 == strcmp(method, MHD_HTTP_METHOD_POST)) {
-        if(post_status && post_status->error) ret = send_error_response(connection, MHD_HTTP_CONTENT_TOO_LARGE, "Request body too large");
-        else ret = handle_login(connection, app_data, post_status ? post_status->buffer : NULL, post_status ? post_status->buffer_size : 0);
-    } else if (0 == strcmp(url, LOGOUT_ENDPOINT) && 0 == strcmp(method, MHD_HTTP_METHOD_POST)) {
-        // Logout doesn't strictly need the body, but we wait for completion anyway.
-         ret = handle_logout(connection, app_data); // Pass app_data if needed later
-    }
-    // --- Mentee Endpoints ---
-    else if (0 == strncmp(url, MENTEE_API_PREFIX, strlen(MENTEE_API_PREFIX))) {
-        const char *endpoint = url + strlen(MENTEE_API_PREFIX);
-        if (0 == strcmp(method, MHD_HTTP_METHOD_GET)) {
-            if (0 == strcmp(endpoint, "details")) ret = handle_get_mentee_details(connection, app_data);
-            else if (0 == strcmp(endpoint, "meetings")) ret = handle_get_mentee_meetings(connection, app_data);
-            else if (0 == strcmp(endpoint, "issues")) ret = handle_get_mentee_issues(connection, app_data);
-            else if (0 == strcmp(endpoint, "mentor")) ret = handle_get_mentee_mentor(connection, app_data);
-            else if (0 == strcmp(endpoint, "notes")) ret = handle_get_mentee_notes(connection, app_data);
-            else if (0 == strcmp(endpoint, "notifications")) ret = handle_get_mentee_notifications(connection, app_data);
-            else ret = send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee API endpoint not found");
-        } else if (0 == strcmp(method, MHD_HTTP_METHOD_POST)) {
-            if (0 == strcmp(endpoint, "issues")) { // Mentee reporting an issue
-                 if(post_status && post_status->error) ret = send_error_response(connection, MHD_HTTP_CONTENT_TOO_LARGE, "Request body too large");
-                 else ret = handle_post_mentee_issue(connection, app_data, post_status ? post_status->buffer : NULL, post_status ? post_status->buffer_size : 0);
-             } else {
-                 ret = send_error_response(connection, MHD_HTTP_NOT_FOUND, "Mentee POST endpoint not found");
-             }
-        } else {
-            ret = send_error_response(connection, MHD_HTTP_METHOD_NOT_ALLOWED, "Method Not Allowed on mentee endpoint");
-        }
+    // --- Routing (see route_specs) ---
+    if (state->route >= ROUTE_COUNT || !route_specs[state->route].handler.plain) {
+        if (state->path_matched) ret = send_error_response(connection, MHD_HTTP_METHOD_NOT_ALLOWED, "Method Not Allowed on this API path");
+        else ret = send_error_response(connection, MHD_HTTP_NOT_FOUND, "Endpoint not found");
+        goto cleanup;
     }
-    // --- Mentor Endpoints (Generic API Prefix) ---
-    else if (0 == strncmp(url, API_PREFIX, strlen(API_PREFIX))) {
-        const char *endpoint = url + strlen(API_PREFIX);
-        if (0 == strcmp(method, MHD_HTTP_METHOD_GET)) {
-            if (0 == strcmp(endpoint, "mentees")) ret = handle_get_mentees(connection, app_data);
-            else if (0 == strcmp(endpoint, "meetings")) ret = handle_get_meetings(connection, app_data);
-            else if (0 == strcmp(endpoint, "issues")) ret = handle_get_issues(connection, app_data);
-            else if (0 == strcmp(endpoint, "notifications")) ret = handle_get_notifications(connection, app_data);
-            else ret = send_error_response(connection, MHD_HTTP_NOT_FOUND, "API GET endpoint not found");
-        } else if (0 == strcmp(method, MHD_HTTP_METHOD_POST)) {
-             if(post_status && post_status->error) ret = send_error_response(connection, MHD_HTTP_CONTENT_TOO_LARGE, "Request body too large");
-             else if (0 == strcmp(endpoint, "mentees")) ret = handle_post_mentees(connection, app_data, post_status->buffer, post_status->buffer_size);
-             else if (0 == strcmp(endpoint, "meetings")) ret = handle_post_meetings(connection, app_data, post_status->buffer, post_status->buffer_size);
-             else if (0 == strcmp(endpoint, "issues")) ret = handle_post_issues(connection, app_data, post_status->buffer, post_status->buffer_size); // Mentor reports issue
-             else ret = send_error_response(connection, MHD_HTTP_NOT_FOUND, "API POST endpoint not found");
-        } else if (0 == strcmp(method, MHD_HTTP_METHOD_PATCH)) {
-             if(post_status && post_status->error) ret = send_error_response(connection, MHD_HTTP_CONTENT_TOO_LARGE, "Request body too large");
-             else if (0 == strncmp(endpoint, "meetings/", 9)) { // e.g., /api/meetings/123
-                 int id = atoi(endpoint + 9);
-                 if(id > 0) ret = handle_patch_meeting(connection, app_data, id, post_status->buffer, post_status->buffer_size);
-                 else ret = send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid meeting ID format");
-             } else if (0 == strncmp(endpoint, "issues/", 7)) { // e.g., /api/issues/45
-                 int id = atoi(endpoint + 7);
-                 if(id > 0) ret = handle_patch_issue(connection, app_data, id, post_status->buffer, post_status->buffer_size);
-                 else ret = send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid issue ID format");
-             } else {
-                 ret = send_error_response(connection, MHD_HTTP_NOT_FOUND, "API PATCH endpoint not found");
-             }
-        } else if (0 == strcmp(method, MHD_HTTP_METHOD_DELETE)) {
-             if (0 == strncmp(endpoint, "mentees/", 8)) { // e.g., /api/mentees/123
-                 int id = atoi(endpoint + 8);
-                 if(id > 0) ret = handle_delete_mentee(connection, app_data, id);
-                 else ret = send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid mentee ID format");
-             } else if (0 == strncmp(endpoint, "meetings/", 9)) { // e.g., /api/meetings/123
-                 int id = atoi(endpoint + 9);
-                 if(id > 0) ret = handle_delete_meeting(connection, app_data, id);
-                 else ret = send_error_response(connection, MHD_HTTP_BAD_REQUEST, "Invalid meeting ID format");
-             } else {
-                 ret = send_error_response(connection, MHD_HTTP_NOT_FOUND, "API DELETE endpoint not found");
-             }
-        } else {
-            ret = send_error_response(connection, MHD_HTTP_METHOD_NOT_ALLOWED, "Method Not Allowed on this API path");
-        }
+    if (post_status && post_status->error) {
+        ret = send_error_response(connection, MHD_HTTP_CONTENT_TOO_LARGE, "Request body too large");
+        goto cleanup;
+    }
+
+    // Login takes the lock itself: its password check must not run under it
+    if (route_specs[state->route].handler.body != handle_login) {
+        lock_app_data(request_mutates_data(method, url));
+        data_locked = 1;
     }
-    // --- Fallback for unknown URLs ---
-    else {
-        ret = send_error_response(connection, MHD_HTTP_NOT_FOUND, "Endpoint not found");
+    if (route_specs[state->route].flags & ROUTE_FLAG_SHARED) {
+        ret = dispatch_coalesced(connection, app_data, state, &data_locked);
+    } else if (route_specs[state->route].flags & ROUTE_FLAG_IDEMPOTENT) {
+        ret = dispatch_idempotent(connection, app_data, state,
+                                  post_status ? post_status->buffer : NULL, post_status ? post_status->buffer_size : 0);
+    } else {
+        ret = dispatch_route(connection, app_data, &route_specs[state->route], state->route_id,
+                             post_status ? post_status->buffer : NULL, post_status ? post_status->buffer_size : 0);
     }
 
 cleanup:
-    // --- Cleanup PostStatus if it was used ---
-    if (post_status != NULL && post_status->complete) {
-         printf("[ROUTER] Cleaning up PostStatus.\n"); fflush(stdout);
-        free(post_status->buffer); // Free accumulated data
-        free(post_status);         // Free the status struct itself
-        *con_cls = NULL;           // Clear connection context
-    } else if (*con_cls == (void*)1) {
-        *con_cls = NULL; // Clear the simple flag if it was set
+    // PostStatus/RequestState are released in request_completed(), which MHD
+    // also calls for requests that never reach this point (client aborts).
+    if (data_locked) unlock_app_data();
+    trace_end(handler_span);
+    trace_attach_request(NULL);
+    current_request = NULL;
+    LOG_DEBUG("[ROUTER] Request handling finished for %s %s, MHD result: %d.", method, url, ret);
+    return ret;
+}
+
+/**
+ * @brief MHD_OPTION_NOTIFY_COMPLETED callback: records the request's metrics
+ * and frees the per-request state allocated by request_handler().
+ */
+void request_completed(void *cls, struct MHD_Connection *connection,
+                       void **con_cls, enum MHD_RequestTerminationCode toe) {
+    (void)cls; (void)connection;
+    struct RequestState *state = con_cls ? *con_cls : NULL;
+    if (!state) return;
+
+    int route = state->route;
+    const char *label = route < ROUTE_COUNT ? route_specs[route].label : "unmatched";
+    uint64_t finished_ns = metrics_now_ns();
+    metrics_record_request(route, label, state->status, finished_ns - state->started_ns);
+    trace_finish_request(&state->trace, label, state->status, state->started_ns, finished_ns);
+    if (toe != MHD_REQUEST_TERMINATED_COMPLETED_OK) {
+        LOG_DEBUG("[ROUTER] Request terminated early (code %d).", (int)toe);
     }
 
-    printf("[ROUTER] Request handling finished for %s %s, MHD result: %d.\n", method, url, ret); fflush(stdout);
-    return ret;
-}
\ No newline at end of file
+    if (state->admitted) admission_release();
+    release_request_state(state); // Body, parsed JSON and scratch strings go with it
+    *con_cls = NULL;
+}
@@ -24,4 +24,25 @@ enum MHD_Result request_handler(void *cls, struct MHD_Connection *connection,
                                 const char *version, const char *upload_data,
                                 size_t *upload_data_size, void **con_cls);
 
+/**
+ * @brief Request-completion callback (MHD_OPTION_NOTIFY_COMPLETED).
+ * Records per-route metrics and frees the state request_handler kept in *con_cls.
+ */
+void request_completed(void *cls, struct MHD_Connection *connection,
+                       void **con_cls, enum MHD_RequestTerminationCode toe);
+
+/**
+ * @brief Connection callback (MHD_OPTION_NOTIFY_CONNECTION): gives each
+ * connection the arena its requests allocate from, freed when it closes.
+ * Without it every request creates and frees an arena of its own.
+ */
+void connection_notify(void *cls, struct MHD_Connection *connection,
+                       void **socket_context, enum MHD_ConnectionNotificationCode toe);
+
+/**
+ * @brief Runs check_app_data_consistency() under the handlers' data lock, so it
+ * can be called while the daemon is serving requests (tools/stress).
+ */
+int api_check_consistency(AppData *app_data, char *problem, size_t problem_cap);
+
 #endif // API_HANDLER_H
\ No newline at end of file
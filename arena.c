@@ -0,0 +1,119 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "arena.h"
+
+#define ARENA_ALIGN (sizeof(max_align_t))
+
+typedef struct ArenaChunk {
+    struct ArenaChunk* next;
+    size_t size;                // Usable bytes in 'data'
+    size_t used;
+    _Alignas(max_align_t) unsigned char data[];
+} ArenaChunk;
+
+struct Arena {
+    ArenaChunk* current;        // Chunk small allocations are bumped from
+    ArenaChunk* chunks;         // Every chunk, newest first
+    ArenaChunk* retained;       // First standard-size chunk; survives arena_reset()
+    size_t chunk_size;
+    size_t bytes_used;
+};
+
+static ArenaChunk* arena_chunk_create(size_t size) {
+    ArenaChunk* chunk = malloc(sizeof(ArenaChunk) + size);
+    if (!chunk) return NULL;
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+    return chunk;
+}
+
+Arena* arena_create(size_t chunk_size) {
+    Arena* arena = calloc(1, sizeof(Arena));
+    if (!arena) return NULL;
+    arena->chunk_size = chunk_size > 0 ? chunk_size : 4096;
+    return arena;
+}
+
+void arena_free(Arena* arena) {
+    if (!arena) return;
+    ArenaChunk* chunk = arena->chunks;
+    while (chunk) {
+        ArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
+
+void arena_reset(Arena* arena) {
+    if (!arena) return;
+    ArenaChunk* chunk = arena->chunks;
+    while (chunk) {
+        ArenaChunk* next = chunk->next;
+        if (chunk != arena->retained) free(chunk);
+        chunk = next;
+    }
+    if (arena->retained) {
+        arena->retained->next = NULL;
+        arena->retained->used = 0;
+    }
+    arena->chunks = arena->retained;
+    arena->current = arena->retained;
+    arena->bytes_used = 0;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    if (!arena) return NULL;
+    if (size == 0) size = 1;
+    if (size > SIZE_MAX - ARENA_ALIGN) return NULL;
+    size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+
+    ArenaChunk* chunk = arena->current;
+    if (!chunk || chunk->size - chunk->used < size) {
+        if (size > arena->chunk_size) {
+            // Oversized: a dedicated chunk, linked in without replacing 'current'
+            chunk = arena_chunk_create(size);
+            if (!chunk) return NULL;
+            chunk->next = arena->chunks;
+            arena->chunks = chunk;
+            chunk->used = size;
+            arena->bytes_used += size;
+            return chunk->data;
+        }
+        chunk = arena_chunk_create(arena->chunk_size);
+        if (!chunk) return NULL;
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+        arena->current = chunk;
+        if (!arena->retained) arena->retained = chunk;
+    }
+    void* ptr = chunk->data + chunk->used;
+    chunk->used += size;
+    arena->bytes_used += size;
+    return ptr;
+}
+
+char* arena_strdup(Arena* arena, const char* s) {
+    if (!s) return NULL;
+    size_t len = strlen(s) + 1;
+    char* copy = arena_alloc(arena, len);
+    if (copy) memcpy(copy, s, len);
+    return copy;
+}
+
+int arena_owns(const Arena* arena, const void* ptr) {
+    if (!arena || !ptr) return 0;
+    uintptr_t p = (uintptr_t)ptr;
+    for (const ArenaChunk* chunk = arena->chunks; chunk; chunk = chunk->next) {
+        uintptr_t start = (uintptr_t)chunk->data;
+        if (p >= start && p < start + chunk->used) return 1;
+    }
+    return 0;
+}
+
+size_t arena_bytes_used(const Arena* arena) {
+    return arena ? arena->bytes_used : 0;
+}
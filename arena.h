@@ -0,0 +1,33 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/**
+ * @brief Bump allocator for memory that all dies at the same time (e.g. one
+ * request). Nothing is freed individually; arena_reset() drops everything at
+ * once and keeps the first chunk for the next user. Not thread-safe.
+ */
+typedef struct Arena Arena;
+
+// --- Lifecycle ---
+Arena* arena_create(size_t chunk_size); // Chunks are allocated lazily
+void arena_free(Arena* arena);
+void arena_reset(Arena* arena);         // Invalidates every pointer handed out so far
+
+// --- Allocation (max_align_t aligned; NULL on failure) ---
+/**
+ * @brief Returns 'size' bytes from the current chunk. Requests larger than the
+ * chunk size get a chunk of their own, so they never waste the current one.
+ */
+void* arena_alloc(Arena* arena, size_t size);
+char* arena_strdup(Arena* arena, const char* s);
+
+/**
+ * @brief 1 if 'ptr' points into memory handed out by this arena.
+ */
+int arena_owns(const Arena* arena, const void* ptr);
+
+size_t arena_bytes_used(const Arena* arena);
+
+#endif // ARENA_H
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "coalesce.h"
+
+#define COALESCE_BUCKETS 256 // Hash buckets (power of two); flights are few and short-lived
+
+struct CoalesceFlight {
+    char key[COALESCE_KEY_MAX];
+    int refs;                   // Leader plus waiters still holding the flight
+    int done;                   // Set by coalesce_finish(); 'result' and 'status' are final
+    void *result;
+    unsigned int status;
+    CoalesceFreeFn free_result;
+    pthread_cond_t finished;
+    struct CoalesceFlight *next;
+};
+
+// One lock for the table and every flight in it: each request takes it a few
+// times for a handful of instructions, while the work it coalesces takes milliseconds
+static CoalesceFlight *flights[COALESCE_BUCKETS];
+static pthread_mutex_t flights_lock = PTHREAD_MUTEX_INITIALIZER;
+static size_t flight_count = 0;
+static unsigned long long led_count = 0;
+static unsigned long long joined_count = 0;
+
+static size_t key_bucket(const char *key) {
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (const unsigned char *p = (const unsigned char *)key; *p; ++p) hash = (hash ^ *p) * 16777619u;
+    return hash & (COALESCE_BUCKETS - 1);
+}
+
+CoalesceFlight* coalesce_join(const char *key, int *leader) {
+    if (!key || strlen(key) >= COALESCE_KEY_MAX) return NULL;
+    size_t bucket = key_bucket(key);
+    pthread_mutex_lock(&flights_lock);
+    for (CoalesceFlight *flight = flights[bucket]; flight; flight = flight->next) {
+        if (0 == strcmp(flight->key, key)) {
+            flight->refs++;
+            joined_count++;
+            pthread_mutex_unlock(&flights_lock);
+            *leader = 0;
+            return flight;
+        }
+    }
+    CoalesceFlight *flight = calloc(1, sizeof(CoalesceFlight));
+    if (!flight) {
+        pthread_mutex_unlock(&flights_lock);
+        return NULL;
+    }
+    strcpy(flight->key, key);
+    flight->refs = 1;
+    pthread_cond_init(&flight->finished, NULL);
+    flight->next = flights[bucket];
+    flights[bucket] = flight;
+    flight_count++;
+    led_count++;
+    pthread_mutex_unlock(&flights_lock);
+    *leader = 1;
+    return flight;
+}
+
+void coalesce_finish(CoalesceFlight *flight, void *result, unsigned int status, CoalesceFreeFn free_result) {
+    pthread_mutex_lock(&flights_lock);
+    flight->result = result;
+    flight->status = status;
+    flight->free_result = free_result;
+    flight->done = 1;
+    // Unlinked now: the result reflects the data as the leader saw it, so
+    // later requests must not join a flight that has already landed
+    for (CoalesceFlight **link = &flights[key_bucket(flight->key)]; *link; link = &(*link)->next) {
+        if (*link == flight) {
+            *link = flight->next;
+            break;
+        }
+    }
+    flight_count--;
+    pthread_cond_broadcast(&flight->finished);
+    pthread_mutex_unlock(&flights_lock);
+}
+
+void* coalesce_wait(CoalesceFlight *flight, unsigned int *status) {
+    pthread_mutex_lock(&flights_lock);
+    while (!flight->done) pthread_cond_wait(&flight->finished, &flights_lock);
+    void *result = flight->result;
+    if (status) *status = flight->status;
+    pthread_mutex_unlock(&flights_lock);
+    return result;
+}
+
+void coalesce_release(CoalesceFlight *flight) {
+    if (!flight) return;
+    pthread_mutex_lock(&flights_lock);
+    int last = --flight->refs == 0;
+    pthread_mutex_unlock(&flights_lock);
+    if (!last) return;
+    if (flight->result && flight->free_result) flight->free_result(flight->result);
+    pthread_cond_destroy(&flight->finished);
+    free(flight);
+}
+
+void coalesce_get_stats(CoalesceStats *stats) {
+    pthread_mutex_lock(&flights_lock);
+    stats->in_flight = flight_count;
+    stats->led = led_count;
+    stats->joined = joined_count;
+    pthread_mutex_unlock(&flights_lock);
+}
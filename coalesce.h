@@ -0,0 +1,48 @@
+#ifndef COALESCE_H
+#define COALESCE_H
+
+#include <stddef.h>
+
+#define COALESCE_KEY_MAX 512    // Flight key length, NUL included; longer requests run alone
+
+/**
+ * @brief One computation in progress, shared by every request with its key.
+ * The first request to join leads: it computes and publishes the result.
+ * The others wait for it and reuse the result instead of computing their own.
+ */
+typedef struct CoalesceFlight CoalesceFlight;
+
+typedef void (*CoalesceFreeFn)(void *result);
+
+typedef struct {
+    size_t in_flight;           // Flights being computed right now
+    unsigned long long led;     // Flights computed since startup
+    unsigned long long joined;  // Requests that waited on another's flight instead
+} CoalesceStats;
+
+/**
+ * @brief Joins the flight for 'key', starting one if there is none.
+ * '*leader' is set to 1 if the caller must compute and coalesce_finish() it.
+ * Returns NULL (compute alone) if the key is too long or memory is short.
+ * Every flight returned must be handed back with coalesce_release().
+ */
+CoalesceFlight* coalesce_join(const char *key, int *leader);
+
+/**
+ * @brief Leader only: publishes 'result' (NULL if there is nothing to share)
+ * and wakes the waiters. Requests joining afterwards start a new flight.
+ * 'free_result' is called on it once the last holder releases the flight.
+ */
+void coalesce_finish(CoalesceFlight *flight, void *result, unsigned int status, CoalesceFreeFn free_result);
+
+/**
+ * @brief Waiters only: blocks until the leader finishes. Returns its result,
+ * valid until coalesce_release(), or NULL if it had none to share.
+ */
+void* coalesce_wait(CoalesceFlight *flight, unsigned int *status);
+
+void coalesce_release(CoalesceFlight *flight);
+
+void coalesce_get_stats(CoalesceStats *stats);
+
+#endif // COALESCE_H
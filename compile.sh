@@ -1,8 +1,8 @@
 #!/bin/bash
 echo "Compiling backend server..."
-gcc Backend/main.c Backend/api_handler.c Backend/mentorship_data.c Backend/json_helpers.c \
+gcc Backend/main.c Backend/api_handler.c Backend/mentorship_data.c Backend/json_helpers.c Backend/skiplist.c Backend/search_index.c Backend/logger.c Backend/metrics.c Backend/trace.c Backend/memstats.c Backend/arena.c Backend/import.c Backend/export.c Backend/session.c Backend/password.c Backend/admission.c Backend/coalesce.c Backend/idempotency.c \
     -o mentor_backend \
-    -lmicrohttpd -lcjson -std=c11 -Wall -Wextra -g
+    -lmicrohttpd -lcjson -lcrypt -lm -lpthread -std=c11 -Wall -Wextra -g
 
 if [ $? -eq 0 ]; then
   echo "Compilation successful! Executable: mentor_backend"
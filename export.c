@@ -0,0 +1,323 @@
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>    // For strcasecmp
+#include <time.h>
+#include <limits.h>     // For LLONG_MIN, LLONG_MAX
+#include <cjson/cJSON.h>
+#include "export.h"
+#include "arena.h"
+#include "json_helpers.h"
+#include "logger.h"
+
+#define EXPORT_PRINT_BUFFER 4096    // Initial size of the reused print buffer
+#define EXPORT_SNAPSHOT_CHUNK (256 * 1024)
+
+struct ExportSnapshot {
+    Arena* arena;           // Every copied record and string
+    int next_mentee_id;
+    int next_meeting_id;
+    int next_issue_id;
+    int next_user_id;
+    Mentee* mentees;
+    Meeting* meetings;      // In start-time order
+    Issue* issues;
+    User* users;            // password_hash is always NULL
+};
+
+// Output state shared by every record of one export
+typedef struct {
+    FILE* out;
+    ExportFormat format;
+    char* buffer;           // Reused for every record, grown on demand
+    size_t capacity;
+    int first_in_array;     // JSON: no comma before the next element
+    int ok;
+} ExportWriter;
+
+/**
+ * @brief Prints 'item' into the reused buffer, growing it as needed. Frees 'item'.
+ */
+static int print_item(ExportWriter* writer, cJSON* item) {
+    if (!item) {
+        writer->ok = 0;
+        return 0;
+    }
+    while (writer->ok && !cJSON_PrintPreallocated(item, writer->buffer, (int)writer->capacity, 0)) {
+        size_t grown = writer->capacity * 2;
+        char* buffer = grown <= (size_t)0x7fffffff ? realloc(writer->buffer, grown) : NULL;
+        if (!buffer) {
+            writer->ok = 0;
+            break;
+        }
+        writer->buffer = buffer;
+        writer->capacity = grown;
+    }
+    cJSON_Delete(item);
+    return writer->ok;
+}
+
+static void write_item(ExportWriter* writer, cJSON* item) {
+    if (!print_item(writer, item)) return;
+    if (writer->format == EXPORT_FORMAT_JSON && !writer->first_in_array && fputc(',', writer->out) == EOF) writer->ok = 0;
+    writer->first_in_array = 0;
+    if (fputs(writer->buffer, writer->out) == EOF) writer->ok = 0;
+    if (writer->format == EXPORT_FORMAT_NDJSON && fputc('\n', writer->out) == EOF) writer->ok = 0;
+}
+
+/**
+ * @brief NDJSON tags each record with its type; JSON opens the array it goes in.
+ */
+static void begin_collection(ExportWriter* writer, const char* name) {
+    if (writer->format != EXPORT_FORMAT_JSON) return;
+    if (fprintf(writer->out, ",\"%s\":[", name) < 0) writer->ok = 0;
+    writer->first_in_array = 1;
+}
+
+static void end_collection(ExportWriter* writer) {
+    if (writer->format == EXPORT_FORMAT_JSON && fputc(']', writer->out) == EOF) writer->ok = 0;
+}
+
+static cJSON* tag_record(ExportWriter* writer, cJSON* record, const char* type) {
+    if (record && writer->format == EXPORT_FORMAT_NDJSON && !cJSON_AddStringToObject(record, "type", type)) {
+        cJSON_Delete(record);
+        return NULL;
+    }
+    return record;
+}
+
+// ========================================================================== //
+//                                SNAPSHOT                                    //
+// ========================================================================== //
+
+// Copies 'src' into '*dst'; 0 only if out of memory (NULL copies as NULL)
+static int copy_string(Arena* arena, char** dst, const char* src) {
+    *dst = arena_strdup(arena, src);
+    return !src || *dst;
+}
+
+static int copy_notes(Arena* arena, Note** dst, const Note* src) {
+    *dst = NULL;
+    Note** tail = dst;
+    for (; src; src = src->next) {
+        Note* note = arena_alloc(arena, sizeof(Note));
+        if (!note || !copy_string(arena, &note->text, src->text)) return 0;
+        note->timestamp = src->timestamp;
+        note->next = NULL;
+        *tail = note;
+        tail = &note->next;
+    }
+    return 1;
+}
+
+// Appends meetings in the order the time index visits them
+typedef struct {
+    Arena* arena;
+    Meeting** tail;
+    int ok;
+} MeetingCopy;
+
+static int copy_meeting(const Meeting* src, void* ctx) {
+    MeetingCopy* copy = ctx;
+    Meeting* meeting = arena_alloc(copy->arena, sizeof(Meeting));
+    if (!meeting) return copy->ok = 0;
+    *meeting = *src;
+    meeting->next = NULL;
+    if (!copy_string(copy->arena, &meeting->mentee_name, src->mentee_name) ||
+        !copy_string(copy->arena, &meeting->date_str, src->date_str) ||
+        !copy_string(copy->arena, &meeting->time_str, src->time_str) ||
+        !copy_string(copy->arena, &meeting->notes, src->notes)) {
+        return copy->ok = 0;
+    }
+    *copy->tail = meeting;
+    copy->tail = &meeting->next;
+    return 1;
+}
+
+static int copy_records(ExportSnapshot* snapshot, const AppData* data) {
+    Arena* arena = snapshot->arena;
+    Mentee** mentee_tail = &snapshot->mentees;
+    for (const Mentee* src = data->mentees_head; src; src = src->next) {
+        Mentee* mentee = arena_alloc(arena, sizeof(Mentee));
+        if (!mentee) return 0;
+        *mentee = *src;
+        mentee->next = NULL;
+        if (!copy_string(arena, &mentee->name, src->name) ||
+            !copy_string(arena, &mentee->subject, src->subject) ||
+            !copy_string(arena, &mentee->email, src->email) ||
+            !copy_notes(arena, &mentee->general_notes, src->general_notes)) {
+            return 0;
+        }
+        *mentee_tail = mentee;
+        mentee_tail = &mentee->next;
+    }
+
+    MeetingCopy meetings = { arena, &snapshot->meetings, 1 };
+    for_each_meeting_in_range(data, 0, (time_t)LLONG_MIN, (time_t)LLONG_MAX, copy_meeting, &meetings);
+    if (!meetings.ok) return 0;
+
+    Issue** issue_tail = &snapshot->issues;
+    for (const Issue* src = data->issues_head; src; src = src->next) {
+        Issue* issue = arena_alloc(arena, sizeof(Issue));
+        if (!issue) return 0;
+        *issue = *src;
+        issue->next = issue->bucket_prev = issue->bucket_next = NULL;
+        if (!copy_string(arena, &issue->mentee_name, src->mentee_name) ||
+            !copy_string(arena, &issue->description, src->description) ||
+            !copy_string(arena, &issue->date_reported_str, src->date_reported_str) ||
+            !copy_notes(arena, &issue->response_notes, src->response_notes)) {
+            return 0;
+        }
+        *issue_tail = issue;
+        issue_tail = &issue->next;
+    }
+
+    User** user_tail = &snapshot->users;
+    for (const User* src = data->users_head; src; src = src->next) {
+        User* user = arena_alloc(arena, sizeof(User));
+        if (!user) return 0;
+        *user = *src;
+        user->password_hash = NULL; // Never leaves the server
+        user->next = NULL;
+        if (!copy_string(arena, &user->username, src->username)) return 0;
+        *user_tail = user;
+        user_tail = &user->next;
+    }
+    return 1;
+}
+
+ExportSnapshot* export_snapshot_create(const AppData* data) {
+    if (!data) return NULL;
+    ExportSnapshot* snapshot = calloc(1, sizeof(ExportSnapshot));
+    if (!snapshot) return NULL;
+    snapshot->arena = arena_create(EXPORT_SNAPSHOT_CHUNK);
+    snapshot->next_mentee_id = data->next_mentee_id;
+    snapshot->next_meeting_id = data->next_meeting_id;
+    snapshot->next_issue_id = data->next_issue_id;
+    snapshot->next_user_id = data->next_user_id;
+    if (!snapshot->arena || !copy_records(snapshot, data)) {
+        LOG_ERROR("export_snapshot_create: Out of memory copying the data.");
+        export_snapshot_free(snapshot);
+        return NULL;
+    }
+    return snapshot;
+}
+
+void export_snapshot_free(ExportSnapshot* snapshot) {
+    if (!snapshot) return;
+    arena_free(snapshot->arena);
+    free(snapshot);
+}
+
+// ========================================================================== //
+//                                 WRITING                                    //
+// ========================================================================== //
+
+static cJSON* meta_to_json(const ExportSnapshot* data) {
+    cJSON* meta = cJSON_CreateObject();
+    if (!meta) return NULL;
+    if (!cJSON_AddNumberToObject(meta, "exported_at", (double)time(NULL)) ||
+        !cJSON_AddNumberToObject(meta, "next_mentee_id", data->next_mentee_id) ||
+        !cJSON_AddNumberToObject(meta, "next_meeting_id", data->next_meeting_id) ||
+        !cJSON_AddNumberToObject(meta, "next_issue_id", data->next_issue_id) ||
+        !cJSON_AddNumberToObject(meta, "next_user_id", data->next_user_id)) {
+        cJSON_Delete(meta);
+        return NULL;
+    }
+    return meta;
+}
+
+/**
+ * @brief Meetings go out in start-time order, so an overlap is always with an
+ * earlier line; '*busy_until' is the latest end among those written so far.
+ */
+static cJSON* meeting_record(ExportWriter* writer, const Meeting* meeting, time_t* busy_until) {
+    cJSON* record = tag_record(writer, meeting_to_json(meeting), "meeting");
+    time_t end = meeting->start_time + (time_t)meeting->duration_minutes * 60;
+    if (record && writer->format == EXPORT_FORMAT_NDJSON && meeting->start_time > 0) {
+        // Re-imported as is, it would be rejected as the conflict it already is
+        if (meeting->start_time < *busy_until && !cJSON_AddTrueToObject(record, "allow_conflict")) {
+            cJSON_Delete(record);
+            record = NULL;
+        }
+        if (end > *busy_until) *busy_until = end;
+    }
+    return record;
+}
+
+/**
+ * @brief NDJSON issue records carry their notes as "response_notes": the import
+ * reads "notes" as text, and an array there would fail the whole line.
+ */
+static cJSON* issue_record(ExportWriter* writer, const Issue* issue) {
+    cJSON* record = issue_to_json(issue);
+    if (record && writer->format == EXPORT_FORMAT_NDJSON) {
+        cJSON* notes = cJSON_DetachItemFromObjectCaseSensitive(record, "notes");
+        if (notes && !cJSON_AddItemToObject(record, "response_notes", notes)) {
+            cJSON_Delete(notes);
+            cJSON_Delete(record);
+            return NULL;
+        }
+    }
+    return tag_record(writer, record, "issue");
+}
+
+int export_write(const ExportSnapshot* data, ExportFormat format, FILE* out) {
+    if (!data || !out) return 0;
+    ExportWriter writer = { out, format, malloc(EXPORT_PRINT_BUFFER), EXPORT_PRINT_BUFFER, 1, 1 };
+    if (!writer.buffer) return 0;
+
+    // Header: the NDJSON meta line, or the JSON document's counters left open for the collections
+    cJSON* meta = meta_to_json(data);
+    if (format == EXPORT_FORMAT_NDJSON) {
+        write_item(&writer, tag_record(&writer, meta, "meta"));
+    } else if (print_item(&writer, meta)) {
+        size_t len = strlen(writer.buffer);
+        if (fwrite(writer.buffer, 1, len - 1, out) != len - 1) writer.ok = 0; // Without the closing brace
+    }
+
+    begin_collection(&writer, "mentees");
+    for (const Mentee* m = data->mentees; m && writer.ok; m = m->next) {
+        write_item(&writer, tag_record(&writer, mentee_to_json(m), "mentee"));
+    }
+    end_collection(&writer);
+
+    begin_collection(&writer, "meetings");
+    time_t busy_until = 0;
+    for (const Meeting* m = data->meetings; m && writer.ok; m = m->next) {
+        write_item(&writer, meeting_record(&writer, m, &busy_until));
+    }
+    end_collection(&writer);
+
+    begin_collection(&writer, "issues");
+    for (const Issue* i = data->issues; i && writer.ok; i = i->next) {
+        write_item(&writer, issue_record(&writer, i));
+    }
+    end_collection(&writer);
+
+    begin_collection(&writer, "users");
+    for (const User* u = data->users; u && writer.ok; u = u->next) {
+        cJSON* user = user_to_json(u);
+        if (user) cJSON_DeleteItemFromObjectCaseSensitive(user, "passwordHash"); // Never leaves the server
+        write_item(&writer, tag_record(&writer, user, "user"));
+    }
+    end_collection(&writer);
+
+    if (format == EXPORT_FORMAT_JSON && writer.ok && fputs("}\n", out) == EOF) writer.ok = 0;
+    if (fflush(out) != 0) writer.ok = 0;
+    free(writer.buffer);
+    if (!writer.ok) LOG_ERROR("export_write: Failed to write the export.");
+    return writer.ok;
+}
+
+int export_parse_format(const char* value, ExportFormat* out) {
+    if (!value) return 0;
+    if (strcasecmp(value, "ndjson") == 0 || strcasecmp(value, "jsonl") == 0) {
+        *out = EXPORT_FORMAT_NDJSON;
+        return 1;
+    }
+    if (strcasecmp(value, "json") == 0) {
+        *out = EXPORT_FORMAT_JSON;
+        return 1;
+    }
+    return 0;
+}
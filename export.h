@@ -0,0 +1,40 @@
+#ifndef EXPORT_H
+#define EXPORT_H
+
+#include <stdio.h>
+#include "mentorship_data.h"
+
+typedef enum {
+    EXPORT_FORMAT_NDJSON,   // A "meta" line, then one object per record tagged with "type"
+    EXPORT_FORMAT_JSON      // One document shaped like the data file
+} ExportFormat;
+
+/**
+ * @brief A private copy of every record an export writes, so the data lock can
+ * be released before the (much slower) formatting and writing.
+ */
+typedef struct ExportSnapshot ExportSnapshot;
+
+/**
+ * @brief Copies the records of 'data' (users without passwords). The caller
+ * holds the data lock, shared is enough: this is O(n) pointer chasing and
+ * copying, with no formatting or I/O. NULL if out of memory.
+ */
+ExportSnapshot* export_snapshot_create(const AppData* data);
+void export_snapshot_free(ExportSnapshot* snapshot);
+
+/**
+ * @brief Writes the snapshot's mentees, meetings, issues and users to 'out'
+ * one record at a time. Needs no lock. Returns 1 on success.
+ *
+ * NDJSON records use the same field names as the import endpoints, so the
+ * lines of one type can be fed back to /api/import: mentees, meetings (in
+ * start-time order, "allow_conflict" set on those overlapping an earlier one)
+ * and issues with their status. IDs are reassigned on import, and notes other
+ * than a meeting's are not imported (issue notes are exported as "response_notes").
+ */
+int export_write(const ExportSnapshot* snapshot, ExportFormat format, FILE* out);
+
+int export_parse_format(const char* value, ExportFormat* out); // "ndjson"/"jsonl" or "json"
+
+#endif // EXPORT_H
@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "idempotency.h"
+#include "logger.h"
+
+#define IDEMPOTENCY_BUCKETS 8192 // Hash buckets (power of two), twice IDEMPOTENCY_MAX_ENTRIES
+
+typedef struct IdempotencyEntry {
+    char key[IDEMPOTENCY_SCOPED_KEY_MAX];
+    uint64_t fingerprint;
+    unsigned int status;
+    char *body;
+    size_t body_length;
+    time_t expires_at;
+    struct IdempotencyEntry *next;  // Hash chain
+    struct IdempotencyEntry *newer; // Insertion order; with one TTL for all, also expiry order
+} IdempotencyEntry;
+
+static IdempotencyEntry *entries[IDEMPOTENCY_BUCKETS];
+static IdempotencyEntry *oldest = NULL;
+static IdempotencyEntry *newest = NULL;
+static size_t entry_count = 0;
+static unsigned long long replayed_count = 0;
+static pthread_mutex_t entries_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint64_t fnv1a64(const unsigned char *data, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; ++i) hash = (hash ^ data[i]) * 1099511628211ull;
+    return hash;
+}
+
+uint64_t idempotency_fingerprint(const char *data, size_t length) {
+    return data ? fnv1a64((const unsigned char *)data, length) : 0;
+}
+
+static size_t key_bucket(const char *key) {
+    return fnv1a64((const unsigned char *)key, strlen(key)) & (IDEMPOTENCY_BUCKETS - 1);
+}
+
+static IdempotencyEntry *find_entry(const char *key) {
+    for (IdempotencyEntry *entry = entries[key_bucket(key)]; entry; entry = entry->next) {
+        if (0 == strcmp(entry->key, key)) return entry;
+    }
+    return NULL;
+}
+
+// Drops the oldest entry. Caller holds entries_lock.
+static void evict_oldest(void) {
+    IdempotencyEntry *victim = oldest;
+    if (!victim) return;
+    for (IdempotencyEntry **link = &entries[key_bucket(victim->key)]; *link; link = &(*link)->next) {
+        if (*link == victim) {
+            *link = victim->next;
+            break;
+        }
+    }
+    oldest = victim->newer;
+    if (!oldest) newest = NULL;
+    entry_count--;
+    free(victim->body);
+    free(victim);
+}
+
+// Caller holds entries_lock
+static void evict_expired(time_t now) {
+    while (oldest && oldest->expires_at <= now) evict_oldest();
+}
+
+IdempotencyLookup idempotency_lookup(const char *key, uint64_t fingerprint, unsigned int *status, char **body, size_t *body_length) {
+    pthread_mutex_lock(&entries_lock);
+    evict_expired(time(NULL));
+    IdempotencyEntry *entry = find_entry(key);
+    IdempotencyLookup result = IDEMPOTENCY_MISS;
+    if (entry && entry->fingerprint != fingerprint) {
+        result = IDEMPOTENCY_MISMATCH;
+    } else if (entry && (*body = malloc(entry->body_length + 1))) {
+        memcpy(*body, entry->body, entry->body_length + 1);
+        *body_length = entry->body_length;
+        *status = entry->status;
+        replayed_count++;
+        result = IDEMPOTENCY_HIT;
+    }
+    pthread_mutex_unlock(&entries_lock);
+    return result;
+}
+
+int idempotency_store(const char *key, uint64_t fingerprint, unsigned int status, const char *body, size_t body_length) {
+    if (strlen(key) >= IDEMPOTENCY_SCOPED_KEY_MAX) return 0;
+    IdempotencyEntry *entry = calloc(1, sizeof(IdempotencyEntry));
+    if (!entry || !(entry->body = malloc(body_length + 1))) {
+        free(entry);
+        LOG_WARN("[IDEMPOTENCY] Out of memory; a retry of this request will run again.");
+        return 0;
+    }
+    strcpy(entry->key, key);
+    entry->fingerprint = fingerprint;
+    entry->status = status;
+    memcpy(entry->body, body, body_length);
+    entry->body[body_length] = '\0';
+    entry->body_length = body_length;
+
+    pthread_mutex_lock(&entries_lock);
+    time_t now = time(NULL);
+    evict_expired(now);
+    if (find_entry(key)) { // Only if two requests raced with the same key; the first answer stands
+        pthread_mutex_unlock(&entries_lock);
+        free(entry->body);
+        free(entry);
+        return 1;
+    }
+    if (entry_count >= IDEMPOTENCY_MAX_ENTRIES) evict_oldest();
+    entry->expires_at = now + IDEMPOTENCY_TTL_SECONDS;
+    size_t bucket = key_bucket(key);
+    entry->next = entries[bucket];
+    entries[bucket] = entry;
+    if (newest) newest->newer = entry;
+    else oldest = entry;
+    newest = entry;
+    entry_count++;
+    pthread_mutex_unlock(&entries_lock);
+    return 1;
+}
+
+void idempotency_get_stats(IdempotencyStats *stats) {
+    pthread_mutex_lock(&entries_lock);
+    stats->entries = entry_count;
+    stats->replayed = replayed_count;
+    pthread_mutex_unlock(&entries_lock);
+}
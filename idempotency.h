@@ -0,0 +1,44 @@
+#ifndef IDEMPOTENCY_H
+#define IDEMPOTENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define IDEMPOTENCY_KEY_MAX 256                 // Idempotency-Key header value, NUL included
+#define IDEMPOTENCY_SCOPED_KEY_MAX (IDEMPOTENCY_KEY_MAX + 32) // Plus the user and route it is scoped to
+#define IDEMPOTENCY_MAX_ENTRIES 4096            // Remembered responses; the oldest go first
+#define IDEMPOTENCY_TTL_SECONDS (24 * 60 * 60)  // How long a retry can still be answered from memory
+
+typedef enum {
+    IDEMPOTENCY_MISS,       // Unknown or expired key: execute the request
+    IDEMPOTENCY_HIT,        // Same key and body: answer with the stored response
+    IDEMPOTENCY_MISMATCH    // Same key, different body: a client bug, answer 422
+} IdempotencyLookup;
+
+typedef struct {
+    size_t entries;
+    unsigned long long replayed;
+} IdempotencyStats;
+
+/**
+ * @brief Hash of a request body, stored with its response so a key reused
+ * for a different request is caught instead of answered with the wrong result.
+ */
+uint64_t idempotency_fingerprint(const char *data, size_t length);
+
+/**
+ * @brief Looks up 'key' (already scoped to its user and route). On a hit,
+ * '*body' receives a malloc'd copy of the stored body (caller frees) and
+ * '*body_length' and '*status' are filled in.
+ */
+IdempotencyLookup idempotency_lookup(const char *key, uint64_t fingerprint, unsigned int *status, char **body, size_t *body_length);
+
+/**
+ * @brief Remembers the response to 'key' for IDEMPOTENCY_TTL_SECONDS, evicting
+ * the oldest entry when full. Returns 1 if stored, 0 if out of memory.
+ */
+int idempotency_store(const char *key, uint64_t fingerprint, unsigned int status, const char *body, size_t body_length);
+
+void idempotency_get_stats(IdempotencyStats *stats);
+
+#endif // IDEMPOTENCY_H
@@ -0,0 +1,379 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>    // For strcasecmp, strncasecmp
+#include <ctype.h>
+#include "import.h"
+#include "arena.h"
+
+#define IMPORT_MAX_COLUMNS 32
+#define IMPORT_ARENA_CHUNK (64 * 1024)   // Strings of one batch
+
+static const char* const field_names[IMPORT_FIELD_COUNT] = {
+    "name", "subject", "email", "mentee", "date", "time", "duration",
+    "notes", "description", "priority", "allow_conflict", "status",
+};
+
+// Fields a line must set (non-empty) to be applied, per kind
+static const unsigned int required_fields[IMPORT_KIND_COUNT] = {
+    [IMPORT_MENTEES] = 1u << IMPORT_FIELD_NAME | 1u << IMPORT_FIELD_SUBJECT,
+    [IMPORT_MEETINGS] = 1u << IMPORT_FIELD_MENTEE | 1u << IMPORT_FIELD_DATE | 1u << IMPORT_FIELD_TIME | 1u << IMPORT_FIELD_DURATION,
+    [IMPORT_ISSUES] = 1u << IMPORT_FIELD_MENTEE | 1u << IMPORT_FIELD_DESCRIPTION | 1u << IMPORT_FIELD_PRIORITY | 1u << IMPORT_FIELD_DATE,
+};
+
+static const char* const kind_names[IMPORT_KIND_COUNT] = { "mentees", "meetings", "issues" };
+
+typedef struct {
+    long line;
+    const char* message;    // Static string
+} ImportError;
+
+struct ImportJob {
+    ImportKind kind;
+    ImportFormat format;
+    const char* fatal;                  // Static string; stops the import
+
+    // Line reassembly across chunks
+    char line[IMPORT_MAX_LINE];
+    size_t line_len;
+    int line_too_long;                  // Discarding the rest of an overlong line
+    long line_number;                   // Lines seen so far (including the CSV header)
+
+    // CSV header: field of each column, or -1 to ignore the column
+    int have_header;
+    int column_count;
+    int columns[IMPORT_MAX_COLUMNS];
+
+    // Current batch; record values live in 'arena'
+    ImportRecord records[IMPORT_BATCH_SIZE];
+    size_t record_count;
+    Arena* arena;
+
+    // Totals for the report
+    long imported;
+    long failed;
+    int error_count;
+    ImportError errors[IMPORT_MAX_ERRORS];
+};
+
+// ========================================================================== //
+//                                 HELPERS                                    //
+// ========================================================================== //
+
+static void record_error(ImportJob* job, long line, const char* message) {
+    job->failed++;
+    if (job->error_count < IMPORT_MAX_ERRORS) {
+        job->errors[job->error_count].line = line;
+        job->errors[job->error_count].message = message;
+        job->error_count++;
+    }
+}
+
+static int field_from_name(const char* name, size_t len) {
+    for (int f = 0; f < IMPORT_FIELD_COUNT; ++f) {
+        if (strlen(field_names[f]) == len && strncasecmp(field_names[f], name, len) == 0) return f;
+    }
+    return -1;
+}
+
+static char* arena_strndup(Arena* arena, const char* s, size_t len) {
+    char* copy = arena_alloc(arena, len + 1);
+    if (!copy) return NULL;
+    memcpy(copy, s, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+/**
+ * @brief Checks the kind's required fields and queues the record.
+ */
+static void queue_record(ImportJob* job, ImportRecord* record) {
+    unsigned int required = required_fields[job->kind];
+    for (int f = 0; f < IMPORT_FIELD_COUNT; ++f) {
+        if ((required & (1u << f)) && (!record->values[f] || record->values[f][0] == '\0')) {
+            switch (job->kind) {
+            case IMPORT_MENTEES: record_error(job, record->line, "Missing 'name' or 'subject'"); break;
+            case IMPORT_MEETINGS: record_error(job, record->line, "Missing fields (mentee, date, time, duration)"); break;
+            default: record_error(job, record->line, "Missing fields (mentee, description, priority, date)"); break;
+            }
+            return;
+        }
+    }
+    job->records[job->record_count++] = *record;
+}
+
+// ========================================================================== //
+//                                  NDJSON                                    //
+// ========================================================================== //
+
+static void parse_ndjson_line(ImportJob* job, const char* line, size_t len) {
+    cJSON* root = cJSON_ParseWithLength(line, len);
+    if (!cJSON_IsObject(root)) {
+        cJSON_Delete(root);
+        record_error(job, job->line_number, "Invalid JSON object");
+        return;
+    }
+
+    ImportRecord record;
+    memset(&record, 0, sizeof(record));
+    record.line = job->line_number;
+    const char* error = NULL;
+    for (int f = 0; f < IMPORT_FIELD_COUNT && !error; ++f) {
+        const cJSON* item = cJSON_GetObjectItemCaseSensitive(root, field_names[f]);
+        if (!item || cJSON_IsNull(item)) continue;
+        char number[32];
+        const char* text = NULL;
+        if (cJSON_IsString(item)) {
+            text = item->valuestring;
+        } else if (cJSON_IsNumber(item)) {
+            snprintf(number, sizeof(number), "%.15g", item->valuedouble);
+            text = number;
+        } else if (cJSON_IsBool(item)) {
+            text = cJSON_IsTrue(item) ? "true" : "false";
+        } else {
+            error = "Fields must be strings, numbers or booleans";
+            break;
+        }
+        record.values[f] = arena_strndup(job->arena, text, strlen(text));
+        if (!record.values[f]) error = "Out of memory";
+    }
+    cJSON_Delete(root);
+    if (error) record_error(job, record.line, error);
+    else queue_record(job, &record);
+}
+
+// ========================================================================== //
+//                                   CSV                                      //
+// ========================================================================== //
+
+/**
+ * @brief Splits one CSV line (RFC 4180 quoting, but quoted fields cannot span
+ * lines). Unquoted fields are trimmed. Returns the column count or -1.
+ */
+static int split_csv_line(const char* line, size_t len, Arena* arena, char** fields, int max_fields) {
+    int count = 0;
+    size_t i = 0;
+    for (;;) {
+        if (count == max_fields) return -1;
+        while (i < len && (line[i] == ' ' || line[i] == '\t')) i++;
+        char* value;
+        if (i < len && line[i] == '"') {
+            // Quoted: unescape "" into the copy, which is never longer than the source
+            value = arena_alloc(arena, len - i + 1);
+            if (!value) return -1;
+            size_t out = 0;
+            i++;
+            for (;;) {
+                if (i >= len) return -1; // Unterminated quote
+                if (line[i] == '"') {
+                    if (i + 1 < len && line[i + 1] == '"') { value[out++] = '"'; i += 2; continue; }
+                    i++;
+                    break;
+                }
+                value[out++] = line[i++];
+            }
+            value[out] = '\0';
+            while (i < len && (line[i] == ' ' || line[i] == '\t')) i++;
+            if (i < len && line[i] != ',') return -1;
+        } else {
+            size_t start = i;
+            while (i < len && line[i] != ',') i++;
+            size_t end = i;
+            while (end > start && (line[end - 1] == ' ' || line[end - 1] == '\t')) end--;
+            value = arena_strndup(arena, line + start, end - start);
+            if (!value) return -1;
+        }
+        fields[count++] = value;
+        if (i >= len) break;
+        i++; // Skip the comma
+    }
+    return count;
+}
+
+static void parse_csv_header(ImportJob* job, const char* line, size_t len) {
+    char* names[IMPORT_MAX_COLUMNS];
+    int count = split_csv_line(line, len, job->arena, names, IMPORT_MAX_COLUMNS);
+    if (count < 0) {
+        job->fatal = "Invalid CSV header";
+        return;
+    }
+    unsigned int present = 0;
+    for (int c = 0; c < count; ++c) {
+        job->columns[c] = field_from_name(names[c], strlen(names[c]));
+        if (job->columns[c] >= 0) present |= 1u << job->columns[c];
+    }
+    if ((present & required_fields[job->kind]) != required_fields[job->kind]) {
+        switch (job->kind) {
+        case IMPORT_MENTEES: job->fatal = "CSV header must name the columns name and subject"; break;
+        case IMPORT_MEETINGS: job->fatal = "CSV header must name the columns mentee, date, time and duration"; break;
+        default: job->fatal = "CSV header must name the columns mentee, description, priority and date"; break;
+        }
+        return;
+    }
+    job->column_count = count;
+    job->have_header = 1;
+    arena_reset(job->arena); // Header names are no longer needed
+}
+
+static void parse_csv_line(ImportJob* job, const char* line, size_t len) {
+    if (!job->have_header) {
+        parse_csv_header(job, line, len);
+        return;
+    }
+    char* fields[IMPORT_MAX_COLUMNS];
+    int count = split_csv_line(line, len, job->arena, fields, IMPORT_MAX_COLUMNS);
+    if (count < 0) {
+        record_error(job, job->line_number, "Invalid CSV line");
+        return;
+    }
+    if (count != job->column_count) {
+        record_error(job, job->line_number, "Column count does not match the header");
+        return;
+    }
+    ImportRecord record;
+    memset(&record, 0, sizeof(record));
+    record.line = job->line_number;
+    for (int c = 0; c < count; ++c) {
+        if (job->columns[c] >= 0) record.values[job->columns[c]] = fields[c];
+    }
+    queue_record(job, &record);
+}
+
+// ========================================================================== //
+//                                 LINES                                      //
+// ========================================================================== //
+
+static void parse_line(ImportJob* job, const char* line, size_t len) {
+    job->line_number++;
+    if (len > 0 && line[len - 1] == '\r') len--;
+    size_t start = 0;
+    while (start < len && isspace((unsigned char)line[start])) start++;
+    if (start == len) return; // Blank lines are skipped
+    if (job->format == IMPORT_FORMAT_CSV) parse_csv_line(job, line, len);
+    else parse_ndjson_line(job, line + start, len - start);
+}
+
+ImportJob* import_job_create(ImportKind kind, ImportFormat format) {
+    if (kind < 0 || kind >= IMPORT_KIND_COUNT) return NULL;
+    ImportJob* job = calloc(1, sizeof(ImportJob));
+    if (!job) return NULL;
+    job->kind = kind;
+    job->format = format;
+    job->arena = arena_create(IMPORT_ARENA_CHUNK);
+    if (!job->arena) {
+        free(job);
+        return NULL;
+    }
+    return job;
+}
+
+void import_job_free(ImportJob* job) {
+    if (!job) return;
+    arena_free(job->arena);
+    free(job);
+}
+
+size_t import_job_feed(ImportJob* job, const char* data, size_t size) {
+    size_t used = 0;
+    while (used < size && !job->fatal && job->record_count < IMPORT_BATCH_SIZE) {
+        const char* newline = memchr(data + used, '\n', size - used);
+        size_t piece = newline ? (size_t)(newline - (data + used)) : size - used;
+
+        if (job->line_too_long) {
+            // Still inside an overlong line: drop bytes up to its end
+            if (newline) job->line_too_long = 0;
+        } else if (job->line_len + piece > IMPORT_MAX_LINE) {
+            job->line_number++;
+            record_error(job, job->line_number, "Line too long");
+            job->line_len = 0;
+            job->line_too_long = !newline;
+        } else if (newline && job->line_len == 0) {
+            parse_line(job, data + used, piece); // Whole line in this chunk: no copy
+        } else {
+            memcpy(job->line + job->line_len, data + used, piece);
+            job->line_len += piece;
+            if (newline) {
+                parse_line(job, job->line, job->line_len);
+                job->line_len = 0;
+            }
+        }
+        used += newline ? piece + 1 : piece;
+    }
+    return job->fatal ? size : used; // After a fatal error the rest is discarded
+}
+
+void import_job_finish(ImportJob* job) {
+    if (job->fatal || job->line_too_long || job->line_len == 0) return;
+    parse_line(job, job->line, job->line_len);
+    job->line_len = 0;
+    if (job->format == IMPORT_FORMAT_CSV && !job->have_header && !job->fatal) job->fatal = "Missing CSV header";
+}
+
+int import_job_batch_full(const ImportJob* job) {
+    return job->record_count >= IMPORT_BATCH_SIZE;
+}
+
+const char* import_job_fatal_error(const ImportJob* job) {
+    return job->fatal;
+}
+
+void import_job_apply(ImportJob* job, ImportApplyFn apply, void* ctx) {
+    for (size_t i = 0; i < job->record_count; ++i) {
+        const char* error = apply(&job->records[i], ctx);
+        if (error) record_error(job, job->records[i].line, error);
+        else job->imported++;
+    }
+    job->record_count = 0;
+    arena_reset(job->arena);
+}
+
+static int compare_errors(const void* a, const void* b) {
+    long la = ((const ImportError*)a)->line, lb = ((const ImportError*)b)->line;
+    return (la > lb) - (la < lb);
+}
+
+cJSON* import_job_report(const ImportJob* job) {
+    cJSON* report = cJSON_CreateObject();
+    if (!report) return NULL;
+    cJSON_AddStringToObject(report, "kind", kind_names[job->kind]);
+    cJSON_AddStringToObject(report, "format", job->format == IMPORT_FORMAT_CSV ? "csv" : "ndjson");
+    cJSON_AddNumberToObject(report, "lines", (double)job->line_number);
+    cJSON_AddNumberToObject(report, "imported", (double)job->imported);
+    cJSON_AddNumberToObject(report, "failed", (double)job->failed);
+    // Parse errors are recorded before the apply errors of their batch; list them by line
+    ImportError sorted[IMPORT_MAX_ERRORS];
+    memcpy(sorted, job->errors, (size_t)job->error_count * sizeof(ImportError));
+    qsort(sorted, (size_t)job->error_count, sizeof(ImportError), compare_errors);
+    cJSON* errors = cJSON_AddArrayToObject(report, "errors");
+    for (int i = 0; errors && i < job->error_count; ++i) {
+        cJSON* error = cJSON_CreateObject();
+        if (!error) break;
+        cJSON_AddNumberToObject(error, "line", (double)sorted[i].line);
+        cJSON_AddStringToObject(error, "error", sorted[i].message);
+        cJSON_AddItemToArray(errors, error);
+    }
+    cJSON_AddBoolToObject(report, "errors_truncated", job->failed > job->error_count);
+    return report;
+}
+
+long import_job_imported(const ImportJob* job) {
+    return job->imported;
+}
+
+int import_parse_format(const char* value, ImportFormat* out) {
+    if (!value) return 0;
+    if (strcasecmp(value, "csv") == 0 || strncasecmp(value, "text/csv", 8) == 0) {
+        *out = IMPORT_FORMAT_CSV;
+        return 1;
+    }
+    if (strcasecmp(value, "ndjson") == 0 || strcasecmp(value, "jsonl") == 0 ||
+        strncasecmp(value, "application/x-ndjson", 20) == 0 || strncasecmp(value, "application/jsonl", 17) == 0) {
+        *out = IMPORT_FORMAT_NDJSON;
+        return 1;
+    }
+    return 0;
+}
+
+const char* import_kind_name(ImportKind kind) {
+    return kind >= 0 && kind < IMPORT_KIND_COUNT ? kind_names[kind] : "unknown";
+}
@@ -0,0 +1,102 @@
+#ifndef IMPORT_H
+#define IMPORT_H
+
+#include <stddef.h>
+#include <cjson/cJSON.h>
+
+#define IMPORT_MAX_LINE 16384   // Longer lines are reported and skipped
+#define IMPORT_BATCH_SIZE 1000  // Records parsed before the caller has to apply them
+#define IMPORT_MAX_ERRORS 100   // Per-line errors kept for the report
+
+typedef enum {
+    IMPORT_MENTEES,
+    IMPORT_MEETINGS,
+    IMPORT_ISSUES,
+    IMPORT_KIND_COUNT
+} ImportKind;
+
+typedef enum {
+    IMPORT_FORMAT_NDJSON,   // One JSON object per line, same fields as the POST endpoints
+    IMPORT_FORMAT_CSV       // Header line naming the fields, then one record per line
+} ImportFormat;
+
+// Every field an import line may set; which ones are required depends on the kind
+typedef enum {
+    IMPORT_FIELD_NAME,
+    IMPORT_FIELD_SUBJECT,
+    IMPORT_FIELD_EMAIL,
+    IMPORT_FIELD_MENTEE,
+    IMPORT_FIELD_DATE,
+    IMPORT_FIELD_TIME,
+    IMPORT_FIELD_DURATION,
+    IMPORT_FIELD_NOTES,
+    IMPORT_FIELD_DESCRIPTION,
+    IMPORT_FIELD_PRIORITY,
+    IMPORT_FIELD_ALLOW_CONFLICT,
+    IMPORT_FIELD_STATUS,
+    IMPORT_FIELD_COUNT
+} ImportField;
+
+/**
+ * @brief One parsed line. Numbers and booleans arrive as strings ("45",
+ * "true"); values stay valid until the batch is applied.
+ */
+typedef struct {
+    long line;                                  // 1-based line number in the body
+    const char* values[IMPORT_FIELD_COUNT];     // NULL when the line does not set the field
+} ImportRecord;
+
+/**
+ * @brief Applies one record. Returns NULL on success or a static message,
+ * which is reported against the record's line.
+ */
+typedef const char* (*ImportApplyFn)(const ImportRecord* record, void* ctx);
+
+typedef struct ImportJob ImportJob;
+
+// --- Lifecycle ---
+ImportJob* import_job_create(ImportKind kind, ImportFormat format);
+void import_job_free(ImportJob* job);
+
+// --- Parsing ---
+/**
+ * @brief Parses as much of 'data' as fits in the current batch and returns the
+ * number of bytes consumed. When it is less than 'size' the batch is full:
+ * apply it and call again with the rest. A partial last line is kept for the
+ * next call.
+ */
+size_t import_job_feed(ImportJob* job, const char* data, size_t size);
+
+/**
+ * @brief Parses a final line that has no trailing newline. Call once, after the
+ * last import_job_feed(), then apply the remaining batch.
+ */
+void import_job_finish(ImportJob* job);
+
+int import_job_batch_full(const ImportJob* job);
+
+/**
+ * @brief Message of an error that stops the import (e.g. a CSV header without a
+ * required column), or NULL. Once set, further input is ignored.
+ */
+const char* import_job_fatal_error(const ImportJob* job);
+
+// --- Applying ---
+/**
+ * @brief Runs 'apply' on every pending record, counts the results and empties
+ * the batch. The caller provides whatever locking 'apply' needs.
+ */
+void import_job_apply(ImportJob* job, ImportApplyFn apply, void* ctx);
+
+/**
+ * @brief Summary for the response: lines, imported, failed and the first
+ * IMPORT_MAX_ERRORS per-line errors.
+ */
+cJSON* import_job_report(const ImportJob* job);
+long import_job_imported(const ImportJob* job);
+
+// --- Parameters ---
+int import_parse_format(const char* value, ImportFormat* out); // "ndjson"/"jsonl", "csv" or a MIME type
+const char* import_kind_name(ImportKind kind);
+
+#endif // IMPORT_H
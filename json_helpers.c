@@ -4,6 +4,7 @@
 #include <cjson/cJSON.h>
 #include "mentorship_data.h"
 #include "json_helpers.h"
+#include "logger.h"
 
 // Assume safe_strdup is available (defined in mentorship_data.c)
 extern char* safe_strdup(const char* s);
@@ -17,7 +18,7 @@ cJSON* note_to_json(const Note* note) {
     cJSON* json = cJSON_CreateObject(); if (!json) return NULL;
     if (!cJSON_AddStringToObject(json, "text", note->text ? note->text : "") ||
         !cJSON_AddNumberToObject(json, "timestamp", (double)note->timestamp))
-    { fprintf(stderr, "note_to_json: Failed add items.\n"); cJSON_Delete(json); return NULL; }
+    { LOG_ERROR("note_to_json: Failed add items."); cJSON_Delete(json); return NULL; }
     return json;
 }
 
@@ -27,7 +28,7 @@ cJSON* note_list_to_json_array(const Note* head) {
     while (current) {
         cJSON* note_json = note_to_json(current);
         if (!note_json || !cJSON_AddItemToArray(array, note_json)) {
-             fprintf(stderr, "note_list_to_json_array: Failed add item.\n");
+             LOG_ERROR("note_list_to_json_array: Failed add item.");
              cJSON_Delete(note_json); cJSON_Delete(array); return NULL;
         }
         current = current->next;
@@ -42,12 +43,12 @@ cJSON* mentee_to_json(const Mentee* mentee) {
         !cJSON_AddStringToObject(json, "name", mentee->name ? mentee->name : "") ||
         !cJSON_AddStringToObject(json, "subject", mentee->subject ? mentee->subject : "") ||
         !cJSON_AddStringToObject(json, "email", mentee->email ? mentee->email : ""))
-    { fprintf(stderr, "mentee_to_json: Failed add basic fields ID %d.\n", mentee->id); cJSON_Delete(json); return NULL; }
+    { LOG_ERROR("mentee_to_json: Failed add basic fields ID %d.", mentee->id); cJSON_Delete(json); return NULL; }
 
     cJSON* notes_array = note_list_to_json_array(mentee->general_notes);
-    if (!notes_array) { fprintf(stderr, "mentee_to_json: Failed create notes array ID %d.\n", mentee->id); cJSON_Delete(json); return NULL; }
+    if (!notes_array) { LOG_ERROR("mentee_to_json: Failed create notes array ID %d.", mentee->id); cJSON_Delete(json); return NULL; }
     if (!cJSON_AddItemToObject(json, "general_notes", notes_array)) {
-         fprintf(stderr, "mentee_to_json: Failed add notes array ID %d.\n", mentee->id);
+         LOG_ERROR("mentee_to_json: Failed add notes array ID %d.", mentee->id);
          cJSON_Delete(notes_array); cJSON_Delete(json); return NULL;
     }
     return json;
@@ -59,7 +60,7 @@ cJSON* mentee_list_to_json_array(const Mentee* head) {
     while (current) {
          cJSON* mentee_json = mentee_to_json(current);
          if (!mentee_json || !cJSON_AddItemToArray(array, mentee_json)) {
-              fprintf(stderr, "mentee_list_to_json_array: Failed add mentee %d.\n", current->id);
+              LOG_ERROR("mentee_list_to_json_array: Failed add mentee %d.", current->id);
               cJSON_Delete(mentee_json); cJSON_Delete(array); return NULL;
          }
         current = current->next;
@@ -78,7 +79,7 @@ cJSON* meeting_to_json(const Meeting* meeting) {
         !cJSON_AddStringToObject(json, "time", meeting->time_str ? meeting->time_str : "") ||
         !cJSON_AddNumberToObject(json, "duration", meeting->duration_minutes) ||
         !cJSON_AddStringToObject(json, "notes", meeting->notes ? meeting->notes : ""))
-    { fprintf(stderr, "meeting_to_json: Failed add fields ID %d.\n", meeting->id); cJSON_Delete(json); return NULL; }
+    { LOG_ERROR("meeting_to_json: Failed add fields ID %d.", meeting->id); cJSON_Delete(json); return NULL; }
     return json;
 }
 
@@ -88,7 +89,7 @@ cJSON* meeting_list_to_json_array(const Meeting* head) {
     while (current) {
         cJSON* meeting_json = meeting_to_json(current);
          if (!meeting_json || !cJSON_AddItemToArray(array, meeting_json)) {
-              fprintf(stderr, "meeting_list_to_json_array: Failed add meeting %d.\n", current->id);
+              LOG_ERROR("meeting_list_to_json_array: Failed add meeting %d.", current->id);
               cJSON_Delete(meeting_json); cJSON_Delete(array); return NULL;
          }
         current = current->next;
@@ -107,12 +108,12 @@ cJSON* issue_to_json(const Issue* issue) {
          !cJSON_AddStringToObject(json, "date", issue->date_reported_str ? issue->date_reported_str : "") ||
          !cJSON_AddStringToObject(json, "priority", priority_to_string(issue->priority)) ||
          !cJSON_AddStringToObject(json, "status", status_to_string(issue->status)))
-     { fprintf(stderr, "issue_to_json: Failed add basic fields ID %d.\n", issue->id); cJSON_Delete(json); return NULL; }
+     { LOG_ERROR("issue_to_json: Failed add basic fields ID %d.", issue->id); cJSON_Delete(json); return NULL; }
 
      cJSON* notes_array = note_list_to_json_array(issue->response_notes);
-     if (!notes_array) { fprintf(stderr, "issue_to_json: Failed create notes array ID %d.\n", issue->id); cJSON_Delete(json); return NULL; }
+     if (!notes_array) { LOG_ERROR("issue_to_json: Failed create notes array ID %d.", issue->id); cJSON_Delete(json); return NULL; }
      if (!cJSON_AddItemToObject(json, "notes", notes_array)) {
-         fprintf(stderr, "issue_to_json: Failed add notes array ID %d.\n", issue->id);
+         LOG_ERROR("issue_to_json: Failed add notes array ID %d.", issue->id);
          cJSON_Delete(notes_array); cJSON_Delete(json); return NULL;
      }
      return json;
@@ -124,7 +125,7 @@ cJSON* issue_list_to_json_array(const Issue* head) {
     while (current) {
          cJSON* issue_json = issue_to_json(current);
          if (!issue_json || !cJSON_AddItemToArray(array, issue_json)) {
-            fprintf(stderr, "issue_list_to_json_array: Failed add issue %d.\n", current->id);
+            LOG_ERROR("issue_list_to_json_array: Failed add issue %d.", current->id);
              cJSON_Delete(issue_json); cJSON_Delete(array); return NULL;
          }
         current = current->next;
@@ -133,18 +134,18 @@ cJSON* issue_list_to_json_array(const Issue* head) {
 }
 
 // Moved from mentorship_data.c for better organization
-// !! WARNING: Includes plain text password in JSON !!
+// Includes the password hash: callers sending users anywhere but the data file remove it
 cJSON* user_to_json(const User* user) {
      if (!user) return cJSON_CreateNull();
      cJSON* json = cJSON_CreateObject(); if (!json) return NULL;
 
      if (!cJSON_AddNumberToObject(json, "id", user->id) ||
          !cJSON_AddStringToObject(json, "username", user->username ? user->username : "") ||
-         !cJSON_AddStringToObject(json, "password", user->password ? user->password : "") || // !! SAVING PLAIN TEXT PASSWORD !!
+         !cJSON_AddStringToObject(json, "passwordHash", user->password_hash ? user->password_hash : "") ||
          !cJSON_AddStringToObject(json, "role", role_to_string(user->role)) ||
          !cJSON_AddNumberToObject(json, "associated_id", user->associated_id))
      {
-          fprintf(stderr, "user_to_json: Failed to add items to user object ID %d.\n", user->id);
+          LOG_ERROR("user_to_json: Failed to add items to user object ID %d.", user->id);
           cJSON_Delete(json); return NULL;
      }
      return json;
@@ -168,26 +169,16 @@ Note* json_array_to_notes(const cJSON* json_array) {
     cJSON_ArrayForEach(item, json_array) {
         if (!cJSON_IsObject(item)) continue; // Skip non-objects
 
-        Note* new_note = malloc(sizeof(Note));
-        if (!new_note) {
-            fprintf(stderr, "Malloc failed for Note struct during note list load.\n");
-            free_notes(head); // Free any notes already created
-            return NULL;
-        }
-        new_note->next = NULL;
-
         const cJSON* text_item = cJSON_GetObjectItemCaseSensitive(item, "text");
         const cJSON* time_item = cJSON_GetObjectItemCaseSensitive(item, "timestamp");
 
-        const char* text_val = cJSON_GetStringValue(text_item);
-        new_note->text = safe_strdup(text_val); // Handles NULL text_val
-        new_note->timestamp = (time_item && cJSON_IsNumber(time_item)) ? (time_t)time_item->valuedouble : 0;
-
-        // Check if strdup failed (but allow NULL text if original JSON was null/missing)
-        if (text_val && !new_note->text) {
-             fprintf(stderr, "Warning: strdup failed while loading note text. Skipping this note.\n");
-             free(new_note);
-             continue;
+        const char* text_val = cJSON_GetStringValue(text_item); // NULL text is allowed
+        time_t timestamp = (time_item && cJSON_IsNumber(time_item)) ? (time_t)time_item->valuedouble : 0;
+        Note* new_note = create_note(text_val, timestamp);
+        if (!new_note) {
+            LOG_ERROR("Allocation failed for note during note list load.");
+            free_notes(head); // Free any notes already created
+            return NULL;
         }
 
         // Append to list
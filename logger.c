@@ -0,0 +1,369 @@
+#define _GNU_SOURCE // For syscall(SYS_gettid)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdarg.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "logger.h"
+
+#define LOG_RING_SLOTS 256          // Per-thread capacity (power of two)
+#define LOG_MSG_MAX 256             // Longer messages are truncated
+#define LOG_FLUSH_INTERVAL_MS 20    // Writer wake-up period when nobody signals it
+
+// ========================================================================== //
+//                             DATA STRUCTURES                                //
+// ========================================================================== //
+
+typedef struct {
+    struct timespec ts;
+    int level;
+    long tid;           // Stored per record: a recycled ring may change owner before it drains
+    unsigned int len;
+    char msg[LOG_MSG_MAX];
+} LogRecord;
+
+/**
+ * Single-producer/single-consumer ring. The owning thread advances 'head', the
+ * writer thread advances 'tail'; both only ever grow (indices wrap via mask).
+ * Rings are never freed while the writer runs: when a thread exits its ring
+ * goes to a free pool and is handed to the next new thread.
+ */
+typedef struct LogRing {
+    LogRecord slots[LOG_RING_SLOTS];
+    size_t head;
+    size_t tail;
+    long tid;                   // Current owner
+    struct LogRing* next_all;   // Registry of every ring (prepend only)
+    struct LogRing* next_free;  // Free pool link
+} LogRing;
+
+// A pending record gathered by the writer for time-ordered output
+typedef struct {
+    LogRing* ring;
+    LogRecord* record;
+} PendingRecord;
+
+int log_runtime_level = LOG_LEVEL_INFO;
+
+static LogRing* all_rings = NULL;            // Read by the writer without the lock
+static LogRing* free_rings = NULL;
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t ring_key;
+static pthread_once_t ring_key_once = PTHREAD_ONCE_INIT;
+static __thread LogRing* tls_ring = NULL;
+
+static pthread_t writer_thread;
+static int writer_running = 0;               // Producers enqueue only while set
+static int writer_stop = 0;
+static pthread_mutex_t wake_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake_cond = PTHREAD_COND_INITIALIZER;
+
+static unsigned long long dropped_records = 0;
+static unsigned long long dropped_reported = 0;
+static int json_format = 0;
+
+static PendingRecord* pending = NULL;        // Writer-owned scratch array
+static size_t pending_capacity = 0;
+
+static const char* const level_names[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+static const char* const level_names_lower[] = { "debug", "info", "warn", "error" };
+
+// ========================================================================== //
+//                              RING REGISTRY                                 //
+// ========================================================================== //
+
+/**
+ * @brief pthread key destructor: returns the exiting thread's ring to the pool.
+ * Records still queued in it are drained later; the next owner just keeps
+ * appending after them.
+ */
+static void release_ring(void* ptr) {
+    LogRing* ring = ptr;
+    tls_ring = NULL;
+    pthread_mutex_lock(&registry_lock);
+    ring->next_free = free_rings;
+    free_rings = ring;
+    pthread_mutex_unlock(&registry_lock);
+}
+
+static void create_ring_key(void) {
+    pthread_key_create(&ring_key, release_ring);
+}
+
+static LogRing* acquire_ring(void) {
+    if (tls_ring) return tls_ring;
+    pthread_once(&ring_key_once, create_ring_key);
+
+    pthread_mutex_lock(&registry_lock);
+    LogRing* ring = free_rings;
+    if (ring) {
+        free_rings = ring->next_free;
+    } else {
+        ring = calloc(1, sizeof(LogRing));
+        if (ring) {
+            ring->next_all = all_rings;
+            __atomic_store_n(&all_rings, ring, __ATOMIC_RELEASE);
+        }
+    }
+    pthread_mutex_unlock(&registry_lock);
+    if (!ring) return NULL;
+
+    ring->tid = (long)syscall(SYS_gettid);
+    pthread_setspecific(ring_key, ring);
+    tls_ring = ring;
+    return ring;
+}
+
+// ========================================================================== //
+//                               FORMATTING                                   //
+// ========================================================================== //
+
+/**
+ * @brief Renders one record as a text or JSON line into buf. Returns its length.
+ */
+static size_t format_line(char* buf, size_t size, const struct timespec* ts, int level, long tid, const char* msg, size_t msg_len) {
+    // localtime_r takes a global lock; only redo it when the second changes
+    static __thread time_t cached_second = -1;
+    static __thread char cached_prefix[24];
+    static __thread size_t cached_len = 0;
+    if (ts->tv_sec != cached_second) {
+        struct tm tm_info;
+        time_t seconds = ts->tv_sec;
+        localtime_r(&seconds, &tm_info);
+        cached_len = strftime(cached_prefix, sizeof(cached_prefix), "%Y-%m-%d %H:%M:%S", &tm_info);
+        cached_second = ts->tv_sec;
+    }
+    char stamp[32];
+    memcpy(stamp, cached_prefix, cached_len);
+    snprintf(stamp + cached_len, sizeof(stamp) - cached_len, ".%03ld", ts->tv_nsec / 1000000);
+
+    int written;
+    if (!json_format) {
+        written = snprintf(buf, size, "%s %-5s [%ld] %.*s\n", stamp, level_names[level], tid, (int)msg_len, msg);
+    } else {
+        // Escape quotes, backslashes and control characters for the msg field
+        char escaped[LOG_MSG_MAX * 6];
+        size_t e = 0;
+        for (size_t i = 0; i < msg_len && e + 7 < sizeof(escaped); ++i) {
+            unsigned char c = (unsigned char)msg[i];
+            if (c == '"' || c == '\\') { escaped[e++] = '\\'; escaped[e++] = (char)c; }
+            else if (c < 0x20) e += (size_t)snprintf(escaped + e, sizeof(escaped) - e, "\\u%04x", c);
+            else escaped[e++] = (char)c;
+        }
+        written = snprintf(buf, size, "{\"ts\":\"%s\",\"level\":\"%s\",\"tid\":%ld,\"msg\":\"%.*s\"}\n",
+                           stamp, level_names_lower[level], tid, (int)e, escaped);
+    }
+    if (written < 0) return 0;
+    return ((size_t)written < size) ? (size_t)written : size - 1;
+}
+
+/**
+ * @brief Formats the caller's message into 'out'; strips trailing newlines.
+ */
+static unsigned int format_message(char* out, const char* fmt, va_list args) {
+    int n = vsnprintf(out, LOG_MSG_MAX, fmt, args);
+    if (n < 0) n = 0;
+    unsigned int len = (n < LOG_MSG_MAX) ? (unsigned int)n : LOG_MSG_MAX - 1;
+    if ((unsigned int)n >= LOG_MSG_MAX) memcpy(out + LOG_MSG_MAX - 4, "...", 3); // Mark truncation
+    while (len > 0 && (out[len - 1] == '\n' || out[len - 1] == '\r')) len--;
+    return len;
+}
+
+static void write_sync(int level, const char* msg, size_t msg_len) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    char line[LOG_MSG_MAX * 6 + 128];
+    size_t n = format_line(line, sizeof(line), &ts, level, (long)syscall(SYS_gettid), msg, msg_len);
+    FILE* out = (level >= LOG_LEVEL_WARN) ? stderr : stdout;
+    fwrite(line, 1, n, out);
+    fflush(out);
+}
+
+// ========================================================================== //
+//                                PRODUCER                                    //
+// ========================================================================== //
+
+void log_write(int level, const char* fmt, ...) {
+    if (level < LOG_LEVEL_DEBUG || level > LOG_LEVEL_ERROR || !fmt) return;
+    va_list args;
+    va_start(args, fmt);
+
+    LogRing* ring = __atomic_load_n(&writer_running, __ATOMIC_ACQUIRE) ? acquire_ring() : NULL;
+    if (!ring) {
+        char msg[LOG_MSG_MAX];
+        unsigned int len = format_message(msg, fmt, args);
+        va_end(args);
+        write_sync(level, msg, len);
+        return;
+    }
+
+    size_t head = ring->head; // Only this thread writes head
+    size_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (head - tail >= LOG_RING_SLOTS) {
+        va_end(args);
+        __atomic_fetch_add(&dropped_records, 1, __ATOMIC_RELAXED);
+        return; // Never block the request path on logging
+    }
+
+    LogRecord* record = &ring->slots[head & (LOG_RING_SLOTS - 1)];
+    clock_gettime(CLOCK_REALTIME, &record->ts);
+    record->level = level;
+    record->tid = ring->tid;
+    record->len = format_message(record->msg, fmt, args);
+    va_end(args);
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+
+    // Nudge the writer once per half-ring so bursts don't overflow between ticks
+    if (head - tail + 1 == LOG_RING_SLOTS / 2) pthread_cond_signal(&wake_cond);
+}
+
+// ========================================================================== //
+//                                 WRITER                                     //
+// ========================================================================== //
+
+static int compare_pending(const void* a, const void* b) {
+    const struct timespec* x = &((const PendingRecord*)a)->record->ts;
+    const struct timespec* y = &((const PendingRecord*)b)->record->ts;
+    if (x->tv_sec != y->tv_sec) return (x->tv_sec < y->tv_sec) ? -1 : 1;
+    if (x->tv_nsec != y->tv_nsec) return (x->tv_nsec < y->tv_nsec) ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief Writes every queued record (time-ordered across threads) and frees
+ * the slots. Only ever called by the single consumer.
+ */
+static void drain_rings(void) {
+    size_t count = 0;
+    for (LogRing* ring = __atomic_load_n(&all_rings, __ATOMIC_ACQUIRE); ring; ring = ring->next_all) {
+        size_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        for (size_t i = ring->tail; i != head; ++i) {
+            if (count == pending_capacity) {
+                size_t new_capacity = pending_capacity ? pending_capacity * 2 : 1024;
+                PendingRecord* grown = realloc(pending, new_capacity * sizeof(PendingRecord));
+                if (!grown) goto gathered; // Write what fits; the rest waits for the next pass
+                pending = grown;
+                pending_capacity = new_capacity;
+            }
+            pending[count].ring = ring;
+            pending[count].record = &ring->slots[i & (LOG_RING_SLOTS - 1)];
+            count++;
+        }
+    }
+gathered:
+    if (count > 0) qsort(pending, count, sizeof(PendingRecord), compare_pending);
+
+    int wrote_out = 0, wrote_err = 0;
+    char line[LOG_MSG_MAX * 6 + 128];
+    for (size_t i = 0; i < count; ++i) {
+        const LogRecord* record = pending[i].record;
+        size_t n = format_line(line, sizeof(line), &record->ts, record->level, record->tid, record->msg, record->len);
+        if (record->level >= LOG_LEVEL_WARN) { fwrite(line, 1, n, stderr); wrote_err = 1; }
+        else { fwrite(line, 1, n, stdout); wrote_out = 1; }
+    }
+    // Release slots only after formatting: records of one ring are contiguous from its tail
+    for (size_t i = 0; i < count; ++i) {
+        LogRing* ring = pending[i].ring;
+        __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+    }
+
+    unsigned long long dropped = __atomic_load_n(&dropped_records, __ATOMIC_RELAXED);
+    if (dropped != dropped_reported) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        char msg[96];
+        int len = snprintf(msg, sizeof(msg), "logger: %llu records dropped (ring full)", dropped - dropped_reported);
+        size_t n = format_line(line, sizeof(line), &ts, LOG_LEVEL_WARN, (long)syscall(SYS_gettid), msg, (size_t)len);
+        fwrite(line, 1, n, stderr);
+        wrote_err = 1;
+        dropped_reported = dropped;
+    }
+    if (wrote_out) fflush(stdout);
+    if (wrote_err) fflush(stderr);
+}
+
+static void* writer_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&wake_lock);
+    while (!writer_stop) {
+        pthread_mutex_unlock(&wake_lock);
+        drain_rings();
+        pthread_mutex_lock(&wake_lock);
+        if (writer_stop) break;
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += LOG_FLUSH_INTERVAL_MS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) { deadline.tv_sec++; deadline.tv_nsec -= 1000000000L; }
+        pthread_cond_timedwait(&wake_cond, &wake_lock, &deadline);
+    }
+    pthread_mutex_unlock(&wake_lock);
+    drain_rings();
+    return NULL;
+}
+
+// ========================================================================== //
+//                               LIFECYCLE                                    //
+// ========================================================================== //
+
+/**
+ * @brief Parses a level name; returns -1 if unknown.
+ */
+static int parse_level(const char* s) {
+    if (!s) return -1;
+    if (strcasecmp(s, "debug") == 0) return LOG_LEVEL_DEBUG;
+    if (strcasecmp(s, "info") == 0) return LOG_LEVEL_INFO;
+    if (strcasecmp(s, "warn") == 0 || strcasecmp(s, "warning") == 0) return LOG_LEVEL_WARN;
+    if (strcasecmp(s, "error") == 0) return LOG_LEVEL_ERROR;
+    if (strcasecmp(s, "off") == 0) return LOG_LEVEL_OFF;
+    return -1;
+}
+
+int log_init(void) {
+    if (__atomic_load_n(&writer_running, __ATOMIC_ACQUIRE)) return 1;
+
+    const char* level_env = getenv("MENTOR_LOG_LEVEL");
+    int level = parse_level(level_env);
+    if (level >= 0) log_set_level(level);
+    else if (level_env) fprintf(stderr, "Warning: Unknown MENTOR_LOG_LEVEL '%s', using info.\n", level_env);
+    const char* format_env = getenv("MENTOR_LOG_FORMAT");
+    json_format = (format_env && strcasecmp(format_env, "json") == 0);
+
+    writer_stop = 0;
+    int rc = pthread_create(&writer_thread, NULL, writer_main, NULL);
+    if (rc != 0) {
+        fprintf(stderr, "log_init: pthread_create failed (%s); logging synchronously.\n", strerror(rc));
+        return 0;
+    }
+    __atomic_store_n(&writer_running, 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+void log_shutdown(void) {
+    if (!__atomic_load_n(&writer_running, __ATOMIC_ACQUIRE)) return;
+    __atomic_store_n(&writer_running, 0, __ATOMIC_RELEASE); // New records go synchronous from here on
+    pthread_mutex_lock(&wake_lock);
+    writer_stop = 1;
+    pthread_cond_signal(&wake_cond);
+    pthread_mutex_unlock(&wake_lock);
+    pthread_join(writer_thread, NULL);
+    drain_rings(); // Records enqueued while the writer was finishing
+}
+
+void log_set_level(int level) {
+    if (level < LOG_LEVEL_DEBUG) level = LOG_LEVEL_DEBUG;
+    if (level > LOG_LEVEL_OFF) level = LOG_LEVEL_OFF;
+    __atomic_store_n(&log_runtime_level, level, __ATOMIC_RELAXED);
+}
+
+int log_get_level(void) {
+    return __atomic_load_n(&log_runtime_level, __ATOMIC_RELAXED);
+}
+
+unsigned long long log_dropped_count(void) {
+    return __atomic_load_n(&dropped_records, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,57 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+// --- Levels (plain macros so they can be used in #if) ---
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO  1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_OFF   4
+
+// Calls below this level are compiled out entirely (arguments are not evaluated).
+// Build with -DLOG_COMPILE_LEVEL=0 (make LOG_COMPILE_LEVEL=0) to keep DEBUG logs.
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_INFO
+#endif
+
+// --- Lifecycle ---
+/**
+ * @brief Starts the background writer thread. Until this is called (and after
+ * log_shutdown), log calls are written synchronously, so tools and early
+ * startup code can log without setup.
+ * Reads MENTOR_LOG_LEVEL (debug|info|warn|error|off) and MENTOR_LOG_FORMAT (text|json).
+ * @return 1 on success, 0 if the writer thread could not be started.
+ */
+int log_init(void);
+
+/**
+ * @brief Drains every buffered record, stops the writer thread and flushes.
+ */
+void log_shutdown(void);
+
+// --- Runtime Level ---
+void log_set_level(int level);
+int log_get_level(void);
+unsigned long long log_dropped_count(void); // Records lost because a thread's ring was full
+
+// Runtime threshold; read directly by the macros so disabled calls cost one load
+extern int log_runtime_level;
+
+/**
+ * @brief Formats and enqueues one record on the calling thread's ring buffer.
+ * WARN and ERROR go to stderr, everything else to stdout. Never blocks.
+ */
+void log_write(int level, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+#define LOG_AT_(level, ...) \
+    do { \
+        if ((level) >= LOG_COMPILE_LEVEL && (level) >= __atomic_load_n(&log_runtime_level, __ATOMIC_RELAXED)) \
+            log_write((level), __VA_ARGS__); \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT_(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT_(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT_(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT_(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#endif // LOGGER_H
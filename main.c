@@ -8,6 +8,9 @@
  #include <microhttpd.h>
  #include "mentorship_data.h"
  #include "api_handler.h" // Contains request_handler
+ #include "logger.h"
+ #include "trace.h"
+ #include "admission.h"
 
  #define PORT 8080
  #define DATA_FILE "Backend/mentorship_data.json" // Default Data file path
@@ -52,14 +55,19 @@
              write(STDERR_FILENO, save_fail_msg, strlen(save_fail_msg)); // Write warnings to stderr
          }
 
+         log_memory_report(app_data_ptr, "shutdown");
+
          const char* freeing_data_msg = "Freeing application data...\n";
          write(STDOUT_FILENO, freeing_data_msg, strlen(freeing_data_msg));
          free_app_data(app_data_ptr); // Frees all linked lists
          app_data_ptr = NULL; // Prevent double-freeing
+         log_memory_leaks(); // Anything still counted here was never freed
          const char* freed_data_msg = "Application data freed.\n";
          write(STDOUT_FILENO, freed_data_msg, strlen(freed_data_msg));
      }
 
+     log_shutdown(); // Flush records still queued by request threads
+
      const char* shutdown_complete_msg = "Shutdown complete.\n";
      write(STDOUT_FILENO, shutdown_complete_msg, strlen(shutdown_complete_msg));
      _exit(0); // Use _exit for signal safety (avoids stdio buffers)
@@ -69,26 +77,30 @@
   * @brief Main entry point.
   */
  int main(int argc, char *argv[]) {
+     // Start the background log writer first so startup messages go through it too
+     log_init();
+     trace_init(); // Reads MENTOR_SLOW_REQUEST_MS / MENTOR_TRACE
+     admission_init(); // Reads MENTOR_RATE_LIMIT / MENTOR_MAX_INFLIGHT
+
      // Allow overriding data file path via command-line argument
      const char* data_file_path = DATA_FILE; // Default
      if (argc > 1) {
          data_file_path = argv[1];
-         printf("Using data file path from command line: %s\n", data_file_path);
+         LOG_INFO("Using data file path from command line: %s", data_file_path);
      } else {
-          printf("Using default data file path: %s\n", data_file_path);
+          LOG_INFO("Using default data file path: %s", data_file_path);
      }
-     fflush(stdout);
 
      // Set the global data file path for saving/loading functions
      set_data_file_path(data_file_path);
 
-     printf("Initializing application data...\n"); fflush(stdout);
+     LOG_INFO("Initializing application data...");
      app_data_ptr = initialize_app_data(); // Loads data or creates new using the set path
      if (!app_data_ptr) {
-         fprintf(stderr, "Fatal Error: Failed to initialize application data. Exiting.\n");
+         LOG_ERROR("Fatal Error: Failed to initialize application data. Exiting.");
          return 1;
      }
-     printf("Application data initialized successfully.\n"); fflush(stdout);
+     LOG_INFO("Application data initialized successfully.");
 
      // Setup signal handling for graceful shutdown (SIGINT = Ctrl+C, SIGTERM = kill)
      struct sigaction sa;
@@ -107,7 +119,7 @@
          // Consider if fatal
      }
 
-     printf("Starting MHD daemon on port %d...\n", PORT); fflush(stdout);
+     LOG_INFO("Starting MHD daemon on port %d...", PORT);
 
      // Start the microhttpd web server
      // MHD_USE_DEBUG can be helpful but verbose
@@ -117,17 +129,18 @@
                                  NULL, NULL,        // Connection check callback (optional)
                                  &request_handler,  // The main request handler from api_handler.c
                                  app_data_ptr,      // Pass AppData pointer to the request handler
+                                 MHD_OPTION_NOTIFY_COMPLETED, &request_completed, NULL, // Metrics + per-request cleanup
+                                 MHD_OPTION_NOTIFY_CONNECTION, &connection_notify, NULL, // Per-connection request arena
                                  MHD_OPTION_END);
 
      if (NULL == daemon_ptr) {
-         fprintf(stderr, "Fatal Error: Failed to start MHD daemon on port %d. Check permissions or if port is already in use.\n", PORT);
+         LOG_ERROR("Fatal Error: Failed to start MHD daemon on port %d. Check permissions or if port is already in use.", PORT);
          free_app_data(app_data_ptr); // Clean up allocated data
          return 1;
      }
 
-     printf("Mentor Dashboard Backend running on http://localhost:%d\n", PORT);
-     printf("Press Ctrl+C to stop.\n");
-     fflush(stdout);
+     LOG_INFO("Mentor Dashboard Backend running on http://localhost:%d", PORT);
+     LOG_INFO("Press Ctrl+C to stop.");
 
      // Keep the main thread alive while the daemon runs in background threads
      // pause() waits for a signal to arrive.
@@ -136,7 +149,7 @@
      }
 
      // --- Code below should not be reached due to signal handler exit ---
-     printf("Performing cleanup (should not normally be reached)...\n");
+     LOG_INFO("Performing cleanup (should not normally be reached)...");
      if (daemon_ptr) { MHD_stop_daemon(daemon_ptr); }
      if (app_data_ptr) {
          // Optionally save data one last time if not handled by signal handler
@@ -0,0 +1,75 @@
+#define _POSIX_C_SOURCE 200809L // For sysconf
+#include <stdio.h>
+#include <unistd.h>
+#include "memstats.h"
+
+typedef struct {
+    long long live_bytes;
+    long long live_objects;
+    long long peak_bytes;
+    unsigned long long total_allocs;
+    unsigned long long total_frees;
+} MemCounters;
+
+static MemCounters counters[MEM_CATEGORY_COUNT];
+
+static const char* const category_names[MEM_CATEGORY_COUNT] = {
+    "mentees", "meetings", "issues", "users", "notes", "strings", "indexes", "caches"
+};
+
+static void raise_peak(MemCounters* c, long long live) {
+    long long peak = __atomic_load_n(&c->peak_bytes, __ATOMIC_RELAXED);
+    while (live > peak &&
+           !__atomic_compare_exchange_n(&c->peak_bytes, &peak, live, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        // 'peak' refreshed by the failed CAS
+    }
+}
+
+void memstats_alloc(MemCategory category, size_t bytes) {
+    if ((unsigned)category >= MEM_CATEGORY_COUNT) return;
+    MemCounters* c = &counters[category];
+    long long live = __atomic_add_fetch(&c->live_bytes, (long long)bytes, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&c->live_objects, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&c->total_allocs, 1, __ATOMIC_RELAXED);
+    raise_peak(c, live);
+}
+
+void memstats_free(MemCategory category, size_t bytes) {
+    if ((unsigned)category >= MEM_CATEGORY_COUNT) return;
+    MemCounters* c = &counters[category];
+    __atomic_fetch_sub(&c->live_bytes, (long long)bytes, __ATOMIC_RELAXED);
+    __atomic_fetch_sub(&c->live_objects, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&c->total_frees, 1, __ATOMIC_RELAXED);
+}
+
+void memstats_resize(MemCategory category, size_t old_bytes, size_t new_bytes) {
+    if ((unsigned)category >= MEM_CATEGORY_COUNT) return;
+    MemCounters* c = &counters[category];
+    long long live = __atomic_add_fetch(&c->live_bytes, (long long)new_bytes - (long long)old_bytes, __ATOMIC_RELAXED);
+    raise_peak(c, live);
+}
+
+void memstats_snapshot(MemCategoryStats out[MEM_CATEGORY_COUNT]) {
+    for (int i = 0; i < MEM_CATEGORY_COUNT; ++i) {
+        out[i].live_bytes = __atomic_load_n(&counters[i].live_bytes, __ATOMIC_RELAXED);
+        out[i].live_objects = __atomic_load_n(&counters[i].live_objects, __ATOMIC_RELAXED);
+        out[i].peak_bytes = __atomic_load_n(&counters[i].peak_bytes, __ATOMIC_RELAXED);
+        out[i].total_allocs = __atomic_load_n(&counters[i].total_allocs, __ATOMIC_RELAXED);
+        out[i].total_frees = __atomic_load_n(&counters[i].total_frees, __ATOMIC_RELAXED);
+    }
+}
+
+const char* memstats_category_name(MemCategory category) {
+    return ((unsigned)category < MEM_CATEGORY_COUNT) ? category_names[category] : "unknown";
+}
+
+size_t memstats_process_rss(void) {
+    FILE* fp = fopen("/proc/self/statm", "r");
+    if (!fp) return 0;
+    unsigned long size_pages = 0, resident_pages = 0;
+    int fields = fscanf(fp, "%lu %lu", &size_pages, &resident_pages);
+    fclose(fp);
+    if (fields != 2) return 0;
+    long page_size = sysconf(_SC_PAGESIZE);
+    return (size_t)resident_pages * (size_t)(page_size > 0 ? page_size : 4096);
+}
@@ -0,0 +1,46 @@
+#ifndef MEMSTATS_H
+#define MEMSTATS_H
+
+#include <stddef.h>
+
+// Collections that heap allocations are attributed to
+typedef enum {
+    MEM_MENTEES,    // Mentee structs
+    MEM_MEETINGS,   // Meeting structs
+    MEM_ISSUES,     // Issue structs
+    MEM_USERS,      // User structs
+    MEM_NOTES,      // Note structs (general and response notes)
+    MEM_STRINGS,    // Strings owned by any of the above
+    MEM_INDEXES,    // Name index entries, skip lists, search index
+    MEM_CACHES,     // Response/result caches
+    MEM_CATEGORY_COUNT
+} MemCategory;
+
+typedef struct {
+    long long live_bytes;
+    long long live_objects;
+    long long peak_bytes;
+    unsigned long long total_allocs;
+    unsigned long long total_frees;
+} MemCategoryStats;
+
+/**
+ * @brief Counts one allocation of 'bytes' against 'category'. Lock-free.
+ */
+void memstats_alloc(MemCategory category, size_t bytes);
+void memstats_free(MemCategory category, size_t bytes);
+
+/**
+ * @brief Counts a resize of an existing allocation (object count unchanged).
+ */
+void memstats_resize(MemCategory category, size_t old_bytes, size_t new_bytes);
+
+void memstats_snapshot(MemCategoryStats out[MEM_CATEGORY_COUNT]);
+const char* memstats_category_name(MemCategory category);
+
+/**
+ * @brief Resident set size of this process from /proc/self/statm (0 if unavailable).
+ */
+size_t memstats_process_rss(void);
+
+#endif // MEMSTATS_H
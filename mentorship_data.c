@@ -6,7 +6,14 @@
 #include <time.h>
 #include <errno.h>
 #include <ctype.h> // For isspace, tolower
+#include <limits.h> // For INT_MIN
+#include <stdint.h> // For uintptr_t
 #include "mentorship_data.h"
+#include "logger.h"
+#include "metrics.h"
+#include "trace.h"
+#include "memstats.h"
+#include "password.h"
 #include <cjson/cJSON.h>
 
 // Use the specific path defined in main.c or passed to functions
@@ -32,6 +39,53 @@ char* safe_strdup(const char* s) {
     return new_s;
 }
 
+// ========================================================================== //
+//                           MEMORY ACCOUNTING                                //
+// ========================================================================== //
+// sign is +1 once an object is owned by AppData and -1 just before it is freed.
+
+static void account_object(MemCategory category, size_t bytes, int sign) {
+    if (sign > 0) memstats_alloc(category, bytes);
+    else memstats_free(category, bytes);
+}
+
+static void account_string(const char* s, int sign) {
+    if (s) account_object(MEM_STRINGS, strlen(s) + 1, sign);
+}
+
+static void account_note(const Note* note, int sign) {
+    account_object(MEM_NOTES, sizeof(Note), sign);
+    account_string(note->text, sign);
+}
+
+static void account_mentee(const Mentee* mentee, int sign) {
+    account_object(MEM_MENTEES, sizeof(Mentee), sign);
+    account_string(mentee->name, sign);
+    account_string(mentee->subject, sign);
+    account_string(mentee->email, sign);
+}
+
+static void account_meeting(const Meeting* meeting, int sign) {
+    account_object(MEM_MEETINGS, sizeof(Meeting), sign);
+    account_string(meeting->mentee_name, sign);
+    account_string(meeting->date_str, sign);
+    account_string(meeting->time_str, sign);
+    account_string(meeting->notes, sign);
+}
+
+static void account_issue(const Issue* issue, int sign) {
+    account_object(MEM_ISSUES, sizeof(Issue), sign);
+    account_string(issue->mentee_name, sign);
+    account_string(issue->description, sign);
+    account_string(issue->date_reported_str, sign);
+}
+
+static void account_user(const User* user, int sign) {
+    account_object(MEM_USERS, sizeof(User), sign);
+    account_string(user->username, sign);
+    account_string(user->password_hash, sign);
+}
+
 /**
  * @brief Converts an IssuePriority enum to string.
  */
@@ -104,24 +158,36 @@ UserRole string_to_role(const char* s) {
 // ========================================================================== //
 
 /**
- * @brief Adds a new note to the beginning of a linked list. Allocates memory.
+ * @brief Allocates an unlinked note; 'text' is duplicated and may be NULL.
+ * Every Note must come from here so free_notes() can balance the accounting.
  */
-Note* add_note(Note** head_ref, const char* text) {
-    if (!head_ref || !text) {
-        fprintf(stderr, "add_note: Error - NULL head_ref or text provided.\n");
-        return NULL;
-    }
+Note* create_note(const char* text, time_t timestamp) {
     Note* new_note = malloc(sizeof(Note));
     if (!new_note) {
-        perror("add_note: malloc failed for Note struct");
+        perror("create_note: malloc failed for Note struct");
         return NULL;
     }
     new_note->text = safe_strdup(text);
-    if (!new_note->text && strlen(text) > 0) { // Check strdup failure only if text wasn't empty
+    if (text && !new_note->text) {
         free(new_note);
         return NULL;
     }
-    new_note->timestamp = time(NULL);
+    new_note->timestamp = timestamp;
+    new_note->next = NULL;
+    account_note(new_note, +1);
+    return new_note;
+}
+
+/**
+ * @brief Adds a new note to the beginning of a linked list. Allocates memory.
+ */
+Note* add_note(Note** head_ref, const char* text) {
+    if (!head_ref || !text) {
+        LOG_ERROR("add_note: Error - NULL head_ref or text provided.");
+        return NULL;
+    }
+    Note* new_note = create_note(text, time(NULL));
+    if (!new_note) return NULL;
     new_note->next = *head_ref;
     *head_ref = new_note;
     return new_note;
@@ -135,12 +201,222 @@ void free_notes(Note* head) {
     Note* next_node;
     while (current != NULL) {
         next_node = current->next;
+        account_note(current, -1);
         free(current->text);
         free(current);
         current = next_node;
     }
 }
 
+// ========================================================================== //
+//                          SEARCH INDEX HELPERS                              //
+// ========================================================================== //
+
+/**
+ * @brief Indexes every note of a list under its owning mentee or issue.
+ */
+static void search_index_notes(AppData* data, const Note* head, SearchDocKind owner_kind, int owner_id) {
+    for (const Note* note = head; note; note = note->next) {
+        const char* fields[] = { note->text };
+        search_index_add(data->search_index, SEARCH_DOC_NOTE, owner_kind, owner_id, note, fields, 1);
+    }
+}
+
+static void search_unindex_notes(AppData* data, const Note* head) {
+    for (const Note* note = head; note; note = note->next) {
+        search_index_remove(data->search_index, note);
+    }
+}
+
+static void search_index_mentee(AppData* data, const Mentee* mentee) {
+    const char* fields[] = { mentee->name, mentee->subject };
+    search_index_add(data->search_index, SEARCH_DOC_MENTEE, SEARCH_DOC_MENTEE, mentee->id, mentee, fields, 2);
+    search_index_notes(data, mentee->general_notes, SEARCH_DOC_MENTEE, mentee->id);
+}
+
+static void search_index_meeting(AppData* data, const Meeting* meeting) {
+    if (!meeting->notes || !meeting->notes[0]) return;
+    const char* fields[] = { meeting->notes };
+    search_index_add(data->search_index, SEARCH_DOC_MEETING, SEARCH_DOC_MEETING, meeting->id, meeting, fields, 1);
+}
+
+static void search_index_issue(AppData* data, const Issue* issue) {
+    const char* fields[] = { issue->description };
+    search_index_add(data->search_index, SEARCH_DOC_ISSUE, SEARCH_DOC_ISSUE, issue->id, issue, fields, 1);
+    search_index_notes(data, issue->response_notes, SEARCH_DOC_ISSUE, issue->id);
+}
+
+// ========================================================================== //
+//                           NAME INDEX HELPERS                               //
+// ========================================================================== //
+
+typedef enum {
+    NAME_KEY_FULL,     // Whole mentee name
+    NAME_KEY_WORD,     // A later word of the name ("smith" in "John Smith")
+    NAME_KEY_USERNAME  // User login (any role)
+} NameKeyKind;
+
+typedef struct {
+    char* key;         // Lowercased (ASCII) copy of the indexed text
+    NameKeyKind kind;
+    void* ref;         // Mentee* or User*
+} NameIndexEntry;
+
+/**
+ * @brief Orders entries by (key, kind, ref) so every entry is unique.
+ */
+static int compare_name_entry(const void* a, const void* b) {
+    const NameIndexEntry* ea = a;
+    const NameIndexEntry* eb = b;
+    int cmp = strcmp(ea->key, eb->key);
+    if (cmp != 0) return cmp;
+    if (ea->kind != eb->kind) return (ea->kind < eb->kind) ? -1 : 1;
+    if (ea->ref != eb->ref) return ((uintptr_t)ea->ref < (uintptr_t)eb->ref) ? -1 : 1;
+    return 0;
+}
+
+static int compare_mentee_by_id(const void* a, const void* b) {
+    const Mentee* ma = a;
+    const Mentee* mb = b;
+    if (ma->id != mb->id) return (ma->id < mb->id) ? -1 : 1;
+    return 0;
+}
+
+static char* lowercase_dup(const char* s, size_t len) {
+    char* out = malloc(len + 1);
+    if (!out) {
+        perror("lowercase_dup: malloc failed");
+        return NULL;
+    }
+    for (size_t i = 0; i < len; ++i) out[i] = (char)tolower((unsigned char)s[i]);
+    out[len] = '\0';
+    return out;
+}
+
+static void name_index_insert(AppData* data, const char* text, size_t len, NameKeyKind kind, void* ref) {
+    NameIndexEntry* entry = malloc(sizeof(NameIndexEntry));
+    if (!entry) {
+        perror("name_index_insert: malloc failed");
+        return;
+    }
+    entry->key = lowercase_dup(text, len);
+    entry->kind = kind;
+    entry->ref = ref;
+    if (!entry->key || !skiplist_insert(data->name_index, entry)) {
+        free(entry->key); // Duplicate (same word twice in one name) or OOM
+        free(entry);
+        return;
+    }
+    memstats_alloc(MEM_INDEXES, sizeof(NameIndexEntry) + len + 1);
+}
+
+static void name_index_delete(AppData* data, const char* text, size_t len, NameKeyKind kind, void* ref) {
+    NameIndexEntry probe = { lowercase_dup(text, len), kind, ref };
+    if (!probe.key) return;
+    NameIndexEntry* entry = skiplist_value(skiplist_lower_bound(data->name_index, &probe));
+    if (entry && compare_name_entry(entry, &probe) == 0) {
+        skiplist_remove(data->name_index, entry);
+        memstats_free(MEM_INDEXES, sizeof(NameIndexEntry) + strlen(entry->key) + 1);
+        free(entry->key);
+        free(entry);
+    }
+    free(probe.key);
+}
+
+/**
+ * @brief Calls 'apply' for the full name and for each later word of it.
+ */
+static void for_each_name_key(AppData* data, Mentee* mentee,
+                              void (*apply)(AppData*, const char*, size_t, NameKeyKind, void*)) {
+    const char* name = mentee->name;
+    if (!name || !*name) return;
+    apply(data, name, strlen(name), NAME_KEY_FULL, mentee);
+    for (const char* p = name; *p; ++p) {
+        if (isspace((unsigned char)*p) && p[1] && !isspace((unsigned char)p[1])) {
+            const char* word = p + 1;
+            apply(data, word, strcspn(word, " \t\r\n"), NAME_KEY_WORD, mentee);
+        }
+    }
+}
+
+static void index_mentee(AppData* data, Mentee* mentee) {
+    if (!skiplist_insert(data->mentees_by_id, mentee)) {
+        LOG_WARN("Failed to index mentee %d by ID (duplicate?).", mentee->id);
+    }
+    for_each_name_key(data, mentee, name_index_insert);
+}
+
+static void unindex_mentee(AppData* data, Mentee* mentee) {
+    skiplist_remove(data->mentees_by_id, mentee);
+    for_each_name_key(data, mentee, name_index_delete);
+}
+
+static void index_user(AppData* data, User* user) {
+    if (user->username) name_index_insert(data, user->username, strlen(user->username), NAME_KEY_USERNAME, user);
+}
+
+/**
+ * @brief Frees all entries of the name index, then the index itself.
+ */
+static void free_name_index(SkipList* index) {
+    for (SkipListNode* node = skiplist_first(index); node; node = skiplist_next(node)) {
+        NameIndexEntry* entry = skiplist_value(node);
+        memstats_free(MEM_INDEXES, sizeof(NameIndexEntry) + strlen(entry->key) + 1);
+        free(entry->key);
+        free(entry);
+    }
+    skiplist_free(index);
+}
+
+// ========================================================================== //
+//                                UNDO LOG                                    //
+// ========================================================================== //
+
+typedef enum {
+    UNDO_ADD_MENTEE,
+    UNDO_ADD_MENTEE_NOTE,
+    UNDO_DELETE_MENTEE,
+    UNDO_ADD_MEETING,
+    UNDO_UPDATE_MEETING,
+    UNDO_DELETE_MEETING,
+    UNDO_ADD_ISSUE,
+    UNDO_UPDATE_ISSUE,
+    UNDO_ADD_USER
+} UndoKind;
+
+// One recorded change. Undoing newest first puts every list back exactly as
+// it was when the change was made, so 'record' and 'prev' are still valid then.
+struct UndoEntry {
+    UndoKind kind;
+    void* record;          // The mentee, meeting, issue or user changed
+    void* prev;            // Deletes: list predecessor to relink after (NULL = head)
+    Note* note;            // Note added by the change, if any
+    char* old_date;        // UNDO_UPDATE_MEETING: strings replaced, kept until the scope ends
+    char* old_time;
+    IssueStatus old_status; // UNDO_UPDATE_ISSUE
+    UndoEntry* next;
+};
+
+/**
+ * @brief Records a change if an undo scope is open. Returns the entry for the
+ * caller to complete, or NULL if no scope is open or it could not be allocated
+ * (the scope then cannot be rolled back).
+ */
+static UndoEntry* undo_push(AppData* data, UndoKind kind, void* record) {
+    if (!data->undo_active) return NULL;
+    UndoEntry* entry = calloc(1, sizeof(UndoEntry));
+    if (!entry) {
+        LOG_ERROR("undo_push: malloc failed; this scope can no longer be rolled back.");
+        data->undo_incomplete = 1;
+        return NULL;
+    }
+    entry->kind = kind;
+    entry->record = record;
+    entry->next = data->undo_log;
+    data->undo_log = entry;
+    return entry;
+}
+
 // ========================================================================== //
 //                            MENTEE FUNCTIONS                                //
 // ========================================================================== //
@@ -150,7 +426,7 @@ void free_notes(Note* head) {
  */
 Mentee* add_mentee(AppData* data, const char* name, const char* subject, const char* email) {
     if (!data || !name || !subject) {
-         fprintf(stderr, "add_mentee: Error - NULL data, name, or subject provided.\n");
+         LOG_ERROR("add_mentee: Error - NULL data, name, or subject provided.");
          return NULL;
     }
 
@@ -166,7 +442,7 @@ Mentee* add_mentee(AppData* data, const char* name, const char* subject, const c
 
     // Check for allocation failure *after* attempting all strdups
     if (!new_mentee->name || !new_mentee->subject || (email && strlen(email) > 0 && !new_mentee->email)) {
-        fprintf(stderr, "add_mentee: Failed to duplicate one or more input strings.\n");
+        LOG_ERROR("add_mentee: Failed to duplicate one or more input strings.");
         free(new_mentee->name); // safe to free NULL
         free(new_mentee->subject);
         free(new_mentee->email);
@@ -176,8 +452,12 @@ Mentee* add_mentee(AppData* data, const char* name, const char* subject, const c
 
     new_mentee->id = data->next_mentee_id++;
     new_mentee->general_notes = NULL;
+    account_mentee(new_mentee, +1);
     new_mentee->next = data->mentees_head;
     data->mentees_head = new_mentee;
+    index_mentee(data, new_mentee);
+    search_index_mentee(data, new_mentee);
+    undo_push(data, UNDO_ADD_MENTEE, new_mentee);
 
     // Saving should be handled explicitly by the caller (e.g., after adding mentee + user)
     // if (!save_data_to_file(data, DATA_FILE)) { ... }
@@ -190,32 +470,26 @@ Mentee* add_mentee(AppData* data, const char* name, const char* subject, const c
  */
 Mentee* find_mentee_by_id(const AppData* data, int id) {
     // --- ADDED LOGGING ---
-    printf("      [find_mentee_by_id] Searching for ID: %d\n", id); fflush(stdout);
+    LOG_DEBUG("[find_mentee_by_id] Searching for ID: %d", id);
     // --- END LOGGING ---
 
     if (!data || id <= 0) {
         // --- ADDED LOGGING ---
-        printf("      [find_mentee_by_id] Invalid input (data=%p, id=%d)\n", (void*)data, id); fflush(stdout);
+        LOG_DEBUG("[find_mentee_by_id] Invalid input (data=%p, id=%d)", (void*)data, id);
         // --- END LOGGING ---
         return NULL;
     }
-    Mentee* current = data->mentees_head;
-    int count = 0;
-    while (current != NULL) {
+    Mentee probe = {0};
+    probe.id = id;
+    Mentee* current = skiplist_value(skiplist_lower_bound(data->mentees_by_id, &probe));
+    if (current && current->id == id) {
         // --- ADDED LOGGING ---
-        printf("      [find_mentee_by_id] Checking mentee node %d -> ID: %d (Name: %s)\n", count, current->id, current->name ? current->name : "N/A"); fflush(stdout);
+        LOG_DEBUG("[find_mentee_by_id] Match found for ID: %d", id);
         // --- END LOGGING ---
-        if (current->id == id) {
-            // --- ADDED LOGGING ---
-            printf("      [find_mentee_by_id] Match found for ID: %d\n", id); fflush(stdout);
-            // --- END LOGGING ---
-            return current;
-        }
-        current = current->next;
-        count++;
+        return current;
     }
     // --- ADDED LOGGING ---
-    printf("      [find_mentee_by_id] ID: %d not found after checking %d nodes.\n", id, count); fflush(stdout);
+    LOG_DEBUG("[find_mentee_by_id] ID: %d not found (%zu mentees indexed).", id, skiplist_size(data->mentees_by_id));
     // --- END LOGGING ---
     return NULL;
 }
@@ -223,17 +497,87 @@ Mentee* find_mentee_by_id(const AppData* data, int id) {
 
 /**
  * @brief Finds a mentee by their name (case-sensitive).
+ * Seeks to the case-folded key in the name index, then compares exactly.
  */
 Mentee* find_mentee_by_name(const AppData* data, const char* name) {
      if (!data || !name) return NULL;
-     Mentee* current = data->mentees_head;
-     while (current != NULL) {
-         if (current->name && strcmp(current->name, name) == 0) {
-             return current;
+     NameIndexEntry probe = { lowercase_dup(name, strlen(name)), NAME_KEY_FULL, NULL };
+     if (!probe.key) return NULL;
+     Mentee* found = NULL;
+     for (SkipListNode* node = skiplist_lower_bound(data->name_index, &probe); node; node = skiplist_next(node)) {
+         const NameIndexEntry* entry = skiplist_value(node);
+         if (entry->kind != NAME_KEY_FULL || strcmp(entry->key, probe.key) != 0) break;
+         Mentee* candidate = entry->ref;
+         if (strcmp(candidate->name, name) == 0) {
+             found = candidate;
+             break;
          }
-         current = current->next;
      }
-     return NULL;
+     free(probe.key);
+     return found;
+}
+
+int suggest_mentees(const AppData* data, const char* prefix, MenteeSuggestion* out, int max_results) {
+    if (!data || !prefix || !out || max_results <= 0) return 0;
+    size_t prefix_len = strlen(prefix);
+    NameIndexEntry probe = { lowercase_dup(prefix, prefix_len), NAME_KEY_FULL, NULL };
+    if (!probe.key) return 0;
+
+    int count = 0;
+    for (SkipListNode* node = skiplist_lower_bound(data->name_index, &probe); node && count < max_results; node = skiplist_next(node)) {
+        const NameIndexEntry* entry = skiplist_value(node);
+        if (strncmp(entry->key, probe.key, prefix_len) != 0) break; // Past the prefix range
+
+        Mentee* mentee = NULL;
+        const User* user = NULL;
+        if (entry->kind == NAME_KEY_USERNAME) {
+            user = entry->ref;
+            if (user->role != ROLE_MENTEE) continue;
+            mentee = find_mentee_by_id(data, user->associated_id);
+            if (!mentee) continue; // Orphaned account
+        } else {
+            mentee = entry->ref;
+        }
+
+        int duplicate = 0; // A mentee can match on several keys; report it once
+        for (int i = 0; i < count && !duplicate; ++i) duplicate = (out[i].mentee == mentee);
+        if (duplicate) continue;
+        out[count].mentee = mentee;
+        out[count].user = user;
+        count++;
+    }
+    free(probe.key);
+    return count;
+}
+
+/**
+ * @brief Unlinks a mentee from the list (after 'prev', NULL = head) and drops
+ * its index entries, before the structs they point at are freed or set aside.
+ */
+static void detach_mentee(AppData* data, Mentee* mentee, Mentee* prev) {
+    if (prev) prev->next = mentee->next;
+    else data->mentees_head = mentee->next;
+    unindex_mentee(data, mentee);
+    search_index_remove(data->search_index, mentee);
+    search_unindex_notes(data, mentee->general_notes);
+}
+
+// Inverse of detach_mentee()
+static void attach_mentee(AppData* data, Mentee* mentee, Mentee* prev) {
+    Mentee** link = prev ? &prev->next : &data->mentees_head;
+    mentee->next = *link;
+    *link = mentee;
+    index_mentee(data, mentee);
+    search_index_mentee(data, mentee);
+}
+
+static void destroy_mentee(Mentee* mentee) {
+    account_mentee(mentee, -1);
+    free(mentee->name);
+    free(mentee->subject);
+    free(mentee->email);
+    free_notes(mentee->general_notes);
+    free(mentee);
 }
 
 /**
@@ -242,7 +586,7 @@ Mentee* find_mentee_by_name(const AppData* data, const char* name) {
  */
 int delete_mentee(AppData* data, int id) {
     if (!data || !data->mentees_head || id <= 0) {
-         fprintf(stderr,"delete_mentee: List empty, data is NULL, or invalid ID (%d).\n", id);
+         LOG_ERROR("delete_mentee: List empty, data is NULL, or invalid ID (%d).", id);
         return 0; // Indicate failure: not found or invalid input
     }
 
@@ -257,25 +601,16 @@ int delete_mentee(AppData* data, int id) {
 
     // Mentee not found
     if (current == NULL) {
-        fprintf(stderr, "delete_mentee: Mentee with ID %d not found.\n", id);
+        LOG_ERROR("delete_mentee: Mentee with ID %d not found.", id);
         return 0; // Indicate failure: not found
     }
 
-    // Unlink the node from the list
-    if (prev == NULL) { // Node to delete is the head
-        data->mentees_head = current->next;
-    } else { // Node is in the middle or end
-        prev->next = current->next;
-    }
-
     // TODO: Find and delete user with role MENTEE and associated_id == id (handled by caller?)
 
-    // Free the memory associated with the deleted mentee
-    free(current->name);
-    free(current->subject);
-    free(current->email);
-    free_notes(current->general_notes);
-    free(current); // Free the struct itself
+    detach_mentee(data, current, prev);
+    UndoEntry* undo = undo_push(data, UNDO_DELETE_MENTEE, current);
+    if (undo) undo->prev = prev; // Set aside until the undo scope ends
+    else destroy_mentee(current);
 
     // Saving should be handled explicitly by the caller after successful deletion
     // if (!save_data_to_file(data, DATA_FILE)) { ... }
@@ -287,14 +622,20 @@ int delete_mentee(AppData* data, int id) {
 /**
  * @brief Adds a general note to a specific mentee. Does NOT save automatically.
  */
-void add_mentee_note(Mentee* mentee, const char* note_text) {
-    if (!mentee || !note_text) {
-         fprintf(stderr, "add_mentee_note: Error - NULL mentee or note_text provided.\n");
+void add_mentee_note(AppData* data, Mentee* mentee, const char* note_text) {
+    if (!data || !mentee || !note_text) {
+         LOG_ERROR("add_mentee_note: Error - NULL data, mentee or note_text provided.");
          return;
     }
-    if (!add_note(&(mentee->general_notes), note_text)) {
-         fprintf(stderr, "Warning: Failed to add general note to mentee ID %d.\n", mentee->id);
+    Note* note = add_note(&(mentee->general_notes), note_text);
+    if (!note) {
+         LOG_WARN("Failed to add general note to mentee ID %d.", mentee->id);
+         return;
     }
+    const char* fields[] = { note->text };
+    search_index_add(data->search_index, SEARCH_DOC_NOTE, SEARCH_DOC_MENTEE, mentee->id, note, fields, 1);
+    UndoEntry* undo = undo_push(data, UNDO_ADD_MENTEE_NOTE, mentee);
+    if (undo) undo->note = note;
     // Saving is handled by caller if needed
 }
 
@@ -306,11 +647,7 @@ void free_mentees(Mentee* head) {
     Mentee* next_node;
     while (current != NULL) {
         next_node = current->next;
-        free(current->name);
-        free(current->subject);
-        free(current->email);
-        free_notes(current->general_notes);
-        free(current);
+        destroy_mentee(current);
         current = next_node;
     }
 }
@@ -320,12 +657,97 @@ void free_mentees(Mentee* head) {
 //                            MEETING FUNCTIONS                               //
 // ========================================================================== //
 
+/**
+ * @brief Parses "YYYY-MM-DD" + "HH:MM" into local time. Returns 0 if unparseable.
+ */
+time_t parse_meeting_datetime(const char* date_str, const char* time_str) {
+    if (!date_str || !time_str) return 0;
+    char datetime_str[64];
+    struct tm meeting_tm = {0};
+    snprintf(datetime_str, sizeof(datetime_str), "%s %s", date_str, time_str);
+    if (strptime(datetime_str, "%Y-%m-%d %H:%M", &meeting_tm) == NULL) return 0;
+    meeting_tm.tm_isdst = -1; // Let mktime determine DST
+    time_t t = mktime(&meeting_tm);
+    return (t > 0) ? t : 0;
+}
+
+/**
+ * @brief Orders meetings by (start_time, id) for the global time index.
+ */
+static int compare_meeting_by_time(const void* a, const void* b) {
+    const Meeting* ma = a;
+    const Meeting* mb = b;
+    if (ma->start_time != mb->start_time) return (ma->start_time < mb->start_time) ? -1 : 1;
+    if (ma->id != mb->id) return (ma->id < mb->id) ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief Orders meetings by (mentee_id, start_time, id) for the per-mentee index.
+ */
+static int compare_meeting_by_mentee(const void* a, const void* b) {
+    const Meeting* ma = a;
+    const Meeting* mb = b;
+    if (ma->mentee_id != mb->mentee_id) return (ma->mentee_id < mb->mentee_id) ? -1 : 1;
+    return compare_meeting_by_time(a, b);
+}
+
+/**
+ * @brief Adds a meeting to both time indexes. Key fields must already be set.
+ */
+static void index_meeting(AppData* data, Meeting* meeting) {
+    data->meeting_duration_counts[meeting->duration_minutes]++;
+    if (meeting->duration_minutes > data->max_meeting_minutes) {
+        data->max_meeting_minutes = meeting->duration_minutes;
+    }
+    if (!skiplist_insert(data->meetings_by_time, meeting) ||
+        !skiplist_insert(data->meetings_by_mentee, meeting)) {
+        LOG_WARN("Failed to index meeting %d by time.", meeting->id);
+    }
+}
+
+/**
+ * @brief Removes a meeting from both time indexes. Call BEFORE changing key fields.
+ */
+static void unindex_meeting(AppData* data, Meeting* meeting) {
+    skiplist_remove(data->meetings_by_time, meeting);
+    skiplist_remove(data->meetings_by_mentee, meeting);
+    // Lower the bound once the longest meeting goes, so searches shrink back too
+    data->meeting_duration_counts[meeting->duration_minutes]--;
+    while (data->max_meeting_minutes > 0 && data->meeting_duration_counts[data->max_meeting_minutes] == 0) {
+        data->max_meeting_minutes--;
+    }
+}
+
+/**
+ * @brief Visits meetings in [from, to) in start-time order (see header).
+ */
+int for_each_meeting_in_range(const AppData* data, int mentee_id, time_t from, time_t to, MeetingVisitor visit, void* ctx) {
+    if (!data || !visit || from >= to) return 0;
+
+    Meeting probe = {0};
+    probe.id = INT_MIN;
+    probe.start_time = from;
+    probe.mentee_id = mentee_id;
+
+    const SkipList* index = (mentee_id > 0) ? data->meetings_by_mentee : data->meetings_by_time;
+    int visited = 0;
+    for (SkipListNode* node = skiplist_lower_bound(index, &probe); node; node = skiplist_next(node)) {
+        const Meeting* meeting = skiplist_value(node);
+        if (mentee_id > 0 && meeting->mentee_id != mentee_id) break;
+        if (meeting->start_time >= to) break;
+        visited++;
+        if (!visit(meeting, ctx)) break;
+    }
+    return visited;
+}
+
 /**
  * @brief Adds a new meeting. Assigns ID, duplicates strings. DOES NOT SAVE.
  */
 Meeting* add_meeting(AppData* data, int mentee_id, const char* mentee_name, const char* date_str, const char* time_str, int duration, const char* notes) {
-    if (!data || mentee_id <= 0 || !mentee_name || !date_str || !time_str || duration <= 0) {
-         fprintf(stderr, "add_meeting: Error - Invalid input data provided.\n");
+    if (!data || mentee_id <= 0 || !mentee_name || !date_str || !time_str || duration <= 0 || duration > MAX_MEETING_MINUTES) {
+         LOG_ERROR("add_meeting: Error - Invalid input data provided.");
          return NULL;
     }
 
@@ -341,7 +763,7 @@ Meeting* add_meeting(AppData* data, int mentee_id, const char* mentee_name, cons
     new_meeting->notes = safe_strdup(notes); // Handles NULL notes
 
      if (!new_meeting->mentee_name || !new_meeting->date_str || !new_meeting->time_str || (notes && strlen(notes) > 0 && !new_meeting->notes)) {
-        fprintf(stderr, "add_meeting: Failed to duplicate one or more input strings.\n");
+        LOG_ERROR("add_meeting: Failed to duplicate one or more input strings.");
         free(new_meeting->mentee_name);
         free(new_meeting->date_str);
         free(new_meeting->time_str);
@@ -353,8 +775,13 @@ Meeting* add_meeting(AppData* data, int mentee_id, const char* mentee_name, cons
     new_meeting->id = data->next_meeting_id++;
     new_meeting->mentee_id = mentee_id;
     new_meeting->duration_minutes = duration;
+    new_meeting->start_time = parse_meeting_datetime(date_str, time_str);
+    account_meeting(new_meeting, +1);
     new_meeting->next = data->meetings_head;
     data->meetings_head = new_meeting;
+    index_meeting(data, new_meeting);
+    search_index_meeting(data, new_meeting);
+    undo_push(data, UNDO_ADD_MEETING, new_meeting);
 
     // Saving handled by caller
     // if (!save_data_to_file(data, DATA_FILE)) { ... }
@@ -380,9 +807,9 @@ Meeting* find_meeting_by_id(const AppData* data, int id) {
 /**
  * @brief Updates date and time of a meeting. Frees old strings. Does NOT save automatically.
  */
-int update_meeting(Meeting* meeting, const char* new_date_str, const char* new_time_str) {
-    if (!meeting || !new_date_str || !new_time_str) {
-        fprintf(stderr, "update_meeting: Error - NULL input provided.\n");
+int update_meeting(AppData* data, Meeting* meeting, const char* new_date_str, const char* new_time_str) {
+    if (!data || !meeting || !new_date_str || !new_time_str) {
+        LOG_ERROR("update_meeting: Error - NULL input provided.");
         return 0; // Indicate failure
     }
 
@@ -392,28 +819,68 @@ int update_meeting(Meeting* meeting, const char* new_date_str, const char* new_t
     if (!temp_date || !temp_time) {
         free(temp_date); // free(NULL) is safe
         free(temp_time);
-        fprintf(stderr, "update_meeting: Failed to duplicate new date/time strings.\n");
+        LOG_ERROR("update_meeting: Failed to duplicate new date/time strings.");
         return 0; // Indicate failure
     }
 
     // Free old strings only after successful duplication of new ones
-    free(meeting->date_str);
-    free(meeting->time_str);
+    account_string(meeting->date_str, -1);
+    account_string(meeting->time_str, -1);
+    account_string(temp_date, +1);
+    account_string(temp_time, +1);
+    UndoEntry* undo = undo_push(data, UNDO_UPDATE_MEETING, meeting);
+    if (undo) { // Kept, unaccounted, until the undo scope ends
+        undo->old_date = meeting->date_str;
+        undo->old_time = meeting->time_str;
+    } else {
+        free(meeting->date_str);
+        free(meeting->time_str);
+    }
 
+    // Re-key the meeting in the time indexes
+    unindex_meeting(data, meeting);
     meeting->date_str = temp_date;
     meeting->time_str = temp_time;
+    meeting->start_time = parse_meeting_datetime(temp_date, temp_time);
+    index_meeting(data, meeting);
 
     // Saving is handled by caller
     return 1; // Indicate success
 }
 
 
+// Unlinks a meeting (after 'prev', NULL = head) and drops its index entries
+static void detach_meeting(AppData* data, Meeting* meeting, Meeting* prev) {
+    if (prev) prev->next = meeting->next;
+    else data->meetings_head = meeting->next;
+    unindex_meeting(data, meeting);
+    search_index_remove(data->search_index, meeting);
+}
+
+// Inverse of detach_meeting()
+static void attach_meeting(AppData* data, Meeting* meeting, Meeting* prev) {
+    Meeting** link = prev ? &prev->next : &data->meetings_head;
+    meeting->next = *link;
+    *link = meeting;
+    index_meeting(data, meeting);
+    search_index_meeting(data, meeting);
+}
+
+static void destroy_meeting(Meeting* meeting) {
+    account_meeting(meeting, -1);
+    free(meeting->mentee_name);
+    free(meeting->date_str);
+    free(meeting->time_str);
+    free(meeting->notes);
+    free(meeting);
+}
+
 /**
  * @brief Deletes a meeting by ID. Frees memory. DOES NOT SAVE.
  */
 int delete_meeting(AppData* data, int meeting_id) {
     if (!data || !data->meetings_head || meeting_id <= 0) {
-        fprintf(stderr,"delete_meeting: List empty, data is NULL, or invalid ID (%d).\n", meeting_id);
+        LOG_ERROR("delete_meeting: List empty, data is NULL, or invalid ID (%d).", meeting_id);
         return 0; // Failure: Invalid input or empty list
     }
 
@@ -428,23 +895,14 @@ int delete_meeting(AppData* data, int meeting_id) {
 
     // Meeting not found
     if (current == NULL) {
-        fprintf(stderr, "delete_meeting: Meeting with ID %d not found.\n", meeting_id);
+        LOG_ERROR("delete_meeting: Meeting with ID %d not found.", meeting_id);
         return 0; // Failure: Not found
     }
 
-    // Unlink the node
-    if (prev == NULL) { // Head node
-        data->meetings_head = current->next;
-    } else { // Middle or end node
-        prev->next = current->next;
-    }
-
-    // Free the memory
-    free(current->mentee_name);
-    free(current->date_str);
-    free(current->time_str);
-    free(current->notes);
-    free(current);
+    detach_meeting(data, current, prev);
+    UndoEntry* undo = undo_push(data, UNDO_DELETE_MEETING, current);
+    if (undo) undo->prev = prev; // Set aside until the undo scope ends
+    else destroy_meeting(current);
 
     // Saving handled by caller
     // if (!save_data_to_file(data, DATA_FILE)) { ... }
@@ -461,25 +919,133 @@ void free_meetings(Meeting* head) {
     Meeting* next_node;
     while (current != NULL) {
         next_node = current->next;
-        free(current->mentee_name);
-        free(current->date_str);
-        free(current->time_str);
-        free(current->notes);
-        free(current);
+        destroy_meeting(current);
         current = next_node;
     }
 }
+// Search state shared by find_meeting_conflict() and its visitor
+struct ConflictSearch {
+    time_t start;
+    time_t end;
+    int ignore_meeting_id;
+    const Meeting* found;
+};
+
+static int check_meeting_overlap(const Meeting* meeting, void* ctx) {
+    struct ConflictSearch* search = ctx;
+    if (meeting->id == search->ignore_meeting_id || meeting->start_time <= 0) return 1;
+    time_t meeting_end = meeting->start_time + (time_t)meeting->duration_minutes * 60;
+    if (meeting->start_time < search->end && meeting_end > search->start) {
+        search->found = meeting;
+        return 0; // Stop at the first overlap
+    }
+    return 1;
+}
+
+Meeting* find_meeting_conflict(const AppData* data, int mentee_id, time_t start, int duration_minutes, int ignore_meeting_id) {
+    if (!data || start <= 0 || duration_minutes <= 0) return NULL;
+    struct ConflictSearch search = { start, start + (time_t)duration_minutes * 60, ignore_meeting_id, NULL };
+    // Anything starting earlier than this ends before 'start', however long it is
+    time_t earliest = start - (time_t)data->max_meeting_minutes * 60 + 1;
+    for_each_meeting_in_range(data, mentee_id, earliest, search.end, check_meeting_overlap, &search);
+    return (Meeting*)search.found;
+}
+
+// Sweep state for find_free_slots(): busy meetings arrive in start-time order
+struct FreeSlotSweep {
+    time_t cursor;      // Everything before this is accounted for
+    time_t min_length;  // Seconds
+    TimeSlot* out;
+    int max_slots;
+    int count;
+};
+
+static void emit_free_slot(struct FreeSlotSweep* sweep, time_t start, time_t end) {
+    if (end - start < sweep->min_length || sweep->count >= sweep->max_slots) return;
+    sweep->out[sweep->count].start = start;
+    sweep->out[sweep->count].end = end;
+    sweep->count++;
+}
+
+static int sweep_busy_meeting(const Meeting* meeting, void* ctx) {
+    struct FreeSlotSweep* sweep = ctx;
+    if (meeting->start_time <= 0) return 1;
+    time_t meeting_end = meeting->start_time + (time_t)meeting->duration_minutes * 60;
+    if (meeting_end <= sweep->cursor) return 1; // Entirely before the cursor
+    if (meeting->start_time > sweep->cursor) emit_free_slot(sweep, sweep->cursor, meeting->start_time);
+    sweep->cursor = meeting_end;
+    return sweep->count < sweep->max_slots;
+}
+
+int find_free_slots(const AppData* data, time_t from, time_t to, int min_minutes, TimeSlot* out, int max_slots) {
+    if (!data || !out || max_slots <= 0 || from >= to) return 0;
+    struct FreeSlotSweep sweep = { from, (time_t)(min_minutes > 0 ? min_minutes : 1) * 60, out, max_slots, 0 };
+    time_t earliest = from - (time_t)data->max_meeting_minutes * 60 + 1;
+    for_each_meeting_in_range(data, 0, earliest, to, sweep_busy_meeting, &sweep);
+    if (sweep.cursor < to) emit_free_slot(&sweep, sweep.cursor, to);
+    return sweep.count;
+}
+
 
 // ========================================================================== //
 //                             ISSUE FUNCTIONS                                //
 // ========================================================================== //
 
+/**
+ * @brief Clamps enum values read from outside into valid bucket coordinates.
+ */
+static int issue_bucket_valid(IssueStatus status, IssuePriority priority) {
+    return (int)status >= 0 && (int)status < ISSUE_STATUS_COUNT &&
+           (int)priority >= 0 && (int)priority < ISSUE_PRIORITY_COUNT;
+}
+
+/**
+ * @brief Pushes an issue onto the front of its (status, priority) bucket. O(1).
+ */
+static void issue_bucket_link(AppData* data, Issue* issue) {
+    if (!issue_bucket_valid(issue->status, issue->priority)) {
+        issue->status = STATUS_OPEN;
+        issue->priority = PRIORITY_MEDIUM;
+    }
+    Issue** head = &data->issue_buckets[issue->status][issue->priority];
+    issue->bucket_prev = NULL;
+    issue->bucket_next = *head;
+    if (*head) (*head)->bucket_prev = issue;
+    *head = issue;
+    data->issue_bucket_counts[issue->status][issue->priority]++;
+}
+
+/**
+ * @brief Removes an issue from its current bucket. O(1).
+ */
+static void issue_bucket_unlink(AppData* data, Issue* issue) {
+    if (issue->bucket_prev) {
+        issue->bucket_prev->bucket_next = issue->bucket_next;
+    } else {
+        data->issue_buckets[issue->status][issue->priority] = issue->bucket_next;
+    }
+    if (issue->bucket_next) issue->bucket_next->bucket_prev = issue->bucket_prev;
+    issue->bucket_prev = NULL;
+    issue->bucket_next = NULL;
+    data->issue_bucket_counts[issue->status][issue->priority]--;
+}
+
+Issue* issue_bucket_head(const AppData* data, IssueStatus status, IssuePriority priority) {
+    if (!data || !issue_bucket_valid(status, priority)) return NULL;
+    return data->issue_buckets[status][priority];
+}
+
+int issue_bucket_count(const AppData* data, IssueStatus status, IssuePriority priority) {
+    if (!data || !issue_bucket_valid(status, priority)) return 0;
+    return data->issue_bucket_counts[status][priority];
+}
+
 /**
  * @brief Adds a new issue. Assigns ID, duplicates strings. DOES NOT SAVE.
  */
 Issue* add_issue(AppData* data, int mentee_id, const char* mentee_name, const char* description, const char* date_reported, IssuePriority priority) {
      if (!data || mentee_id <= 0 || !mentee_name || !description || !date_reported) {
-         fprintf(stderr, "add_issue: Error - Invalid input data provided.\n");
+         LOG_ERROR("add_issue: Error - Invalid input data provided.");
          return NULL;
      }
 
@@ -494,7 +1060,7 @@ Issue* add_issue(AppData* data, int mentee_id, const char* mentee_name, const ch
     new_issue->date_reported_str = safe_strdup(date_reported);
 
     if (!new_issue->mentee_name || !new_issue->description || !new_issue->date_reported_str) {
-        fprintf(stderr, "add_issue: Failed to duplicate input strings.\n");
+        LOG_ERROR("add_issue: Failed to duplicate input strings.");
         free(new_issue->mentee_name);
         free(new_issue->description);
         free(new_issue->date_reported_str);
@@ -507,8 +1073,12 @@ Issue* add_issue(AppData* data, int mentee_id, const char* mentee_name, const ch
     new_issue->priority = priority;
     new_issue->status = STATUS_OPEN; // New issues always start as Open
     new_issue->response_notes = NULL;
+    account_issue(new_issue, +1);
     new_issue->next = data->issues_head;
     data->issues_head = new_issue;
+    issue_bucket_link(data, new_issue);
+    search_index_issue(data, new_issue);
+    undo_push(data, UNDO_ADD_ISSUE, new_issue);
 
     // Saving handled by caller
     // if (!save_data_to_file(data, DATA_FILE)) { ... }
@@ -534,21 +1104,38 @@ Issue* find_issue_by_id(const AppData* data, int id) {
 /**
  * @brief Updates issue status and optionally adds a note. Does NOT save automatically.
  */
-int update_issue_status(Issue* issue, IssueStatus new_status, const char* note_text) {
-    if (!issue) {
-        fprintf(stderr, "update_issue_status: Error - NULL issue provided.\n");
+int update_issue_status(AppData* data, Issue* issue, IssueStatus new_status, const char* note_text) {
+    if (!data || !issue) {
+        LOG_ERROR("update_issue_status: Error - NULL data or issue provided.");
         return 0; // Failure
     }
 
-    issue->status = new_status;
+    IssueStatus old_status = issue->status;
+    Note* note = NULL;
+
+    // Move between (status, priority) buckets in O(1)
+    if (issue->status != new_status) {
+        issue_bucket_unlink(data, issue);
+        issue->status = new_status;
+        issue_bucket_link(data, issue);
+    }
 
     // Add note only if text is provided and not empty
     if (note_text && strlen(note_text) > 0) {
-        if (!add_note(&(issue->response_notes), note_text)) {
+        note = add_note(&(issue->response_notes), note_text);
+        if (note) {
+            const char* fields[] = { note->text };
+            search_index_add(data->search_index, SEARCH_DOC_NOTE, SEARCH_DOC_ISSUE, issue->id, note, fields, 1);
+        } else {
             // Log warning but don't necessarily fail the status update
-            fprintf(stderr, "Warning: Failed to add response note while updating issue %d status.\n", issue->id);
+            LOG_WARN("Failed to add response note while updating issue %d status.", issue->id);
         }
     }
+    UndoEntry* undo = undo_push(data, UNDO_UPDATE_ISSUE, issue);
+    if (undo) {
+        undo->old_status = old_status;
+        undo->note = note;
+    }
 
     // Saving is handled by caller
     return 1; // Success
@@ -563,6 +1150,7 @@ void free_issues(Issue* head) {
     Issue* next_node;
     while (current != NULL) {
         next_node = current->next;
+        account_issue(current, -1);
         free(current->mentee_name);
         free(current->description);
         free(current->date_reported_str);
@@ -577,17 +1165,33 @@ void free_issues(Issue* head) {
 // ========================================================================== //
 
 /**
- * @brief Adds a new user. Assigns ID, duplicates strings. DOES NOT SAVE.
- * !! WARNING: Stores plain text password !!
+ * @brief Adds a new user, storing a salted hash of 'password'. DOES NOT SAVE.
+ * Hashing takes tens of milliseconds; see add_user_with_hash() for bulk inserts.
  */
 User* add_user(AppData* data, const char* username, const char* password, UserRole role, int associated_id) {
     if (!data || !username || !password) {
-        fprintf(stderr, "add_user: Error - NULL data, username, or password provided.\n");
+        LOG_ERROR("add_user: Error - NULL data, username, or password provided.");
+        return NULL;
+    }
+    char hash[PASSWORD_HASH_SIZE];
+    if (!password_hash(password, hash, sizeof(hash))) {
+        LOG_ERROR("add_user: Failed to hash the password for '%s'.", username);
+        return NULL;
+    }
+    return add_user_with_hash(data, username, hash, role, associated_id);
+}
+
+/**
+ * @brief Adds a new user with an already encoded password hash. DOES NOT SAVE.
+ */
+User* add_user_with_hash(AppData* data, const char* username, const char* hash, UserRole role, int associated_id) {
+    if (!data || !username || !hash) {
+        LOG_ERROR("add_user_with_hash: Error - NULL data, username, or password hash provided.");
         return NULL;
     }
     // Check if username already exists (case-sensitive)
     if (find_user_by_username(data, username)) {
-        fprintf(stderr, "add_user: Error - Username '%s' already exists.\n", username);
+        LOG_ERROR("add_user: Error - Username '%s' already exists.", username);
         return NULL;
     }
 
@@ -598,13 +1202,12 @@ User* add_user(AppData* data, const char* username, const char* password, UserRo
     }
 
     new_user->username = safe_strdup(username);
-    // !! Storing plain text password - Highly Insecure !! Replace with hashing.
-    new_user->password = safe_strdup(password);
+    new_user->password_hash = safe_strdup(hash);
 
-    if (!new_user->username || !new_user->password) {
-        fprintf(stderr, "add_user: Failed to duplicate username/password strings.\n");
+    if (!new_user->username || !new_user->password_hash) {
+        LOG_ERROR("add_user: Failed to duplicate username/password strings.");
         free(new_user->username);
-        free(new_user->password);
+        free(new_user->password_hash);
         free(new_user);
         return NULL;
     }
@@ -612,8 +1215,11 @@ User* add_user(AppData* data, const char* username, const char* password, UserRo
     new_user->id = data->next_user_id++;
     new_user->role = role;
     new_user->associated_id = associated_id; // Can be 0 for admin/mentor not linked to a specific mentee record
+    account_user(new_user, +1);
     new_user->next = data->users_head;
     data->users_head = new_user;
+    index_user(data, new_user);
+    undo_push(data, UNDO_ADD_USER, new_user);
 
     // Save data handled by caller
     // if (!save_data_to_file(data, DATA_FILE)) { ... }
@@ -621,42 +1227,235 @@ User* add_user(AppData* data, const char* username, const char* password, UserRo
 }
 
 /**
- * @brief Finds a user by username (case-sensitive).
+ * @brief Finds a user by username (case-sensitive) via the name index.
  */
 User* find_user_by_username(const AppData* data, const char* username) {
     if (!data || !username) return NULL;
-    User* current = data->users_head;
-    while (current != NULL) {
-        if (current->username && strcmp(current->username, username) == 0) {
-            return current;
+    NameIndexEntry probe = { lowercase_dup(username, strlen(username)), NAME_KEY_USERNAME, NULL };
+    if (!probe.key) return NULL;
+    User* found = NULL;
+    for (SkipListNode* node = skiplist_lower_bound(data->name_index, &probe); node; node = skiplist_next(node)) {
+        const NameIndexEntry* entry = skiplist_value(node);
+        if (entry->kind != NAME_KEY_USERNAME || strcmp(entry->key, probe.key) != 0) break;
+        User* candidate = entry->ref;
+        if (strcmp(candidate->username, username) == 0) {
+            found = candidate;
+            break;
         }
-        current = current->next;
     }
-    return NULL;
+    free(probe.key);
+    return found;
+}
+
+
+int count_orphaned_mentee_users(const AppData* data) {
+    if (!data) return 0;
+    int orphans = 0;
+    for (const User* user = data->users_head; user; user = user->next) {
+        if (user->role == ROLE_MENTEE && !find_mentee_by_id(data, user->associated_id)) orphans++;
+    }
+    return orphans;
+}
+
+void log_memory_report(const AppData* data, const char* when) {
+    MemCategoryStats stats[MEM_CATEGORY_COUNT];
+    memstats_snapshot(stats);
+    long long tracked = 0;
+    LOG_INFO("Memory report (%s):", when ? when : "now");
+    for (int i = 0; i < MEM_CATEGORY_COUNT; ++i) {
+        tracked += stats[i].live_bytes;
+        LOG_INFO("  %-9s %10lld bytes in %8lld objects (peak %lld bytes, %llu allocs / %llu frees)",
+                 memstats_category_name((MemCategory)i), stats[i].live_bytes, stats[i].live_objects,
+                 stats[i].peak_bytes, stats[i].total_allocs, stats[i].total_frees);
+    }
+    LOG_INFO("  tracked total %lld bytes, process RSS %zu bytes", tracked, memstats_process_rss());
+    int orphans = count_orphaned_mentee_users(data);
+    if (orphans > 0) LOG_WARN("  %d mentee user account(s) point at deleted mentees", orphans);
+}
+
+int log_memory_leaks(void) {
+    MemCategoryStats stats[MEM_CATEGORY_COUNT];
+    memstats_snapshot(stats);
+    int leaking = 0;
+    for (int i = 0; i < MEM_CATEGORY_COUNT; ++i) {
+        if (stats[i].live_objects == 0 && stats[i].live_bytes == 0) continue;
+        LOG_WARN("Memory still attributed to %s after cleanup: %lld bytes in %lld objects",
+                 memstats_category_name((MemCategory)i), stats[i].live_bytes, stats[i].live_objects);
+        leaking++;
+    }
+    return leaking;
+}
+
+// ========================================================================== //
+//                           CONSISTENCY CHECK                                //
+// ========================================================================== //
+
+static int compare_int(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_ptr(const void* a, const void* b) {
+    uintptr_t x = (uintptr_t)*(void* const*)a;
+    uintptr_t y = (uintptr_t)*(void* const*)b;
+    return (x > y) - (x < y);
+}
+
+// Sorted snapshot of one record list, for membership and uniqueness checks
+typedef struct {
+    void** ptrs;
+    int* ids;
+    size_t count;
+} RecordSet;
+
+static int contains_ptr(const RecordSet* set, const void* ptr) {
+    return set->count > 0 && bsearch(&ptr, set->ptrs, set->count, sizeof(void*), compare_ptr) != NULL;
 }
 
 /**
- * @brief Verifies username/password. Returns User* if valid, NULL otherwise.
- * !! WARNING: Compares plain text passwords - Highly Insecure !!
+ * @brief Sorts the collected ids/pointers and returns the first repeated id, or 0.
  */
-User* verify_user_password(const AppData* data, const char* username, const char* password) {
-    if (!data || !username || !password) return NULL;
-    User* user = find_user_by_username(data, username);
-    if (!user) {
-        printf("[AUTH DEBUG] User '%s' not found.\n", username); fflush(stdout);
-        return NULL; // User not found
-    }
+static int finish_record_set(RecordSet* set) {
+    if (set->count == 0) return 0;
+    qsort(set->ptrs, set->count, sizeof(void*), compare_ptr);
+    qsort(set->ids, set->count, sizeof(int), compare_int);
+    for (size_t i = 1; i < set->count; ++i) {
+        if (set->ids[i] == set->ids[i - 1]) return set->ids[i];
+    }
+    return 0;
+}
 
-    // !! Plain text comparison - Insecure !! Replace with hash verification.
-    if (user->password && strcmp(user->password, password) == 0) {
-        printf("[AUTH DEBUG] Password match for user '%s'.\n", username); fflush(stdout);
-        return user; // Match
+static int alloc_record_set(RecordSet* set, size_t count) {
+    set->count = 0;
+    set->ptrs = malloc((count ? count : 1) * sizeof(void*));
+    set->ids = malloc((count ? count : 1) * sizeof(int));
+    return set->ptrs && set->ids;
+}
+
+static void free_record_set(RecordSet* set) {
+    free(set->ptrs);
+    free(set->ids);
+}
+
+static size_t count_notes(const Note* head) {
+    size_t n = 0;
+    for (; head; head = head->next) n++;
+    return n;
+}
+
+#define CONSISTENCY_FAIL(...) do { snprintf(problem, problem_cap, __VA_ARGS__); goto done; } while (0)
+
+int check_app_data_consistency(const AppData* data, char* problem, size_t problem_cap) {
+    char scratch[1];
+    if (!problem || problem_cap == 0) { problem = scratch; problem_cap = sizeof(scratch); }
+    problem[0] = '\0';
+    if (!data) { snprintf(problem, problem_cap, "no data"); return 0; }
+
+    size_t mentee_count = 0, meeting_count = 0, issue_count = 0, user_count = 0, search_docs = 0;
+    for (const Mentee* m = data->mentees_head; m; m = m->next) mentee_count++;
+    for (const Meeting* m = data->meetings_head; m; m = m->next) meeting_count++;
+    for (const Issue* i = data->issues_head; i; i = i->next) issue_count++;
+    for (const User* u = data->users_head; u; u = u->next) user_count++;
+
+    RecordSet mentees, meetings, issues, users;
+    int ok = alloc_record_set(&mentees, mentee_count) & alloc_record_set(&meetings, meeting_count) &
+             alloc_record_set(&issues, issue_count) & alloc_record_set(&users, user_count);
+    if (!ok) {
+        snprintf(problem, problem_cap, "out of memory");
+        goto done;
+    }
+    ok = 0;
+
+    // --- Lists: ids unique and below the next-id counters ---
+    for (Mentee* m = data->mentees_head; m; m = m->next) {
+        if (m->id <= 0 || m->id >= data->next_mentee_id) CONSISTENCY_FAIL("mentee id %d outside (0, %d)", m->id, data->next_mentee_id);
+        if (!m->name) CONSISTENCY_FAIL("mentee %d has no name", m->id);
+        mentees.ptrs[mentees.count] = m;
+        mentees.ids[mentees.count++] = m->id;
+        search_docs += 1 + count_notes(m->general_notes);
+    }
+    for (Meeting* m = data->meetings_head; m; m = m->next) {
+        if (m->id <= 0 || m->id >= data->next_meeting_id) CONSISTENCY_FAIL("meeting id %d outside (0, %d)", m->id, data->next_meeting_id);
+        meetings.ptrs[meetings.count] = m;
+        meetings.ids[meetings.count++] = m->id;
+        if (m->notes && m->notes[0]) search_docs++;
+    }
+    for (Issue* i = data->issues_head; i; i = i->next) {
+        if (i->id <= 0 || i->id >= data->next_issue_id) CONSISTENCY_FAIL("issue id %d outside (0, %d)", i->id, data->next_issue_id);
+        issues.ptrs[issues.count] = i;
+        issues.ids[issues.count++] = i->id;
+        search_docs += 1 + count_notes(i->response_notes);
+    }
+    for (User* u = data->users_head; u; u = u->next) {
+        if (u->id <= 0 || u->id >= data->next_user_id) CONSISTENCY_FAIL("user id %d outside (0, %d)", u->id, data->next_user_id);
+        users.ptrs[users.count] = u;
+        users.ids[users.count++] = u->id;
+    }
+    int dup;
+    if ((dup = finish_record_set(&mentees)) != 0) CONSISTENCY_FAIL("duplicate mentee id %d", dup);
+    if ((dup = finish_record_set(&meetings)) != 0) CONSISTENCY_FAIL("duplicate meeting id %d", dup);
+    if ((dup = finish_record_set(&issues)) != 0) CONSISTENCY_FAIL("duplicate issue id %d", dup);
+    if ((dup = finish_record_set(&users)) != 0) CONSISTENCY_FAIL("duplicate user id %d", dup);
+
+    // --- Skip list indexes hold exactly the live records ---
+    if (skiplist_size(data->mentees_by_id) != mentee_count)
+        CONSISTENCY_FAIL("mentees_by_id has %zu entries for %zu mentees", skiplist_size(data->mentees_by_id), mentee_count);
+    for (SkipListNode* n = skiplist_first(data->mentees_by_id); n; n = skiplist_next(n)) {
+        if (!contains_ptr(&mentees, skiplist_value(n))) CONSISTENCY_FAIL("mentees_by_id references a mentee not in the list");
+    }
+    if (skiplist_size(data->meetings_by_time) != meeting_count)
+        CONSISTENCY_FAIL("meetings_by_time has %zu entries for %zu meetings", skiplist_size(data->meetings_by_time), meeting_count);
+    if (skiplist_size(data->meetings_by_mentee) != meeting_count)
+        CONSISTENCY_FAIL("meetings_by_mentee has %zu entries for %zu meetings", skiplist_size(data->meetings_by_mentee), meeting_count);
+    for (SkipListNode* n = skiplist_first(data->meetings_by_time); n; n = skiplist_next(n)) {
+        if (!contains_ptr(&meetings, skiplist_value(n))) CONSISTENCY_FAIL("meetings_by_time references a meeting not in the list");
+    }
+    for (SkipListNode* n = skiplist_first(data->meetings_by_mentee); n; n = skiplist_next(n)) {
+        if (!contains_ptr(&meetings, skiplist_value(n))) CONSISTENCY_FAIL("meetings_by_mentee references a meeting not in the list");
+    }
+    for (SkipListNode* n = skiplist_first(data->name_index); n; n = skiplist_next(n)) {
+        const NameIndexEntry* entry = skiplist_value(n);
+        const RecordSet* owner = entry->kind == NAME_KEY_USERNAME ? &users : &mentees;
+        if (!contains_ptr(owner, entry->ref)) CONSISTENCY_FAIL("name index key '%s' references a deleted record", entry->key);
+    }
+    for (const User* u = data->users_head; u; u = u->next) {
+        if (find_user_by_username(data, u->username) != u) CONSISTENCY_FAIL("user '%s' is not found by username", u->username);
+    }
+
+    // --- Issue buckets partition the issue list ---
+    size_t bucketed = 0;
+    for (int s = 0; s < ISSUE_STATUS_COUNT; ++s) {
+        for (int p = 0; p < ISSUE_PRIORITY_COUNT; ++p) {
+            int count = 0;
+            const Issue* prev = NULL;
+            for (const Issue* i = data->issue_buckets[s][p]; i; prev = i, i = i->bucket_next) {
+                if (!contains_ptr(&issues, i)) CONSISTENCY_FAIL("bucket [%d][%d] references an issue not in the list", s, p);
+                if ((int)i->status != s || (int)i->priority != p) CONSISTENCY_FAIL("issue %d is in the wrong bucket", i->id);
+                if (i->bucket_prev != prev) CONSISTENCY_FAIL("issue %d has a broken bucket_prev link", i->id);
+                if (++count > (int)issue_count) CONSISTENCY_FAIL("bucket [%d][%d] has a cycle", s, p);
+            }
+            if (count != data->issue_bucket_counts[s][p])
+                CONSISTENCY_FAIL("bucket [%d][%d] holds %d issues but counts %d", s, p, count, data->issue_bucket_counts[s][p]);
+            bucketed += (size_t)count;
+        }
     }
+    if (bucketed != issue_count) CONSISTENCY_FAIL("buckets hold %zu issues for %zu in the list", bucketed, issue_count);
+
+    if (search_index_document_count(data->search_index) != search_docs)
+        CONSISTENCY_FAIL("search index has %zu documents, expected %zu", search_index_document_count(data->search_index), search_docs);
+    ok = 1;
 
-    printf("[AUTH DEBUG] Password mismatch for user '%s'.\n", username); fflush(stdout);
-    return NULL; // Password mismatch
+done:
+    free_record_set(&mentees);
+    free_record_set(&meetings);
+    free_record_set(&issues);
+    free_record_set(&users);
+    return ok;
 }
 
+#undef CONSISTENCY_FAIL
+
 /**
  * @brief Frees all User structs and their data in a list. (Internal use for cleanup).
  */
@@ -665,13 +1464,164 @@ void free_users(User* head) {
     User* next_node;
     while (current != NULL) {
         next_node = current->next;
+        account_user(current, -1);
         free(current->username);
-        free(current->password); // Free the plain text password
+        free(current->password_hash);
         free(current);
         current = next_node;
     }
 }
 
+// ========================================================================== //
+//                               UNDO SCOPES                                  //
+// ========================================================================== //
+
+// Finds the list predecessor of a record about to be removed. Undoing an add
+// happens when that record is the newest again, i.e. the list head: O(1).
+static Mentee* mentee_predecessor(Mentee* head, Mentee* record) {
+    Mentee* prev = NULL;
+    for (Mentee* it = head; it && it != record; it = it->next) prev = it;
+    return prev;
+}
+
+static Meeting* meeting_predecessor(Meeting* head, Meeting* record) {
+    Meeting* prev = NULL;
+    for (Meeting* it = head; it && it != record; it = it->next) prev = it;
+    return prev;
+}
+
+// Removes a note pushed onto the front of 'head' by the change being undone
+static void undo_note(AppData* data, Note** head, Note* note) {
+    if (!note || *head != note) return;
+    *head = note->next;
+    search_index_remove(data->search_index, note);
+    note->next = NULL;
+    free_notes(note);
+}
+
+static void undo_entry(AppData* data, UndoEntry* entry) {
+    switch (entry->kind) {
+    case UNDO_ADD_MENTEE: {
+        Mentee* mentee = entry->record;
+        detach_mentee(data, mentee, mentee_predecessor(data->mentees_head, mentee));
+        data->next_mentee_id = mentee->id;
+        destroy_mentee(mentee);
+        break;
+    }
+    case UNDO_ADD_MENTEE_NOTE:
+        undo_note(data, &((Mentee*)entry->record)->general_notes, entry->note);
+        break;
+    case UNDO_DELETE_MENTEE:
+        attach_mentee(data, entry->record, entry->prev);
+        break;
+    case UNDO_ADD_MEETING: {
+        Meeting* meeting = entry->record;
+        detach_meeting(data, meeting, meeting_predecessor(data->meetings_head, meeting));
+        data->next_meeting_id = meeting->id;
+        destroy_meeting(meeting);
+        break;
+    }
+    case UNDO_UPDATE_MEETING: {
+        Meeting* meeting = entry->record;
+        account_string(meeting->date_str, -1);
+        account_string(meeting->time_str, -1);
+        account_string(entry->old_date, +1);
+        account_string(entry->old_time, +1);
+        unindex_meeting(data, meeting);
+        free(meeting->date_str);
+        free(meeting->time_str);
+        meeting->date_str = entry->old_date;
+        meeting->time_str = entry->old_time;
+        meeting->start_time = parse_meeting_datetime(meeting->date_str, meeting->time_str);
+        index_meeting(data, meeting);
+        entry->old_date = entry->old_time = NULL; // Back in the meeting
+        break;
+    }
+    case UNDO_DELETE_MEETING:
+        attach_meeting(data, entry->record, entry->prev);
+        break;
+    case UNDO_ADD_ISSUE: {
+        Issue* issue = entry->record;
+        Issue** link = &data->issues_head;
+        while (*link && *link != issue) link = &(*link)->next;
+        if (*link) *link = issue->next;
+        issue_bucket_unlink(data, issue);
+        search_index_remove(data->search_index, issue);
+        search_unindex_notes(data, issue->response_notes);
+        data->next_issue_id = issue->id;
+        issue->next = NULL;
+        free_issues(issue);
+        break;
+    }
+    case UNDO_UPDATE_ISSUE: {
+        Issue* issue = entry->record;
+        undo_note(data, &issue->response_notes, entry->note);
+        if (issue->status != entry->old_status) {
+            issue_bucket_unlink(data, issue);
+            issue->status = entry->old_status;
+            issue_bucket_link(data, issue);
+        }
+        break;
+    }
+    case UNDO_ADD_USER: {
+        User* user = entry->record;
+        User** link = &data->users_head;
+        while (*link && *link != user) link = &(*link)->next;
+        if (*link) *link = user->next;
+        if (user->username) name_index_delete(data, user->username, strlen(user->username), NAME_KEY_USERNAME, user);
+        data->next_user_id = user->id;
+        user->next = NULL;
+        free_users(user);
+        break;
+    }
+    }
+}
+
+// Ends the scope, freeing whatever the log still holds
+static void end_undo_scope(AppData* data) {
+    UndoEntry* entry = data->undo_log;
+    while (entry) {
+        UndoEntry* next = entry->next;
+        if (entry->kind == UNDO_DELETE_MENTEE) destroy_mentee(entry->record);
+        else if (entry->kind == UNDO_DELETE_MEETING) destroy_meeting(entry->record);
+        free(entry->old_date);
+        free(entry->old_time);
+        free(entry);
+        entry = next;
+    }
+    data->undo_log = NULL;
+    data->undo_active = 0;
+    data->undo_incomplete = 0;
+}
+
+void begin_undo_scope(AppData* data) {
+    if (!data) return;
+    if (data->undo_active) LOG_WARN("begin_undo_scope: A scope is already open; it now covers both.");
+    data->undo_active = 1;
+}
+
+void commit_undo_scope(AppData* data) {
+    if (data) end_undo_scope(data);
+}
+
+int rollback_undo_scope(AppData* data) {
+    if (!data) return 0;
+    int complete = !data->undo_incomplete;
+    if (complete) {
+        data->undo_active = 0; // Undoing must not record
+        UndoEntry* entry = data->undo_log;
+        while (entry) { // Newest first
+            UndoEntry* next = entry->next;
+            undo_entry(data, entry); // Takes back anything the entry set aside
+            free(entry);
+            entry = next;
+        }
+        data->undo_log = NULL;
+    }
+    end_undo_scope(data); // Incomplete: the changes stay, as on commit
+    return complete;
+}
+
 // ========================================================================== //
 //                      INITIALIZATION / CLEANUP FUNCTIONS                    //
 // ========================================================================== //
@@ -679,13 +1629,44 @@ void free_users(User* head) {
 // Global variable to hold the default data file path, potentially set by main
 static const char* global_data_file_path = "Backend/mentorship_data.json"; // Default path
 
+/**
+ * @brief Creates the (empty) in-memory indexes of a freshly allocated AppData.
+ */
+static int init_app_data_indexes(AppData* data) {
+    data->max_meeting_minutes = 0;
+    memset(data->meeting_duration_counts, 0, sizeof(data->meeting_duration_counts));
+    memset(data->issue_buckets, 0, sizeof(data->issue_buckets));
+    memset(data->issue_bucket_counts, 0, sizeof(data->issue_bucket_counts));
+    data->meetings_by_time = skiplist_create(compare_meeting_by_time);
+    data->meetings_by_mentee = skiplist_create(compare_meeting_by_mentee);
+    data->search_index = search_index_create();
+    data->mentees_by_id = skiplist_create(compare_mentee_by_id);
+    data->name_index = skiplist_create(compare_name_entry);
+    if (!data->meetings_by_time || !data->meetings_by_mentee || !data->search_index ||
+        !data->mentees_by_id || !data->name_index) {
+        LOG_ERROR("init_app_data_indexes: Failed to create in-memory indexes.");
+        skiplist_free(data->meetings_by_time);
+        skiplist_free(data->meetings_by_mentee);
+        search_index_free(data->search_index);
+        skiplist_free(data->mentees_by_id);
+        skiplist_free(data->name_index);
+        data->meetings_by_time = NULL;
+        data->meetings_by_mentee = NULL;
+        data->search_index = NULL;
+        data->mentees_by_id = NULL;
+        data->name_index = NULL;
+        return 0;
+    }
+    return 1;
+}
+
 /**
  * @brief Sets the global path for the data file. Should be called once at startup.
  */
 void set_data_file_path(const char* path) {
     if (path) {
         global_data_file_path = path;
-         printf("Data file path set to: %s\n", global_data_file_path); fflush(stdout);
+         LOG_INFO("Data file path set to: %s", global_data_file_path);
     }
 }
 
@@ -694,34 +1675,23 @@ void set_data_file_path(const char* path) {
  */
 AppData* initialize_app_data() {
     // Use the global path set by set_data_file_path (or the default)
-    printf("Attempting to load data from: %s\n", global_data_file_path); fflush(stdout);
+    LOG_INFO("Attempting to load data from: %s", global_data_file_path);
     AppData* data = load_data_from_file(global_data_file_path);
     if (data) {
-        printf("Successfully loaded data from %s\n", global_data_file_path); fflush(stdout);
+        LOG_INFO("Successfully loaded data from %s", global_data_file_path);
+        // The file parsed, so rewriting it is safe; until then the plain text stays on disk
+        if (data->migrated_passwords > 0 && save_data_to_file(data, global_data_file_path)) data->migrated_passwords = 0;
         return data;
     }
 
     // If loading failed, create a new structure
-    printf("Initializing new data structure (load failed or file not found at %s).\n", global_data_file_path); fflush(stdout);
-    data = malloc(sizeof(AppData));
-    if (!data) {
-        perror("initialize_app_data: malloc failed");
-        return NULL;
-    }
-
-    // Initialize empty lists and IDs
-    data->mentees_head = NULL;
-    data->meetings_head = NULL;
-    data->issues_head = NULL;
-    data->users_head = NULL;
-    data->next_mentee_id = 1;
-    data->next_meeting_id = 1;
-    data->next_issue_id = 1;
-    data->next_user_id = 1; // Start user IDs from 1
+    LOG_INFO("Initializing new data structure (load failed or file not found at %s).", global_data_file_path);
+    data = create_empty_app_data();
+    if (!data) return NULL;
 
     // Create default users only if creating a brand new data structure
     // Do NOT save immediately here, let the caller handle the first save if needed.
-    printf("Creating default users (admin/mentor, user/mentee) for new data file.\n"); fflush(stdout);
+    LOG_INFO("Creating default users (admin/mentor, user/mentee) for new data file.");
     // Add mentor (admin/password) - associated_id 0 indicates no specific mentee link
     add_user(data, "admin", "password", ROLE_MENTOR, 0); // INSECURE! add_user doesn't save
     // Add mentee (user/password) - Needs a corresponding mentee record eventually, associate with 0 for now? Or 1?
@@ -735,18 +1705,54 @@ AppData* initialize_app_data() {
 }
 
 
+/**
+ * @brief Allocates an AppData with no records, no users and empty indexes.
+ */
+AppData* create_empty_app_data(void) {
+    AppData* data = malloc(sizeof(AppData));
+    if (!data) {
+        perror("create_empty_app_data: malloc failed");
+        return NULL;
+    }
+
+    // Initialize empty lists and IDs
+    data->mentees_head = NULL;
+    data->meetings_head = NULL;
+    data->issues_head = NULL;
+    data->users_head = NULL;
+    data->next_mentee_id = 1;
+    data->next_meeting_id = 1;
+    data->next_issue_id = 1;
+    data->next_user_id = 1; // Start user IDs from 1
+    data->migrated_passwords = 0;
+    data->undo_active = 0;
+    data->undo_incomplete = 0;
+    data->undo_log = NULL;
+    if (!init_app_data_indexes(data)) {
+        free(data);
+        return NULL;
+    }
+    return data;
+}
+
 /**
  * @brief Frees all memory associated with the AppData structure.
  */
 void free_app_data(AppData* data) {
     if (!data) return;
-    printf("Freeing application data...\n"); fflush(stdout);
+    LOG_INFO("Freeing application data...");
+    end_undo_scope(data); // Frees records a still open scope set aside
     free_mentees(data->mentees_head);
     free_meetings(data->meetings_head);
     free_issues(data->issues_head);
     free_users(data->users_head);
+    skiplist_free(data->meetings_by_time);
+    skiplist_free(data->meetings_by_mentee);
+    search_index_free(data->search_index);
+    skiplist_free(data->mentees_by_id);
+    free_name_index(data->name_index);
     free(data);
-    printf("Application data freed.\n"); fflush(stdout);
+    LOG_INFO("Application data freed.");
 }
 
 
@@ -769,15 +1775,20 @@ extern cJSON* user_to_json(const User* user);
  */
 int save_data_to_file(const AppData* data, const char* filename) {
     const char* path_to_use = filename ? filename : global_data_file_path;
-    printf("Attempting to save data to: %s\n", path_to_use); fflush(stdout);
+    LOG_DEBUG("Attempting to save data to: %s", path_to_use);
 
     if (!data || !path_to_use) {
-        fprintf(stderr, "save_data_to_file: Error - NULL data or filename provided.\n");
+        LOG_ERROR("save_data_to_file: Error - NULL data or filename provided.");
         return 0; // Failure
     }
+    TraceSpan persist_span = trace_begin("persist");
+    uint64_t save_started_ns = metrics_now_ns();
+    size_t bytes_written = 0;
     cJSON* root = cJSON_CreateObject();
     if (!root) {
-        fprintf(stderr, "save_data_to_file: Failed to create root JSON object.\n");
+        LOG_ERROR("save_data_to_file: Failed to create root JSON object.");
+        metrics_record_save(metrics_now_ns() - save_started_ns, 0, 0);
+        trace_end(persist_span);
         return 0; // Failure
     }
 
@@ -789,7 +1800,7 @@ int save_data_to_file(const AppData* data, const char* filename) {
         !cJSON_AddNumberToObject(root, "next_issue_id", data->next_issue_id) ||
         !cJSON_AddNumberToObject(root, "next_user_id", data->next_user_id))
     {
-        fprintf(stderr, "save_data_to_file: Failed to add metadata to JSON.\n");
+        LOG_ERROR("save_data_to_file: Failed to add metadata to JSON.");
         success = 0; goto cleanup_json; // Use goto for cleanup on failure
     }
 
@@ -800,7 +1811,7 @@ int save_data_to_file(const AppData* data, const char* filename) {
     while (cm) {
         cJSON* mo = mentee_to_json(cm); // mentee_to_json is in json_helpers.c
         if (!mo || !cJSON_AddItemToArray(mentees_a, mo)) {
-            fprintf(stderr, "save_data_to_file: Failed to add mentee %d to JSON array.\n", cm->id);
+            LOG_ERROR("save_data_to_file: Failed to add mentee %d to JSON array.", cm->id);
             cJSON_Delete(mo); success = 0; goto cleanup_mentees_array; // Clean up partially added array item
         }
         cm = cm->next;
@@ -811,7 +1822,7 @@ int save_data_to_file(const AppData* data, const char* filename) {
     // Don't goto cleanup_mentees_array from here if AddItemToObject fails,
     // as the array is now owned by root. Let root cleanup handle it.
     if (!cJSON_GetObjectItem(root, "mentees")) { // Check if add failed silently
-        fprintf(stderr, "save_data_to_file: Failed to add mentees array to root JSON.\n");
+        LOG_ERROR("save_data_to_file: Failed to add mentees array to root JSON.");
         success = 0; goto cleanup_json;
     }
 
@@ -823,7 +1834,7 @@ int save_data_to_file(const AppData* data, const char* filename) {
     while (cmeet) {
         cJSON* meeto = meeting_to_json(cmeet); // meeting_to_json is in json_helpers.c
         if (!meeto || !cJSON_AddItemToArray(meetings_a, meeto)) {
-            fprintf(stderr, "save_data_to_file: Failed to add meeting %d to JSON array.\n", cmeet->id);
+            LOG_ERROR("save_data_to_file: Failed to add meeting %d to JSON array.", cmeet->id);
             cJSON_Delete(meeto); success = 0; goto cleanup_meetings_array;
         }
         cmeet = cmeet->next;
@@ -832,7 +1843,7 @@ int save_data_to_file(const AppData* data, const char* filename) {
          success = 0; goto cleanup_meetings_array; // Array not owned by root yet
     }
      if (!cJSON_GetObjectItem(root, "meetings")) { // Check if add failed silently
-        fprintf(stderr, "save_data_to_file: Failed to add meetings array to root JSON.\n");
+        LOG_ERROR("save_data_to_file: Failed to add meetings array to root JSON.");
         success = 0; goto cleanup_json;
     }
 
@@ -843,7 +1854,7 @@ int save_data_to_file(const AppData* data, const char* filename) {
     while (ciss) {
         cJSON* isso = issue_to_json(ciss); // issue_to_json is in json_helpers.c
         if (!isso || !cJSON_AddItemToArray(issues_a, isso)) {
-             fprintf(stderr, "save_data_to_file: Failed to add issue %d to JSON array.\n", ciss->id);
+             LOG_ERROR("save_data_to_file: Failed to add issue %d to JSON array.", ciss->id);
             cJSON_Delete(isso); success = 0; goto cleanup_issues_array;
         }
         ciss = ciss->next;
@@ -852,7 +1863,7 @@ int save_data_to_file(const AppData* data, const char* filename) {
          success = 0; goto cleanup_issues_array; // Array not owned by root yet
      }
       if (!cJSON_GetObjectItem(root, "issues")) { // Check if add failed silently
-        fprintf(stderr, "save_data_to_file: Failed to add issues array to root JSON.\n");
+        LOG_ERROR("save_data_to_file: Failed to add issues array to root JSON.");
         success = 0; goto cleanup_json;
     }
 
@@ -863,7 +1874,7 @@ int save_data_to_file(const AppData* data, const char* filename) {
     while (cu) {
         cJSON* usero = user_to_json(cu); // user_to_json is in json_helpers.c
         if (!usero || !cJSON_AddItemToArray(users_a, usero)) {
-            fprintf(stderr, "save_data_to_file: Failed to add user %d to JSON array.\n", cu->id);
+            LOG_ERROR("save_data_to_file: Failed to add user %d to JSON array.", cu->id);
             cJSON_Delete(usero); success = 0; goto cleanup_users_array;
         }
         cu = cu->next;
@@ -872,7 +1883,7 @@ int save_data_to_file(const AppData* data, const char* filename) {
          success = 0; goto cleanup_users_array; // Array not owned by root yet
     }
      if (!cJSON_GetObjectItem(root, "users")) { // Check if add failed silently
-        fprintf(stderr, "save_data_to_file: Failed to add users array to root JSON.\n");
+        LOG_ERROR("save_data_to_file: Failed to add users array to root JSON.");
         success = 0; goto cleanup_json;
     }
 
@@ -881,7 +1892,7 @@ int save_data_to_file(const AppData* data, const char* filename) {
     // Use cJSON_PrintBuffered for potentially better performance? Or just cJSON_Print.
     char* json_string = cJSON_Print(root);
     if (!json_string) {
-        fprintf(stderr, "save_data_to_file: Failed to print JSON to string.\n");
+        LOG_ERROR("save_data_to_file: Failed to print JSON to string.");
         success = 0; goto cleanup_json;
     }
 
@@ -895,15 +1906,17 @@ int save_data_to_file(const AppData* data, const char* filename) {
     if (fprintf(fp, "%s", json_string) < 0) {
         perror("save_data_to_file: fprintf failed");
         success = 0; // Mark failure but still try to close/free
+    } else {
+        bytes_written = strlen(json_string);
     }
 
     fclose(fp);
     free(json_string); // Free the string after writing
 
     if (success) {
-        printf("Data successfully saved to %s.\n", path_to_use); fflush(stdout);
+        LOG_INFO("Data successfully saved to %s.", path_to_use);
     } else {
-         fprintf(stderr, "Error occurred during saving to %s.\n", path_to_use); fflush(stderr);
+         LOG_ERROR("Error occurred during saving to %s.", path_to_use);
     }
 
     goto cleanup_json; // Go to final cleanup
@@ -924,6 +1937,8 @@ cleanup_mentees_array:
 
 cleanup_json:
     cJSON_Delete(root); // Safely deletes root and all attached items
+    metrics_record_save(metrics_now_ns() - save_started_ns, bytes_written, success);
+    trace_end(persist_span);
     return success;
 }
 
@@ -934,10 +1949,10 @@ cleanup_json:
  */
 AppData* load_data_from_file(const char* filename) {
     if (!filename) {
-        fprintf(stderr, "load_data_from_file: Error - NULL filename provided.\n");
+        LOG_ERROR("load_data_from_file: Error - NULL filename provided.");
         return NULL;
     }
-    printf("Loading data from file: %s\n", filename); fflush(stdout);
+    LOG_DEBUG("Loading data from file: %s", filename);
 
     FILE* fp = fopen(filename, "r");
     if (!fp) {
@@ -945,7 +1960,7 @@ AppData* load_data_from_file(const char* filename) {
         if (errno != ENOENT) {
             perror("load_data_from_file: fopen failed");
         } else {
-             printf("load_data_from_file: File not found (errno=%d).\n", errno); fflush(stdout);
+             LOG_INFO("load_data_from_file: File not found (errno=%d).", errno);
         }
         return NULL; // Indicate failure (file not found or other error)
     }
@@ -960,7 +1975,7 @@ AppData* load_data_from_file(const char* filename) {
          return NULL;
     }
      if (size == 0){ // Handle empty file case
-         printf("load_data_from_file: File is empty.\n"); fflush(stdout);
+         LOG_INFO("load_data_from_file: File is empty.");
          fclose(fp);
          return NULL; // Treat empty file as load failure for now
      }
@@ -977,7 +1992,7 @@ AppData* load_data_from_file(const char* filename) {
     fclose(fp); // Close file immediately after reading
 
     if (bytes_read != (size_t)size) {
-        fprintf(stderr, "load_data_from_file: fread failed (read %zu bytes, expected %ld).\n", bytes_read, size);
+        LOG_ERROR("load_data_from_file: fread failed (read %zu bytes, expected %ld).", bytes_read, size);
         free(buffer);
         return NULL;
     }
@@ -988,7 +2003,7 @@ AppData* load_data_from_file(const char* filename) {
     free(buffer); // Free buffer immediately after parsing
     if (!root) {
         const char *error_ptr = cJSON_GetErrorPtr();
-        fprintf(stderr, "load_data_from_file: JSON Parse Error near: %s\n", error_ptr ? error_ptr : "(unknown)");
+        LOG_ERROR("load_data_from_file: JSON Parse Error near: %s", error_ptr ? error_ptr : "(unknown)");
         return NULL;
     }
 
@@ -1004,6 +2019,15 @@ AppData* load_data_from_file(const char* filename) {
     data->meetings_head = NULL;
     data->issues_head = NULL;
     data->users_head = NULL;
+    data->migrated_passwords = 0;
+    data->undo_active = 0;
+    data->undo_incomplete = 0;
+    data->undo_log = NULL;
+    if (!init_app_data_indexes(data)) {
+        free(data);
+        cJSON_Delete(root);
+        return NULL;
+    }
 
     // --- Load Metadata (Counters) ---
     // Provide defaults if items are missing or invalid
@@ -1016,8 +2040,8 @@ AppData* load_data_from_file(const char* filename) {
     data->next_issue_id = (cJSON_IsNumber(item) && item->valuedouble >= 1) ? (int)item->valuedouble : 1;
     item = cJSON_GetObjectItemCaseSensitive(root, "next_user_id");
     data->next_user_id = (cJSON_IsNumber(item) && item->valuedouble >= 1) ? (int)item->valuedouble : 1;
-     printf("Loaded next IDs: Mentee=%d, Meeting=%d, Issue=%d, User=%d\n",
-            data->next_mentee_id, data->next_meeting_id, data->next_issue_id, data->next_user_id); fflush(stdout);
+     LOG_DEBUG("Loaded next IDs: Mentee=%d, Meeting=%d, Issue=%d, User=%d",
+            data->next_mentee_id, data->next_meeting_id, data->next_issue_id, data->next_user_id);
 
 
    // --- Load Mentees ---
@@ -1025,20 +2049,20 @@ AppData* load_data_from_file(const char* filename) {
    int mentees_loaded_count = 0;
    int mentees_processed_count = 0; // Counter for JSON entries processed
    if (cJSON_IsArray(mentees_j)) {
-       printf("    [Mentee Load] Found 'mentees' array. Processing items...\n"); fflush(stdout);
+       LOG_DEBUG("[Mentee Load] Found 'mentees' array. Processing items...");
        cJSON* mi;
        cJSON_ArrayForEach(mi, mentees_j) {
            mentees_processed_count++;
-           printf("    [Mentee Load] Processing JSON item #%d\n", mentees_processed_count); fflush(stdout);
+           LOG_DEBUG("[Mentee Load] Processing JSON item #%d", mentees_processed_count);
 
            if (!cJSON_IsObject(mi)) {
-               printf("    [Mentee Load] Item #%d is not a JSON object. Skipping.\n", mentees_processed_count); fflush(stdout);
+               LOG_DEBUG("[Mentee Load] Item #%d is not a JSON object. Skipping.", mentees_processed_count);
                continue; // Skip if not an object
            }
 
            Mentee* m = malloc(sizeof(Mentee));
            if (!m) {
-               fprintf(stderr, "    [Mentee Load] Warning: malloc failed for Mentee struct, skipping item #%d.\n", mentees_processed_count); fflush(stderr);
+               LOG_WARN("[Mentee Load] malloc failed for Mentee struct, skipping item #%d.", mentees_processed_count);
                continue;
            }
 
@@ -1051,30 +2075,31 @@ AppData* load_data_from_file(const char* filename) {
            m->next = NULL;
 
            // Log extracted data before validation
-           printf("    [Mentee Load] Extracted item #%d -> ID: %d, Name: '%s', Subject: '%s'\n",
+           LOG_DEBUG("[Mentee Load] Extracted item #%d -> ID: %d, Name: '%s', Subject: '%s'",
                   mentees_processed_count, m->id, m->name ? m->name : "NULL", m->subject ? m->subject : "NULL");
-           fflush(stdout);
 
            // Basic validation
            if (m->id == 0 || !m->name || !m->subject || (m->name && strlen(m->name)==0) || (m->subject && strlen(m->subject)==0) ) {
-               fprintf(stderr, "    [Mentee Load] Warning: Skipping loaded mentee item #%d due to invalid/missing required data (ID: %d, Name: '%s', Subject: '%s').\n",
+               LOG_WARN("[Mentee Load] Skipping loaded mentee item #%d due to invalid/missing required data (ID: %d, Name: '%s', Subject: '%s').",
                       mentees_processed_count, m->id, m->name ? m->name : "NULL", m->subject ? m->subject : "NULL");
-               fflush(stderr);
                // Free allocated memory for this invalid entry
                free(m->name); free(m->subject); free(m->email); free_notes(m->general_notes); free(m);
                continue; // Skip this invalid entry
            }
 
            // Add to head of list
-           printf("    [Mentee Load] Validation passed for item #%d (ID: %d). Adding to list.\n", mentees_processed_count, m->id); fflush(stdout);
+           LOG_DEBUG("[Mentee Load] Validation passed for item #%d (ID: %d). Adding to list.", mentees_processed_count, m->id);
            m->next = data->mentees_head;
            data->mentees_head = m;
+           account_mentee(m, +1);
+           index_mentee(data, m);
+           search_index_mentee(data, m);
            mentees_loaded_count++;
        }
-        printf("    [Mentee Load] Finished processing %d JSON items.\n", mentees_processed_count); fflush(stdout);
-        printf("Loaded %d mentees from file.\n", mentees_loaded_count); fflush(stdout); // Final count
+        LOG_DEBUG("[Mentee Load] Finished processing %d JSON items.", mentees_processed_count);
+        LOG_INFO("Loaded %d mentees from file.", mentees_loaded_count); // Final count
    } else {
-        fprintf(stderr, "Warning: No 'mentees' array found or it's not an array in JSON data.\n"); fflush(stderr);
+        LOG_WARN("No 'mentees' array found or it's not an array in JSON data.");
    }
    // --- End Load Mentees ---
 
@@ -1087,7 +2112,7 @@ AppData* load_data_from_file(const char* filename) {
         cJSON_ArrayForEach(meeti, meetings_j) {
             if (!cJSON_IsObject(meeti)) continue;
             Meeting* m = malloc(sizeof(Meeting));
-            if (!m) { fprintf(stderr, "Warning: malloc failed for Meeting struct, skipping entry.\n"); continue; }
+            if (!m) { LOG_WARN("malloc failed for Meeting struct, skipping entry."); continue; }
 
             m->id = (int)cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(meeti,"id"));
             m->mentee_id = (int)cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(meeti,"mentee_id"));
@@ -1103,18 +2128,26 @@ AppData* load_data_from_file(const char* filename) {
 
             // Basic validation
             if (m->id==0 || m->mentee_id==0 || !m->mentee_name || !m->date_str || !m->time_str || m->duration_minutes <= 0 || (m->mentee_name && strlen(m->mentee_name)==0)) {
-                 fprintf(stderr, "Warning: Skipping loaded meeting with invalid/missing required data (ID: %d).\n", m->id);
+                 LOG_WARN("Skipping loaded meeting with invalid/missing required data (ID: %d).", m->id);
                  free(m->mentee_name); free(m->date_str); free(m->time_str); free(m->notes); free(m);
                  continue;
              }
+            if (m->duration_minutes > MAX_MEETING_MINUTES) {
+                LOG_WARN("Loaded meeting %d lasts %d minutes; capping it at %d.", m->id, m->duration_minutes, MAX_MEETING_MINUTES);
+                m->duration_minutes = MAX_MEETING_MINUTES;
+            }
             // Add to head
+            m->start_time = parse_meeting_datetime(m->date_str, m->time_str);
             m->next = data->meetings_head;
             data->meetings_head = m;
+            account_meeting(m, +1);
+            index_meeting(data, m);
+            search_index_meeting(data, m);
             meetings_loaded_count++;
         }
-         printf("Loaded %d meetings from file.\n", meetings_loaded_count); fflush(stdout);
+         LOG_INFO("Loaded %d meetings from file.", meetings_loaded_count);
     } else {
-         printf("No 'meetings' array found or it's not an array in JSON data.\n"); fflush(stdout);
+         LOG_INFO("No 'meetings' array found or it's not an array in JSON data.");
     }
 
 
@@ -1126,7 +2159,7 @@ AppData* load_data_from_file(const char* filename) {
         cJSON_ArrayForEach(issi, issues_j) {
             if (!cJSON_IsObject(issi)) continue;
             Issue* i = malloc(sizeof(Issue));
-            if (!i) { fprintf(stderr, "Warning: malloc failed for Issue struct, skipping entry.\n"); continue; }
+            if (!i) { LOG_WARN("malloc failed for Issue struct, skipping entry."); continue; }
 
             i->id = (int)cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(issi,"id"));
             i->mentee_id = (int)cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(issi,"mentee_id"));
@@ -1143,18 +2176,21 @@ AppData* load_data_from_file(const char* filename) {
 
              // Basic validation
              if (i->id==0 || i->mentee_id==0 || !i->mentee_name || !i->description || !i->date_reported_str || (i->mentee_name && strlen(i->mentee_name)==0) || (i->description && strlen(i->description)==0)) {
-                 fprintf(stderr, "Warning: Skipping loaded issue with invalid/missing required data (ID: %d).\n", i->id);
+                 LOG_WARN("Skipping loaded issue with invalid/missing required data (ID: %d).", i->id);
                  free(i->mentee_name); free(i->description); free(i->date_reported_str); free_notes(i->response_notes); free(i);
                  continue;
              }
             // Add to head
             i->next = data->issues_head;
             data->issues_head = i;
+            account_issue(i, +1);
+            issue_bucket_link(data, i);
+            search_index_issue(data, i);
             issues_loaded_count++;
         }
-        printf("Loaded %d issues from file.\n", issues_loaded_count); fflush(stdout);
+        LOG_INFO("Loaded %d issues from file.", issues_loaded_count);
     } else {
-         printf("No 'issues' array found or it's not an array in JSON data.\n"); fflush(stdout);
+         LOG_INFO("No 'issues' array found or it's not an array in JSON data.");
     }
 
 
@@ -1162,38 +2198,74 @@ AppData* load_data_from_file(const char* filename) {
     cJSON* users_j = cJSON_GetObjectItemCaseSensitive(root, "users");
     int users_loaded_count = 0;
     if (cJSON_IsArray(users_j)) {
+        // Plain-text passwords are hashed after the scan, in parallel: one at a time this costs ~25 ms per user
+        int user_slots = cJSON_GetArraySize(users_j);
+        User** loaded = calloc(user_slots > 0 ? user_slots : 1, sizeof(User*));
+        const char** plains = calloc(user_slots > 0 ? user_slots : 1, sizeof(char*));
+        int* pending = calloc(user_slots > 0 ? user_slots : 1, sizeof(int));
+        int loaded_count = 0, pending_count = 0;
+        if (!loaded || !plains || !pending) LOG_ERROR("malloc failed for user load buffers, no users loaded.");
         cJSON* ui;
         cJSON_ArrayForEach(ui, users_j) {
+            if (!loaded || !plains || !pending) break;
             if (!cJSON_IsObject(ui)) continue;
             User* u = malloc(sizeof(User));
-            if (!u) { fprintf(stderr, "Warning: malloc failed for User struct, skipping entry.\n"); continue; }
+            if (!u) { LOG_WARN("malloc failed for User struct, skipping entry."); continue; }
 
             u->id = (int)cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(ui,"id"));
             u->username = safe_strdup(cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(ui,"username")));
            
-            u->password = safe_strdup(cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(ui,"password")));
+            u->password_hash = safe_strdup(cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(ui,"passwordHash")));
+            const char* plain = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(ui,"password"));
+            if (!u->password_hash && plain && plain[0]) {
+                // Written before passwords were hashed: migrate it below, the next save drops the plain text
+                plains[pending_count] = plain;
+                pending[pending_count++] = loaded_count;
+            }
             u->role = string_to_role(cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(ui,"role")));
             u->associated_id = (int)cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(ui,"associated_id")); // Can be 0
             u->next = NULL;
+            loaded[loaded_count++] = u;
+        }
+
+        if (pending_count > 0) {
+            char (*hashes)[PASSWORD_HASH_SIZE] = calloc(pending_count, PASSWORD_HASH_SIZE);
+            if (!hashes) LOG_ERROR("malloc failed for %d password hashes, those users are skipped.", pending_count);
+            else {
+                password_hash_many(plains, hashes, pending_count);
+                for (int k = 0; k < pending_count; ++k) {
+                    if (!hashes[k][0]) continue;
+                    loaded[pending[k]]->password_hash = safe_strdup(hashes[k]);
+                    if (loaded[pending[k]]->password_hash) data->migrated_passwords++;
+                }
+                free(hashes);
+            }
+        }
 
-            // Basic validation - require ID, username, password (even if insecurely stored)
-            if (u->id == 0 || !u->username || !u->password || (u->username && strlen(u->username)==0) || (u->password && strlen(u->password)==0)) {
-                fprintf(stderr, "Warning: Skipping loaded user with invalid/missing required data (ID: %d, Username: '%s').\n", u->id, u->username ? u->username : "NULL");
-                free(u->username); free(u->password); free(u);
+        for (int k = 0; k < loaded_count; ++k) {
+            User* u = loaded[k];
+            // Basic validation - require ID, username, password hash
+            if (u->id == 0 || !u->username || !u->password_hash || (u->username && strlen(u->username)==0) || (u->password_hash && strlen(u->password_hash)==0)) {
+                LOG_WARN("Skipping loaded user with invalid/missing required data (ID: %d, Username: '%s').", u->id, u->username ? u->username : "NULL");
+                free(u->username); free(u->password_hash); free(u);
                 continue;
             }
             // Add to head
             u->next = data->users_head;
             data->users_head = u;
+            account_user(u, +1);
+            index_user(data, u);
             users_loaded_count++;
         }
-         printf("Loaded %d users from file.\n", users_loaded_count); fflush(stdout);
+        free(loaded); free(plains); free(pending);
+         LOG_INFO("Loaded %d users from file.", users_loaded_count);
+         if (data->migrated_passwords > 0) LOG_INFO("Hashed %d plain-text password(s) found in the file.", data->migrated_passwords);
     } else {
         // This is potentially problematic if the file exists but has no users
-        fprintf(stderr, "Warning: No 'users' array found or it's not an array in JSON data. No users loaded.\n"); fflush(stderr);
+        LOG_WARN("No 'users' array found or it's not an array in JSON data. No users loaded.");
     }
 
     cJSON_Delete(root); // Delete the parsed JSON structure
-    printf("Data loading process complete from file %s.\n", filename); fflush(stdout);
+    LOG_INFO("Data loading process complete from file %s.", filename);
     return data; // Return the populated AppData structure
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <time.h>
 #include <cjson/cJSON.h>
+#include "skiplist.h"
+#include "search_index.h"
 
 // --- Forward Declarations ---
 typedef struct Mentee Mentee;
@@ -10,6 +12,7 @@ typedef struct Meeting Meeting;
 typedef struct Issue Issue;
 typedef struct Note Note;
 typedef struct User User;
+typedef struct UndoEntry UndoEntry;
 
 // --- Enums ---
 typedef enum {
@@ -20,6 +23,10 @@ typedef enum {
     STATUS_OPEN, STATUS_IN_PROGRESS, STATUS_RESOLVED
 } IssueStatus;
 
+#define ISSUE_PRIORITY_COUNT 3 // Number of IssuePriority values (bucket dimension)
+#define ISSUE_STATUS_COUNT 3   // Number of IssueStatus values (bucket dimension)
+#define MAX_MEETING_MINUTES (24 * 60) // Longest meeting accepted; bounds overlap searches
+
 typedef enum {
     ROLE_MENTOR, ROLE_MENTEE
 } UserRole;
@@ -42,6 +49,7 @@ struct Meeting {
     char* time_str;       // "HH:MM" (Dynamically allocated)
     int duration_minutes;
     char* notes;          // Dynamically allocated
+    time_t start_time;    // Parsed from date_str + time_str (0 if unparseable); index key
     Meeting* next;        // Linked list pointer
 };
 
@@ -56,6 +64,8 @@ struct Issue {
     IssueStatus status;
     Note* response_notes;    // Linked list of notes
     Issue* next;             // Linked list pointer
+    Issue* bucket_prev;      // Doubly linked (status, priority) bucket
+    Issue* bucket_next;
 };
 
 // Mentee structure
@@ -72,7 +82,7 @@ struct Mentee {
 struct User {
     int id;
     char* username;      // Dynamically allocated
-    char* password;      // Dynamically allocated - !! WARNING: PLAIN TEXT !!
+    char* password_hash; // Dynamically allocated yescrypt hash (see password.h)
     UserRole role;
     int associated_id;   // Corresponding Mentee/Mentor ID (0 if admin/none)
     User* next;          // Linked list pointer
@@ -84,10 +94,23 @@ typedef struct {
     Meeting* meetings_head;
     Issue* issues_head;
     User* users_head;
+    SkipList* meetings_by_time;   // Meeting* ordered by (start_time, id)
+    SkipList* meetings_by_mentee; // Meeting* ordered by (mentee_id, start_time, id)
+    int max_meeting_minutes;      // Longest duration currently indexed; bounds overlap searches
+    int meeting_duration_counts[MAX_MEETING_MINUTES + 1]; // Indexed meetings per duration, to lower it again
+    Issue* issue_buckets[ISSUE_STATUS_COUNT][ISSUE_PRIORITY_COUNT]; // Newest first
+    int issue_bucket_counts[ISSUE_STATUS_COUNT][ISSUE_PRIORITY_COUNT];
+    SearchIndex* search_index;    // Full-text index over mentees, meeting notes, issues and notes
+    SkipList* mentees_by_id;      // Mentee* ordered by id
+    SkipList* name_index;         // NameIndexEntry* ordered by lowercased key (names, name words, usernames)
     int next_mentee_id;
     int next_meeting_id;
     int next_issue_id;
     int next_user_id;
+    int migrated_passwords;       // Plain-text passwords the last load hashed; not yet saved
+    int undo_active;              // An undo scope is open (see begin_undo_scope)
+    int undo_incomplete;          // A change in the open scope could not be recorded
+    UndoEntry* undo_log;          // Changes in the open scope, newest first
 } AppData;
 
 
@@ -95,6 +118,7 @@ typedef struct {
 
 // Initialization / Cleanup
 AppData* initialize_app_data();
+AppData* create_empty_app_data(void); // No records or default users (tools, tests)
 void free_app_data(AppData* data);
 
 // Persistence (Saving/Loading data to/from JSON)
@@ -106,30 +130,118 @@ Mentee* add_mentee(AppData* data, const char* name, const char* subject, const c
 Mentee* find_mentee_by_id(const AppData* data, int id);
 Mentee* find_mentee_by_name(const AppData* data, const char* name);
 int delete_mentee(AppData* data, int id); // TODO: Needs to delete associated User
-void add_mentee_note(Mentee* mentee, const char* note_text);
+void add_mentee_note(AppData* data, Mentee* mentee, const char* note_text);
 void free_mentees(Mentee* head); // Added prototype
 
+// A typeahead match. 'user' is set when the prefix matched the mentee's username.
+typedef struct {
+    Mentee* mentee;
+    const User* user;
+} MenteeSuggestion;
+
+/**
+ * @brief Case-insensitive prefix lookup over mentee names (whole name or any
+ * word of it) and mentee usernames. Results are in key order, one per mentee.
+ * O(log n + k) on the name index. Returns the number of suggestions written.
+ */
+int suggest_mentees(const AppData* data, const char* prefix, MenteeSuggestion* out, int max_results);
+
 // Meeting Functions
 Meeting* add_meeting(AppData* data, int mentee_id, const char* mentee_name, const char* date_str, const char* time_str, int duration, const char* notes);
 Meeting* find_meeting_by_id(const AppData* data, int id);
-int update_meeting(Meeting* meeting, const char* new_date_str, const char* new_time_str);
+int update_meeting(AppData* data, Meeting* meeting, const char* new_date_str, const char* new_time_str);
 int delete_meeting(AppData* data, int meeting_id);
 void free_meetings(Meeting* head); // Added prototype
+time_t parse_meeting_datetime(const char* date_str, const char* time_str);
+
+/**
+ * @brief Callback for time-ordered meeting queries. Return 0 to stop iterating.
+ */
+typedef int (*MeetingVisitor)(const Meeting* meeting, void* ctx);
+
+/**
+ * @brief Visits meetings with from <= start_time < to in start-time order.
+ * Uses the time index (mentee_id <= 0) or the per-mentee index, so the cost is
+ * O(log n + k). Returns the number of meetings visited.
+ */
+int for_each_meeting_in_range(const AppData* data, int mentee_id, time_t from, time_t to, MeetingVisitor visit, void* ctx);
+
+/**
+ * @brief Finds a meeting overlapping [start, start + duration_minutes) on the
+ * mentor's schedule (mentee_id <= 0) or on one mentee's schedule.
+ * Only meetings starting within max_meeting_minutes before 'start' can overlap,
+ * so this is O(log n + k) on the time indexes. Returns NULL if the slot is free.
+ */
+Meeting* find_meeting_conflict(const AppData* data, int mentee_id, time_t start, int duration_minutes, int ignore_meeting_id);
+
+// A free interval [start, end) on the mentor's schedule
+typedef struct {
+    time_t start;
+    time_t end;
+} TimeSlot;
+
+/**
+ * @brief Fills 'out' with free slots of at least min_minutes within [from, to),
+ * in time order. Returns the number of slots written (at most max_slots).
+ */
+int find_free_slots(const AppData* data, time_t from, time_t to, int min_minutes, TimeSlot* out, int max_slots);
 
 // Issue Functions
 Issue* add_issue(AppData* data, int mentee_id, const char* mentee_name, const char* description, const char* date_reported, IssuePriority priority);
 Issue* find_issue_by_id(const AppData* data, int id);
-int update_issue_status(Issue* issue, IssueStatus new_status, const char* note_text);
+int update_issue_status(AppData* data, Issue* issue, IssueStatus new_status, const char* note_text);
 void free_issues(Issue* head); // Added prototype
 
+/**
+ * @brief First issue of the (status, priority) bucket; follow Issue.bucket_next.
+ * Buckets let views skip resolved history and triage by priority without scans.
+ */
+Issue* issue_bucket_head(const AppData* data, IssueStatus status, IssuePriority priority);
+int issue_bucket_count(const AppData* data, IssueStatus status, IssuePriority priority);
+
 
 // User Functions
-User* add_user(AppData* data, const char* username, const char* password, UserRole role, int associated_id);
+User* add_user(AppData* data, const char* username, const char* password, UserRole role, int associated_id); // Hashes 'password' (slow)
+User* add_user_with_hash(AppData* data, const char* username, const char* hash, UserRole role, int associated_id);
 User* find_user_by_username(const AppData* data, const char* username);
-User* verify_user_password(const AppData* data, const char* username, const char* password);
 void free_users(User* head);
+int count_orphaned_mentee_users(const AppData* data); // Mentee accounts whose mentee was deleted
+
+/**
+ * @brief Logs tracked memory per collection (see memstats.h), process RSS and
+ * orphaned accounts. Used at shutdown; 'when' labels the report.
+ */
+void log_memory_report(const AppData* data, const char* when);
+
+/**
+ * @brief Call after free_app_data(): warns about any collection that still has
+ * live objects, i.e. allocations no free path accounted for. Returns their count.
+ */
+int log_memory_leaks(void);
+
+/**
+ * @brief Cross-checks the lists against every index: ids unique and below the
+ * next-id counters, skip lists and issue buckets holding exactly the live
+ * records, name index and search index free of stale references. O(n log n).
+ * Returns 1 if consistent; otherwise 0 with a description in 'problem'.
+ */
+int check_app_data_consistency(const AppData* data, char* problem, size_t problem_cap);
+
+/**
+ * @brief Undo scopes make a group of changes all-or-nothing (atomic batches).
+ * While a scope is open every mutating function above records how to reverse
+ * itself, and removed records are set aside instead of freed.
+ * rollback_undo_scope() reverses the changes newest first, in memory, and
+ * returns 1. It returns 0, and keeps the changes, if one could not be recorded.
+ * commit_undo_scope() keeps the changes and frees what was set aside.
+ * Scopes do not nest.
+ */
+void begin_undo_scope(AppData* data);
+void commit_undo_scope(AppData* data);
+int rollback_undo_scope(AppData* data);
 
 // Note Functions
+Note* create_note(const char* text, time_t timestamp); // Unlinked; the only way Notes are allocated
 Note* add_note(Note** head_ref, const char* text);
 void free_notes(Note* head);
 
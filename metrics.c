@@ -0,0 +1,259 @@
+#define _POSIX_C_SOURCE 200809L // For clock_gettime
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include "metrics.h"
+
+// Log-linear ("HDR-style") buckets: exact below 8, then 8 sub-buckets per
+// power of two, so any recorded value is within 12.5% of its bucket bound.
+#define HIST_SUB_BITS 3
+#define HIST_SUB_COUNT (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS ((64 - HIST_SUB_BITS + 1) * HIST_SUB_COUNT)
+
+typedef struct {
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t total;
+    uint64_t sum;
+    uint64_t max;
+} Histogram;
+
+// Status codes tracked individually; anything else lands in "other"
+static const int tracked_statuses[] = { 200, 201, 204, 400, 401, 403, 404, 405, 409, 413, 429, 500, 503 };
+#define TRACKED_STATUS_COUNT (sizeof(tracked_statuses) / sizeof(tracked_statuses[0]))
+#define STATUS_SLOT_OTHER TRACKED_STATUS_COUNT
+#define STATUS_SLOT_NONE (TRACKED_STATUS_COUNT + 1)   // No response queued
+#define STATUS_SLOTS (TRACKED_STATUS_COUNT + 2)
+
+typedef struct {
+    const char* label;           // Set on first use; NULL means never hit
+    uint64_t status_counts[STATUS_SLOTS];
+    Histogram latency;           // Nanoseconds
+} RouteMetrics;
+
+static RouteMetrics route_metrics[METRICS_MAX_ROUTES];
+
+static Histogram save_latency;
+static uint64_t saves_total = 0;
+static uint64_t save_failures_total = 0;
+static uint64_t save_bytes_total = 0;
+static uint64_t save_last_bytes = 0;
+
+// ========================================================================== //
+//                               HISTOGRAM                                    //
+// ========================================================================== //
+
+static int hist_index(uint64_t value) {
+    if (value < HIST_SUB_COUNT) return (int)value;
+    int exponent = 63 - __builtin_clzll(value);
+    int sub = (int)((value >> (exponent - HIST_SUB_BITS)) & (HIST_SUB_COUNT - 1));
+    return (exponent - HIST_SUB_BITS + 1) * HIST_SUB_COUNT + sub;
+}
+
+/**
+ * @brief Largest value that maps to bucket 'index'.
+ */
+static uint64_t hist_upper_bound(int index) {
+    if (index < HIST_SUB_COUNT) return (uint64_t)index;
+    int exponent = index / HIST_SUB_COUNT + HIST_SUB_BITS - 1;
+    uint64_t sub = (uint64_t)(index % HIST_SUB_COUNT);
+    uint64_t width = 1ULL << (exponent - HIST_SUB_BITS);
+    return ((HIST_SUB_COUNT + sub + 1) * width) - 1;
+}
+
+static void hist_record(Histogram* hist, uint64_t value) {
+    __atomic_fetch_add(&hist->counts[hist_index(value)], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&hist->total, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&hist->sum, value, __ATOMIC_RELAXED);
+    uint64_t seen = __atomic_load_n(&hist->max, __ATOMIC_RELAXED);
+    while (value > seen &&
+           !__atomic_compare_exchange_n(&hist->max, &seen, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        // 'seen' was refreshed by the failed CAS; retry while we still hold the larger value
+    }
+}
+
+/**
+ * @brief Computes quantiles from a snapshot of the bucket counts. Each result
+ * is the upper bound of the bucket holding that rank, clamped to the max.
+ */
+static void hist_quantiles(const Histogram* hist, const double* qs, int q_count, uint64_t* out, uint64_t* total_out) {
+    uint64_t snapshot[HIST_BUCKETS];
+    uint64_t total = 0;
+    for (int i = 0; i < HIST_BUCKETS; ++i) {
+        snapshot[i] = __atomic_load_n(&hist->counts[i], __ATOMIC_RELAXED);
+        total += snapshot[i];
+    }
+    uint64_t max = __atomic_load_n(&hist->max, __ATOMIC_RELAXED);
+    *total_out = total;
+
+    int bucket = 0;
+    uint64_t cumulative = 0;
+    for (int q = 0; q < q_count; ++q) {
+        if (total == 0) { out[q] = 0; continue; }
+        uint64_t rank = (uint64_t)(qs[q] * (double)total + 0.5);
+        if (rank < 1) rank = 1;
+        while (bucket < HIST_BUCKETS && cumulative + snapshot[bucket] < rank) {
+            cumulative += snapshot[bucket];
+            bucket++;
+        }
+        uint64_t bound = (bucket < HIST_BUCKETS) ? hist_upper_bound(bucket) : max;
+        out[q] = (bound < max) ? bound : max;
+    }
+}
+
+// ========================================================================== //
+//                               RECORDING                                    //
+// ========================================================================== //
+
+uint64_t metrics_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static size_t status_slot(int status) {
+    if (status == 0) return STATUS_SLOT_NONE;
+    for (size_t i = 0; i < TRACKED_STATUS_COUNT; ++i) {
+        if (tracked_statuses[i] == status) return i;
+    }
+    return STATUS_SLOT_OTHER;
+}
+
+void metrics_record_request(int route_id, const char* route_label, int status, uint64_t duration_ns) {
+    if (route_id < 0 || route_id >= METRICS_MAX_ROUTES || !route_label) return;
+    RouteMetrics* route = &route_metrics[route_id];
+    if (!__atomic_load_n(&route->label, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&route->label, route_label, __ATOMIC_RELEASE); // Same static string from every thread
+    }
+    __atomic_fetch_add(&route->status_counts[status_slot(status)], 1, __ATOMIC_RELAXED);
+    hist_record(&route->latency, duration_ns);
+}
+
+void metrics_record_save(uint64_t duration_ns, size_t bytes_written, int success) {
+    __atomic_fetch_add(&saves_total, 1, __ATOMIC_RELAXED);
+    if (!success) __atomic_fetch_add(&save_failures_total, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&save_bytes_total, (uint64_t)bytes_written, __ATOMIC_RELAXED);
+    if (success) __atomic_store_n(&save_last_bytes, (uint64_t)bytes_written, __ATOMIC_RELAXED);
+    hist_record(&save_latency, duration_ns);
+}
+
+// ========================================================================== //
+//                               RENDERING                                    //
+// ========================================================================== //
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    int failed;
+} TextBuffer;
+
+static void text_appendf(TextBuffer* text, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+static void text_appendf(TextBuffer* text, const char* fmt, ...) {
+    if (text->failed) return;
+    for (;;) {
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(text->data + text->length, text->capacity - text->length, fmt, args);
+        va_end(args);
+        if (n < 0) { text->failed = 1; return; }
+        if (text->length + (size_t)n < text->capacity) {
+            text->length += (size_t)n;
+            return;
+        }
+        size_t new_capacity = text->capacity * 2 + (size_t)n;
+        char* grown = realloc(text->data, new_capacity);
+        if (!grown) { text->failed = 1; return; }
+        text->data = grown;
+        text->capacity = new_capacity;
+    }
+}
+
+static void render_summary(TextBuffer* text, const char* name, const char* labels, const Histogram* hist) {
+    static const double qs[] = { 0.5, 0.9, 0.99 };
+    static const char* const q_names[] = { "0.5", "0.9", "0.99" };
+    uint64_t values[3], total;
+    hist_quantiles(hist, qs, 3, values, &total);
+    const char* sep = labels[0] ? "," : "";
+    for (int q = 0; q < 3; ++q) {
+        text_appendf(text, "%s{%s%squantile=\"%s\"} %.9f\n", name, labels, sep, q_names[q], (double)values[q] / 1e9);
+    }
+    const char* open = labels[0] ? "{" : "";
+    const char* close = labels[0] ? "}" : "";
+    text_appendf(text, "%s_sum%s%s%s %.9f\n", name, open, labels, close, (double)__atomic_load_n(&hist->sum, __ATOMIC_RELAXED) / 1e9);
+    text_appendf(text, "%s_count%s%s%s %llu\n", name, open, labels, close, (unsigned long long)total);
+}
+
+char* metrics_render_prometheus(const MetricsEntityCounts* counts, size_t* length_out) {
+    TextBuffer text = { malloc(16384), 0, 16384, 0 };
+    if (!text.data) return NULL;
+    text.data[0] = '\0';
+    char labels[160];
+
+    text_appendf(&text, "# HELP mentor_http_requests_total Requests handled, by route and status code.\n");
+    text_appendf(&text, "# TYPE mentor_http_requests_total counter\n");
+    for (int r = 0; r < METRICS_MAX_ROUTES; ++r) {
+        const char* label = __atomic_load_n(&route_metrics[r].label, __ATOMIC_ACQUIRE);
+        if (!label) continue;
+        for (size_t s = 0; s < STATUS_SLOTS; ++s) {
+            uint64_t n = __atomic_load_n(&route_metrics[r].status_counts[s], __ATOMIC_RELAXED);
+            if (n == 0) continue;
+            char code[8];
+            if (s == STATUS_SLOT_OTHER) strcpy(code, "other");
+            else if (s == STATUS_SLOT_NONE) strcpy(code, "none");
+            else snprintf(code, sizeof(code), "%d", tracked_statuses[s]);
+            text_appendf(&text, "mentor_http_requests_total{route=\"%s\",code=\"%s\"} %llu\n", label, code, (unsigned long long)n);
+        }
+    }
+
+    text_appendf(&text, "# HELP mentor_http_request_duration_seconds Request latency, by route.\n");
+    text_appendf(&text, "# TYPE mentor_http_request_duration_seconds summary\n");
+    for (int r = 0; r < METRICS_MAX_ROUTES; ++r) {
+        const char* label = __atomic_load_n(&route_metrics[r].label, __ATOMIC_ACQUIRE);
+        if (!label) continue;
+        snprintf(labels, sizeof(labels), "route=\"%s\"", label);
+        render_summary(&text, "mentor_http_request_duration_seconds", labels, &route_metrics[r].latency);
+    }
+    text_appendf(&text, "# HELP mentor_http_request_duration_seconds_max Slowest request seen, by route.\n");
+    text_appendf(&text, "# TYPE mentor_http_request_duration_seconds_max gauge\n");
+    for (int r = 0; r < METRICS_MAX_ROUTES; ++r) {
+        const char* label = __atomic_load_n(&route_metrics[r].label, __ATOMIC_ACQUIRE);
+        if (!label) continue;
+        text_appendf(&text, "mentor_http_request_duration_seconds_max{route=\"%s\"} %.9f\n", label,
+                     (double)__atomic_load_n(&route_metrics[r].latency.max, __ATOMIC_RELAXED) / 1e9);
+    }
+
+    text_appendf(&text, "# HELP mentor_save_duration_seconds Time spent writing the data file.\n");
+    text_appendf(&text, "# TYPE mentor_save_duration_seconds summary\n");
+    render_summary(&text, "mentor_save_duration_seconds", "", &save_latency);
+    text_appendf(&text, "# TYPE mentor_save_duration_seconds_max gauge\nmentor_save_duration_seconds_max %.9f\n",
+                 (double)__atomic_load_n(&save_latency.max, __ATOMIC_RELAXED) / 1e9);
+    text_appendf(&text, "# TYPE mentor_saves_total counter\nmentor_saves_total %llu\n",
+                 (unsigned long long)__atomic_load_n(&saves_total, __ATOMIC_RELAXED));
+    text_appendf(&text, "# TYPE mentor_save_failures_total counter\nmentor_save_failures_total %llu\n",
+                 (unsigned long long)__atomic_load_n(&save_failures_total, __ATOMIC_RELAXED));
+    text_appendf(&text, "# TYPE mentor_save_bytes_total counter\nmentor_save_bytes_total %llu\n",
+                 (unsigned long long)__atomic_load_n(&save_bytes_total, __ATOMIC_RELAXED));
+    text_appendf(&text, "# TYPE mentor_save_last_bytes gauge\nmentor_save_last_bytes %llu\n",
+                 (unsigned long long)__atomic_load_n(&save_last_bytes, __ATOMIC_RELAXED));
+
+    if (counts) {
+        text_appendf(&text, "# HELP mentor_entities Objects currently held in memory, by kind.\n");
+        text_appendf(&text, "# TYPE mentor_entities gauge\n");
+        text_appendf(&text, "mentor_entities{kind=\"mentee\"} %zu\n", counts->mentees);
+        text_appendf(&text, "mentor_entities{kind=\"meeting\"} %zu\n", counts->meetings);
+        text_appendf(&text, "mentor_entities{kind=\"issue\"} %zu\n", counts->issues);
+        text_appendf(&text, "mentor_entities{kind=\"user\"} %zu\n", counts->users);
+        text_appendf(&text, "# TYPE mentor_search_index_documents gauge\nmentor_search_index_documents %zu\n", counts->search_documents);
+        text_appendf(&text, "# TYPE mentor_search_index_terms gauge\nmentor_search_index_terms %zu\n", counts->search_terms);
+    }
+
+    if (text.failed) {
+        free(text.data);
+        return NULL;
+    }
+    if (length_out) *length_out = text.length;
+    return text.data;
+}
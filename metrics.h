@@ -0,0 +1,43 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define METRICS_MAX_ROUTES 64
+
+/**
+ * @brief Records one finished request. 'route_id' is a small stable index
+ * (0..METRICS_MAX_ROUTES-1) and 'route_label' a static string naming it, e.g.
+ * "GET /api/meetings". Lock-free: a handful of relaxed atomic increments.
+ * status 0 means no response was queued (aborted / MHD_NO).
+ */
+void metrics_record_request(int route_id, const char* route_label, int status, uint64_t duration_ns);
+
+/**
+ * @brief Records one save_data_to_file() call.
+ */
+void metrics_record_save(uint64_t duration_ns, size_t bytes_written, int success);
+
+// Point-in-time values rendered alongside the counters (gathered by the caller)
+typedef struct {
+    size_t mentees;
+    size_t meetings;
+    size_t issues;
+    size_t users;
+    size_t search_documents;
+    size_t search_terms;
+} MetricsEntityCounts;
+
+/**
+ * @brief Renders all metrics in the Prometheus text exposition format (0.0.4).
+ * Returns a malloc'd NUL-terminated string (caller frees) or NULL on OOM.
+ */
+char* metrics_render_prometheus(const MetricsEntityCounts* counts, size_t* length_out);
+
+/**
+ * @brief Monotonic clock in nanoseconds, for timing measurements.
+ */
+uint64_t metrics_now_ns(void);
+
+#endif // METRICS_H
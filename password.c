@@ -0,0 +1,198 @@
+#define _GNU_SOURCE // For getrandom()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <crypt.h>
+#include <sys/random.h>
+#include "password.h"
+#include "logger.h"
+
+#define PASSWORD_HASH_PREFIX "$y$" // yescrypt
+
+// ========================================================================== //
+//                                 HASHING                                    //
+// ========================================================================== //
+
+/**
+ * @brief crypt_rn() into 'out'. 'scratch' is crypt's 32 KiB work area; callers
+ * pass a per-thread one. Returns 1 if 'out' holds a hash.
+ */
+static int crypt_into(const char* password, const char* setting, struct crypt_data* scratch, char* out, size_t out_size) {
+    memset(scratch, 0, sizeof(*scratch));
+    const char* result = crypt_rn(password, setting, scratch, sizeof(*scratch));
+    // Failures come back NULL or as a "*"-prefixed string, never as a hash
+    if (!result || result[0] != '$' || strlen(result) >= out_size) return 0;
+    strcpy(out, result);
+    return 1;
+}
+
+int password_hash(const char* password, char* out, size_t out_size) {
+    if (!password || !out) return 0;
+    char setting[CRYPT_GENSALT_OUTPUT_SIZE];
+    // NULL random bytes: libxcrypt draws the salt from the OS itself
+    if (!crypt_gensalt_rn(PASSWORD_HASH_PREFIX, PASSWORD_HASH_COST, NULL, 0, setting, sizeof(setting))) {
+        LOG_ERROR("[PASSWORD] crypt_gensalt_rn failed; yescrypt unavailable?");
+        return 0;
+    }
+    struct crypt_data* scratch = malloc(sizeof(struct crypt_data));
+    if (!scratch) return 0;
+    int ok = crypt_into(password, setting, scratch, out, out_size);
+    free(scratch);
+    if (!ok) LOG_ERROR("[PASSWORD] Hashing failed.");
+    return ok;
+}
+
+// Threads hashing at most PASSWORD_WORKERS_MAX at once, fewer on smaller machines
+static int worker_count(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 && cpus < PASSWORD_WORKERS_MAX ? (int)cpus : PASSWORD_WORKERS_MAX;
+}
+
+// Shared by the threads of one password_hash_many() call
+typedef struct {
+    const char** passwords;
+    char (*out)[PASSWORD_HASH_SIZE];
+    size_t count;
+    size_t next;            // Next index to claim
+    size_t hashed;
+    pthread_mutex_t lock;   // Guards 'next' and 'hashed'
+} HashBatch;
+
+static void* hash_batch_worker(void* arg) {
+    HashBatch* batch = arg;
+    for (;;) {
+        pthread_mutex_lock(&batch->lock);
+        size_t i = batch->next++;
+        pthread_mutex_unlock(&batch->lock);
+        if (i >= batch->count) return NULL;
+        int ok = password_hash(batch->passwords[i], batch->out[i], PASSWORD_HASH_SIZE);
+        if (!ok) batch->out[i][0] = '\0';
+        pthread_mutex_lock(&batch->lock);
+        batch->hashed += ok;
+        pthread_mutex_unlock(&batch->lock);
+    }
+}
+
+size_t password_hash_many(const char** passwords, char (*out)[PASSWORD_HASH_SIZE], size_t count) {
+    if (!passwords || !out || count == 0) return 0;
+    HashBatch batch = { passwords, out, count, 0, 0, PTHREAD_MUTEX_INITIALIZER };
+    size_t helpers = (size_t)worker_count() - 1; // The caller hashes too
+    if (helpers > count - 1) helpers = count - 1;
+    pthread_t threads[PASSWORD_WORKERS_MAX];
+    size_t started = 0;
+    while (started < helpers && pthread_create(&threads[started], NULL, hash_batch_worker, &batch) == 0) started++;
+    hash_batch_worker(&batch);
+    for (size_t i = 0; i < started; ++i) pthread_join(threads[i], NULL);
+    pthread_mutex_destroy(&batch.lock);
+    return batch.hashed;
+}
+
+// Compares without an early exit, so timing says nothing about how much matched
+static int hash_equal(const char* a, const char* b) {
+    size_t len = strlen(a);
+    if (len != strlen(b)) return 0;
+    unsigned char diff = 0;
+    for (size_t i = 0; i < len; ++i) diff |= (unsigned char)(a[i] ^ b[i]);
+    return diff == 0;
+}
+
+static char dummy_hash[PASSWORD_HASH_SIZE];
+static pthread_once_t dummy_once = PTHREAD_ONCE_INIT;
+
+static void init_dummy_hash(void) {
+    unsigned char secret[16];
+    char password[sizeof(secret) * 2 + 1];
+    if (getrandom(secret, sizeof(secret), 0) != (ssize_t)sizeof(secret)) memset(secret, 0x5a, sizeof(secret));
+    for (size_t i = 0; i < sizeof(secret); ++i) snprintf(password + i * 2, 3, "%02x", secret[i]);
+    if (!password_hash(password, dummy_hash, sizeof(dummy_hash))) dummy_hash[0] = '\0';
+}
+
+const char* password_dummy_hash(void) {
+    pthread_once(&dummy_once, init_dummy_hash);
+    return dummy_hash;
+}
+
+// ========================================================================== //
+//                            VERIFICATION POOL                               //
+// ========================================================================== //
+
+/**
+ * @brief One verification, owned by the waiting caller (it lives on its stack).
+ * 'done' and 'result' are guarded by pool_lock.
+ */
+typedef struct {
+    const char* password;
+    const char* hash;
+    PasswordResult result;
+    int done;
+    pthread_cond_t finished;
+} VerifyJob;
+
+static VerifyJob* queue[PASSWORD_QUEUE_MAX]; // Ring buffer of waiting jobs
+static size_t queue_head = 0;
+static size_t queue_length = 0;
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_ready = PTHREAD_COND_INITIALIZER;
+static int pool_workers = 0;
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+
+static void* verify_worker(void* arg) {
+    (void)arg;
+    struct crypt_data* scratch = malloc(sizeof(struct crypt_data));
+    if (!scratch) {
+        LOG_ERROR("[PASSWORD] Worker could not allocate its crypt buffer; exiting.");
+        return NULL;
+    }
+    for (;;) {
+        pthread_mutex_lock(&pool_lock);
+        while (queue_length == 0) pthread_cond_wait(&work_ready, &pool_lock);
+        VerifyJob* job = queue[queue_head];
+        queue_head = (queue_head + 1) % PASSWORD_QUEUE_MAX;
+        queue_length--;
+        pthread_mutex_unlock(&pool_lock);
+
+        char computed[PASSWORD_HASH_SIZE];
+        int match = crypt_into(job->password, job->hash, scratch, computed, sizeof(computed)) && hash_equal(computed, job->hash);
+
+        pthread_mutex_lock(&pool_lock);
+        job->result = match ? PASSWORD_MATCH : PASSWORD_MISMATCH;
+        job->done = 1;
+        pthread_cond_signal(&job->finished);
+        pthread_mutex_unlock(&pool_lock);
+    }
+    return NULL;
+}
+
+static void start_pool(void) {
+    int wanted = worker_count();
+    for (int i = 0; i < wanted; ++i) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, verify_worker, NULL) != 0) break;
+        pthread_detach(thread);
+        pool_workers++;
+    }
+    LOG_INFO("[PASSWORD] %d verification worker(s), queue limit %d.", pool_workers, PASSWORD_QUEUE_MAX);
+}
+
+PasswordResult password_verify(const char* password, const char* hash) {
+    if (!password || !hash || 0 != strncmp(hash, PASSWORD_HASH_PREFIX, strlen(PASSWORD_HASH_PREFIX))) return PASSWORD_MISMATCH;
+    pthread_once(&pool_once, start_pool);
+    if (pool_workers == 0) return PASSWORD_BUSY;
+
+    VerifyJob job = { password, hash, PASSWORD_MISMATCH, 0, PTHREAD_COND_INITIALIZER };
+    pthread_mutex_lock(&pool_lock);
+    if (queue_length == PASSWORD_QUEUE_MAX) {
+        pthread_mutex_unlock(&pool_lock);
+        LOG_WARN("[PASSWORD] Verification queue full; refusing login.");
+        return PASSWORD_BUSY;
+    }
+    queue[(queue_head + queue_length) % PASSWORD_QUEUE_MAX] = &job;
+    queue_length++;
+    pthread_cond_signal(&work_ready);
+    while (!job.done) pthread_cond_wait(&job.finished, &pool_lock);
+    pthread_mutex_unlock(&pool_lock);
+    pthread_cond_destroy(&job.finished);
+    return job.result;
+}
@@ -0,0 +1,45 @@
+#ifndef PASSWORD_H
+#define PASSWORD_H
+
+#include <stddef.h>
+
+#define PASSWORD_HASH_SIZE 128      // Encoded yescrypt hash plus NUL ("$y$j9T$<salt>$<hash>" is ~75)
+#define PASSWORD_HASH_COST 5        // libxcrypt yescrypt cost: 16 MiB and ~25 ms per hash
+#define PASSWORD_WORKERS_MAX 4      // Verification threads, fewer on smaller machines
+#define PASSWORD_QUEUE_MAX 64       // Logins waiting for a worker before new ones are refused
+
+typedef enum {
+    PASSWORD_MATCH,
+    PASSWORD_MISMATCH,
+    PASSWORD_BUSY       // Queue full; the caller should answer 503 and let the client retry
+} PasswordResult;
+
+/**
+ * @brief Hashes 'password' with a fresh random salt into 'out' (yescrypt,
+ * crypt(3) encoding). Slow by design: never call it under the data lock.
+ * Returns 1 on success, 0 on failure.
+ */
+int password_hash(const char* password, char* out, size_t out_size);
+
+/**
+ * @brief Hashes 'count' passwords into out[i] on up to PASSWORD_WORKERS_MAX
+ * threads (the caller's included), for migrating a whole file at startup.
+ * out[i] is left empty if hashing passwords[i] failed. Returns how many succeeded.
+ */
+size_t password_hash_many(const char** passwords, char (*out)[PASSWORD_HASH_SIZE], size_t count);
+
+/**
+ * @brief Checks 'password' against an encoded hash on one of the verification
+ * workers, blocking the caller until it is done. At most PASSWORD_WORKERS_MAX
+ * hashes run at once, so a login burst costs a bounded amount of CPU and memory
+ * and queues (or is refused) instead of competing with the other requests.
+ */
+PasswordResult password_verify(const char* password, const char* hash);
+
+/**
+ * @brief A hash of a random password with the same cost as real ones. Verifying
+ * against it for unknown usernames keeps them from answering faster.
+ */
+const char* password_dummy_hash(void);
+
+#endif // PASSWORD_H
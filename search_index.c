@@ -0,0 +1,612 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "search_index.h"
+#include "memstats.h"
+
+#define SEARCH_MAX_TOKEN_LEN 48     // Longer tokens are truncated
+#define SEARCH_MIN_TOKEN_LEN 2      // Single letters are not indexed
+#define SEARCH_MAX_QUERY_TERMS 16
+#define SEARCH_COMPACT_MIN_DEAD 1024 // Compact once this many dead docs outnumber live ones
+#define BM25_K1 1.2
+#define BM25_B 0.75
+
+// ========================================================================== //
+//                             DATA STRUCTURES                                //
+// ========================================================================== //
+
+typedef struct {
+    uint32_t doc_id;
+    uint32_t tf;        // Term frequency within the document
+} Posting;
+
+// One entry per distinct term; postings are kept sorted by doc_id
+typedef struct {
+    char* term;         // NULL marks an empty slot
+    uint32_t id;        // Stable across rehashing; indexes SearchIndex.live_df
+    Posting* postings;
+    size_t count;       // Includes postings of removed documents until compaction
+    size_t capacity;
+} TermEntry;
+
+typedef struct {
+    SearchDocKind kind;
+    SearchDocKind owner_kind;
+    int owner_id;
+    const void* ref;
+    uint32_t length;    // Tokens in the document (for BM25 length normalisation)
+    int alive;
+    uint32_t* term_ids; // Distinct terms, to update live_df on removal; freed then
+    uint32_t term_id_count;
+    uint32_t term_id_capacity;
+} SearchDoc;
+
+// Open-addressing map ref pointer -> doc_id (linear probing, backward-shift delete)
+typedef struct {
+    const void* ref;    // NULL marks an empty slot
+    uint32_t doc_id;
+} RefSlot;
+
+struct SearchIndex {
+    TermEntry* terms;
+    size_t term_capacity;   // Power of two
+    size_t term_count;
+    uint32_t* live_df;      // Live documents containing each term, by term id (BM25 idf)
+    size_t df_capacity;
+
+    SearchDoc* docs;        // Indexed by doc_id
+    size_t doc_count;
+    size_t doc_capacity;
+    size_t live_docs;
+    uint64_t live_length;   // Sum of live document lengths
+
+    RefSlot* refs;
+    size_t ref_capacity;    // Power of two
+    size_t ref_count;
+};
+
+// ========================================================================== //
+//                              HASH HELPERS                                  //
+// ========================================================================== //
+
+/**
+ * @brief Reports a (re)allocation of one index block to the memory accounting.
+ */
+static void account_block(size_t old_bytes, size_t new_bytes) {
+    if (old_bytes == 0) memstats_alloc(MEM_INDEXES, new_bytes);
+    else if (new_bytes == 0) memstats_free(MEM_INDEXES, old_bytes);
+    else memstats_resize(MEM_INDEXES, old_bytes, new_bytes);
+}
+
+static uint64_t hash_term(const char* s, size_t len) {
+    uint64_t h = 1469598103934665603ULL; // FNV-1a
+    for (size_t i = 0; i < len; ++i) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static uint64_t hash_ref(const void* ref) {
+    uint64_t x = (uint64_t)(uintptr_t)ref;
+    x ^= x >> 33; x *= 0xff51afd7ed558ccdULL; x ^= x >> 33; // murmur3 finaliser
+    return x;
+}
+
+/**
+ * @brief Returns the slot holding 'term' or the empty slot where it belongs.
+ */
+static TermEntry* term_slot(TermEntry* table, size_t capacity, const char* term, size_t len) {
+    size_t mask = capacity - 1;
+    size_t i = (size_t)hash_term(term, len) & mask;
+    while (table[i].term) {
+        if (strncmp(table[i].term, term, len) == 0 && table[i].term[len] == '\0') return &table[i];
+        i = (i + 1) & mask;
+    }
+    return &table[i];
+}
+
+static int grow_terms(SearchIndex* index) {
+    size_t new_capacity = index->term_capacity ? index->term_capacity * 2 : 1024;
+    TermEntry* table = calloc(new_capacity, sizeof(TermEntry));
+    if (!table) {
+        perror("search_index: calloc failed for term table");
+        return 0;
+    }
+    for (size_t i = 0; i < index->term_capacity; ++i) {
+        TermEntry* old = &index->terms[i];
+        if (!old->term) continue;
+        *term_slot(table, new_capacity, old->term, strlen(old->term)) = *old;
+    }
+    free(index->terms);
+    account_block(index->term_capacity * sizeof(TermEntry), new_capacity * sizeof(TermEntry));
+    index->terms = table;
+    index->term_capacity = new_capacity;
+    return 1;
+}
+
+static RefSlot* ref_slot(RefSlot* table, size_t capacity, const void* ref) {
+    size_t mask = capacity - 1;
+    size_t i = (size_t)hash_ref(ref) & mask;
+    while (table[i].ref && table[i].ref != ref) i = (i + 1) & mask;
+    return &table[i];
+}
+
+static int grow_refs(SearchIndex* index) {
+    size_t new_capacity = index->ref_capacity ? index->ref_capacity * 2 : 1024;
+    RefSlot* table = calloc(new_capacity, sizeof(RefSlot));
+    if (!table) {
+        perror("search_index: calloc failed for ref table");
+        return 0;
+    }
+    for (size_t i = 0; i < index->ref_capacity; ++i) {
+        if (index->refs[i].ref) *ref_slot(table, new_capacity, index->refs[i].ref) = index->refs[i];
+    }
+    free(index->refs);
+    account_block(index->ref_capacity * sizeof(RefSlot), new_capacity * sizeof(RefSlot));
+    index->refs = table;
+    index->ref_capacity = new_capacity;
+    return 1;
+}
+
+/**
+ * @brief Removes 'ref' from the ref map, shifting later probe-chain entries back.
+ */
+static void ref_map_delete(SearchIndex* index, const void* ref) {
+    if (!index->ref_capacity) return;
+    size_t mask = index->ref_capacity - 1;
+    RefSlot* slot = ref_slot(index->refs, index->ref_capacity, ref);
+    if (!slot->ref) return;
+    size_t hole = (size_t)(slot - index->refs);
+    size_t i = (hole + 1) & mask;
+    while (index->refs[i].ref) {
+        size_t home = (size_t)hash_ref(index->refs[i].ref) & mask;
+        // Move the entry back if the hole lies on its probe path
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            index->refs[hole] = index->refs[i];
+            hole = i;
+        }
+        i = (i + 1) & mask;
+    }
+    index->refs[hole].ref = NULL;
+    index->ref_count--;
+}
+
+// ========================================================================== //
+//                                TOKENIZER                                   //
+// ========================================================================== //
+
+/**
+ * @brief Word characters: ASCII letters/digits, plus any non-ASCII byte so
+ * UTF-8 words stay intact.
+ */
+static int is_token_char(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+/**
+ * @brief Extracts the next lowercased token from *cursor into buf.
+ * Returns the token length, or 0 at end of input.
+ */
+static size_t next_token(const char** cursor, char* buf) {
+    const unsigned char* p = (const unsigned char*)*cursor;
+    for (;;) {
+        while (*p && !is_token_char(*p)) p++;
+        if (!*p) {
+            *cursor = (const char*)p;
+            return 0;
+        }
+        size_t len = 0;
+        while (*p && is_token_char(*p)) {
+            if (len < SEARCH_MAX_TOKEN_LEN) {
+                unsigned char c = *p;
+                buf[len++] = (char)((c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c);
+            }
+            p++;
+        }
+        buf[len] = '\0';
+        if (len >= SEARCH_MIN_TOKEN_LEN) {
+            *cursor = (const char*)p;
+            return len;
+        }
+    }
+}
+
+// ========================================================================== //
+//                               LIFECYCLE                                    //
+// ========================================================================== //
+
+SearchIndex* search_index_create(void) {
+    SearchIndex* index = calloc(1, sizeof(SearchIndex));
+    if (!index) {
+        perror("search_index_create: calloc failed");
+        return NULL;
+    }
+    account_block(0, sizeof(SearchIndex));
+    if (!grow_terms(index) || !grow_refs(index)) {
+        search_index_free(index);
+        return NULL;
+    }
+    return index;
+}
+
+void search_index_free(SearchIndex* index) {
+    if (!index) return;
+    for (size_t i = 0; i < index->term_capacity; ++i) {
+        TermEntry* entry = &index->terms[i];
+        if (!entry->term) continue;
+        account_block(strlen(entry->term) + 1, 0);
+        if (entry->capacity) account_block(entry->capacity * sizeof(Posting), 0);
+        free(entry->term);
+        free(entry->postings);
+    }
+    for (size_t d = 0; d < index->doc_count; ++d) {
+        SearchDoc* doc = &index->docs[d];
+        if (doc->term_id_capacity) account_block(doc->term_id_capacity * sizeof(uint32_t), 0);
+        free(doc->term_ids);
+    }
+    if (index->term_capacity) account_block(index->term_capacity * sizeof(TermEntry), 0);
+    if (index->df_capacity) account_block(index->df_capacity * sizeof(uint32_t), 0);
+    if (index->doc_capacity) account_block(index->doc_capacity * sizeof(SearchDoc), 0);
+    if (index->ref_capacity) account_block(index->ref_capacity * sizeof(RefSlot), 0);
+    account_block(sizeof(SearchIndex), 0);
+    free(index->terms);
+    free(index->live_df);
+    free(index->docs);
+    free(index->refs);
+    free(index);
+}
+
+size_t search_index_document_count(const SearchIndex* index) {
+    return index ? index->live_docs : 0;
+}
+
+size_t search_index_term_count(const SearchIndex* index) {
+    return index ? index->term_count : 0;
+}
+
+// ========================================================================== //
+//                              MAINTENANCE                                   //
+// ========================================================================== //
+
+/**
+ * @brief Records one occurrence of 'term' in doc_id (the newest document).
+ */
+static int add_posting(SearchIndex* index, const char* term, size_t len, uint32_t doc_id) {
+    if ((index->term_count + 1) * 4 > index->term_capacity * 3 && !grow_terms(index)) return 0;
+
+    TermEntry* entry = term_slot(index->terms, index->term_capacity, term, len);
+    if (!entry->term) {
+        if (index->term_count == index->df_capacity) {
+            size_t new_capacity = index->df_capacity ? index->df_capacity * 2 : 256;
+            uint32_t* grown = realloc(index->live_df, new_capacity * sizeof(uint32_t));
+            if (!grown) {
+                perror("search_index: realloc failed for document frequencies");
+                return 0;
+            }
+            account_block(index->df_capacity * sizeof(uint32_t), new_capacity * sizeof(uint32_t));
+            index->live_df = grown;
+            index->df_capacity = new_capacity;
+        }
+        entry->term = malloc(len + 1);
+        if (!entry->term) {
+            perror("search_index: malloc failed for term");
+            return 0;
+        }
+        memcpy(entry->term, term, len + 1);
+        account_block(0, len + 1);
+        entry->id = (uint32_t)index->term_count;
+        index->live_df[entry->id] = 0;
+        entry->postings = NULL;
+        entry->count = entry->capacity = 0;
+        index->term_count++;
+    }
+
+    // Documents are only ever appended, so a repeat occurrence is always the last posting
+    if (entry->count > 0 && entry->postings[entry->count - 1].doc_id == doc_id) {
+        entry->postings[entry->count - 1].tf++;
+        return 1;
+    }
+    if (entry->count == entry->capacity) {
+        size_t new_capacity = entry->capacity ? entry->capacity * 2 : 4;
+        Posting* grown = realloc(entry->postings, new_capacity * sizeof(Posting));
+        if (!grown) {
+            perror("search_index: realloc failed for postings");
+            return 0;
+        }
+        account_block(entry->capacity * sizeof(Posting), new_capacity * sizeof(Posting));
+        entry->postings = grown;
+        entry->capacity = new_capacity;
+    }
+    SearchDoc* doc = &index->docs[doc_id];
+    if (doc->term_id_count == doc->term_id_capacity) {
+        uint32_t new_capacity = doc->term_id_capacity ? doc->term_id_capacity * 2 : 8;
+        uint32_t* grown = realloc(doc->term_ids, new_capacity * sizeof(uint32_t));
+        if (!grown) {
+            perror("search_index: realloc failed for document terms");
+            return 0;
+        }
+        account_block(doc->term_id_capacity * sizeof(uint32_t), new_capacity * sizeof(uint32_t));
+        doc->term_ids = grown;
+        doc->term_id_capacity = new_capacity;
+    }
+    doc->term_ids[doc->term_id_count++] = entry->id;
+    index->live_df[entry->id]++;
+    entry->postings[entry->count].doc_id = doc_id;
+    entry->postings[entry->count].tf = 1;
+    entry->count++;
+    return 1;
+}
+
+/**
+ * @brief Renumbers live documents and drops postings of dead ones.
+ */
+static void compact_index(SearchIndex* index) {
+    uint32_t* remap = malloc(index->doc_count * sizeof(uint32_t));
+    if (!remap) return; // Not fatal: dead postings are skipped at query time anyway
+
+    size_t next_id = 0;
+    for (size_t i = 0; i < index->doc_count; ++i) {
+        if (!index->docs[i].alive) {
+            remap[i] = UINT32_MAX;
+            continue;
+        }
+        remap[i] = (uint32_t)next_id;
+        index->docs[next_id++] = index->docs[i];
+    }
+    index->doc_count = next_id;
+
+    for (size_t t = 0; t < index->term_capacity; ++t) {
+        TermEntry* entry = &index->terms[t];
+        if (!entry->term) continue;
+        size_t kept = 0;
+        for (size_t p = 0; p < entry->count; ++p) {
+            uint32_t mapped = remap[entry->postings[p].doc_id];
+            if (mapped == UINT32_MAX) continue;
+            entry->postings[kept].doc_id = mapped;
+            entry->postings[kept].tf = entry->postings[p].tf;
+            kept++;
+        }
+        entry->count = kept; // Empty terms stay as slots; they cost a few bytes and match nothing
+    }
+
+    for (size_t r = 0; r < index->ref_capacity; ++r) {
+        if (index->refs[r].ref) index->refs[r].doc_id = remap[index->refs[r].doc_id];
+    }
+    free(remap);
+}
+
+void search_index_remove(SearchIndex* index, const void* ref) {
+    if (!index || !ref) return;
+    RefSlot* slot = ref_slot(index->refs, index->ref_capacity, ref);
+    if (!slot->ref) return;
+
+    SearchDoc* doc = &index->docs[slot->doc_id];
+    doc->alive = 0; // Postings are filtered lazily and dropped on compaction
+    index->live_docs--;
+    index->live_length -= doc->length;
+    for (uint32_t i = 0; i < doc->term_id_count; ++i) index->live_df[doc->term_ids[i]]--;
+    if (doc->term_id_capacity) account_block(doc->term_id_capacity * sizeof(uint32_t), 0);
+    free(doc->term_ids);
+    doc->term_ids = NULL;
+    doc->term_id_count = doc->term_id_capacity = 0;
+    ref_map_delete(index, ref);
+
+    size_t dead = index->doc_count - index->live_docs;
+    if (dead >= SEARCH_COMPACT_MIN_DEAD && dead > index->live_docs) compact_index(index);
+}
+
+int search_index_add(SearchIndex* index, SearchDocKind kind, SearchDocKind owner_kind, int owner_id,
+                     const void* ref, const char* const* fields, int field_count) {
+    if (!index || !ref) return 0;
+    search_index_remove(index, ref); // Re-adding replaces
+
+    if (index->doc_count >= UINT32_MAX - 1) return 0;
+    if (index->doc_count == index->doc_capacity) {
+        size_t new_capacity = index->doc_capacity ? index->doc_capacity * 2 : 256;
+        SearchDoc* grown = realloc(index->docs, new_capacity * sizeof(SearchDoc));
+        if (!grown) {
+            perror("search_index: realloc failed for documents");
+            return 0;
+        }
+        account_block(index->doc_capacity * sizeof(SearchDoc), new_capacity * sizeof(SearchDoc));
+        index->docs = grown;
+        index->doc_capacity = new_capacity;
+    }
+    if ((index->ref_count + 1) * 4 > index->ref_capacity * 3 && !grow_refs(index)) return 0;
+
+    uint32_t doc_id = (uint32_t)index->doc_count;
+    SearchDoc* doc = &index->docs[doc_id];
+    doc->kind = kind;
+    doc->owner_kind = owner_kind;
+    doc->owner_id = owner_id;
+    doc->ref = ref;
+    doc->length = 0;
+    doc->alive = 1;
+    doc->term_ids = NULL;
+    doc->term_id_count = doc->term_id_capacity = 0;
+    index->doc_count++;
+    index->live_docs++;
+
+    char token[SEARCH_MAX_TOKEN_LEN + 1];
+    for (int f = 0; f < field_count; ++f) {
+        const char* cursor = fields[f];
+        if (!cursor) continue;
+        size_t len;
+        while ((len = next_token(&cursor, token)) > 0) {
+            if (!add_posting(index, token, len, doc_id)) break; // Keep what we have on OOM
+            doc->length++;
+        }
+    }
+    index->live_length += doc->length;
+
+    RefSlot* slot = ref_slot(index->refs, index->ref_capacity, ref);
+    slot->ref = ref;
+    slot->doc_id = doc_id;
+    index->ref_count++;
+    return 1;
+}
+
+// ========================================================================== //
+//                                  QUERY                                     //
+// ========================================================================== //
+
+typedef struct {
+    uint32_t doc_id;
+    double score;
+} ScoredDoc;
+
+/**
+ * @brief Finds doc_id in postings[lo..count) by galloping then binary search.
+ * Returns its position, or the insertion point if absent.
+ */
+static size_t gallop_to(const Posting* postings, size_t lo, size_t count, uint32_t doc_id) {
+    size_t step = 1, hi = lo;
+    while (hi < count && postings[hi].doc_id < doc_id) {
+        lo = hi + 1;
+        hi += step;
+        step *= 2;
+    }
+    if (hi > count) hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (postings[mid].doc_id < doc_id) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Orders hits best-first; ties go to the newer document.
+ */
+static int scored_better(const ScoredDoc* a, const ScoredDoc* b) {
+    if (a->score != b->score) return a->score > b->score;
+    return a->doc_id > b->doc_id;
+}
+
+// Min-heap (worst hit at the root) holding the best 'capacity' hits seen so far
+static void heap_sift_down(ScoredDoc* heap, size_t size, size_t i) {
+    for (;;) {
+        size_t l = 2 * i + 1, r = l + 1, worst = i;
+        if (l < size && scored_better(&heap[worst], &heap[l])) worst = l;
+        if (r < size && scored_better(&heap[worst], &heap[r])) worst = r;
+        if (worst == i) return;
+        ScoredDoc tmp = heap[i]; heap[i] = heap[worst]; heap[worst] = tmp;
+        i = worst;
+    }
+}
+
+static void heap_push(ScoredDoc* heap, size_t* size, size_t capacity, ScoredDoc item) {
+    if (*size < capacity) {
+        size_t i = (*size)++;
+        heap[i] = item;
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!scored_better(&heap[parent], &heap[i])) break;
+            ScoredDoc tmp = heap[i]; heap[i] = heap[parent]; heap[parent] = tmp;
+            i = parent;
+        }
+    } else if (capacity > 0 && scored_better(&item, &heap[0])) {
+        heap[0] = item;
+        heap_sift_down(heap, *size, 0);
+    }
+}
+
+static int compare_scored_desc(const void* a, const void* b) {
+    const ScoredDoc* x = a;
+    const ScoredDoc* y = b;
+    if (scored_better(x, y)) return -1;
+    if (scored_better(y, x)) return 1;
+    return 0;
+}
+
+size_t search_index_query(const SearchIndex* index, const char* query, unsigned int kind_mask,
+                          size_t offset, size_t limit, SearchHit* out, size_t* total_out) {
+    if (total_out) *total_out = 0;
+    if (!index || !query || index->live_docs == 0) return 0;
+
+    // Resolve distinct query terms to their postings lists
+    const TermEntry* terms[SEARCH_MAX_QUERY_TERMS];
+    size_t term_total = 0;
+    char token[SEARCH_MAX_TOKEN_LEN + 1];
+    const char* cursor = query;
+    size_t len;
+    while (term_total < SEARCH_MAX_QUERY_TERMS && (len = next_token(&cursor, token)) > 0) {
+        const TermEntry* entry = term_slot(index->terms, index->term_capacity, token, len);
+        // AND semantics: a missing term, or one left only in removed documents, matches nothing
+        if (!entry->term || index->live_df[entry->id] == 0) return 0;
+        int duplicate = 0;
+        for (size_t i = 0; i < term_total; ++i) duplicate |= (terms[i] == entry);
+        if (!duplicate) terms[term_total++] = entry;
+    }
+    if (term_total == 0) return 0;
+
+    // Drive the intersection from the rarest term
+    for (size_t i = 1; i < term_total; ++i) {
+        const TermEntry* key = terms[i];
+        size_t j = i;
+        while (j > 0 && terms[j - 1]->count > key->count) { terms[j] = terms[j - 1]; j--; }
+        terms[j] = key;
+    }
+
+    double avg_length = (double)index->live_length / (double)index->live_docs;
+    if (avg_length <= 0) avg_length = 1;
+    double idf[SEARCH_MAX_QUERY_TERMS];
+    size_t cursors[SEARCH_MAX_QUERY_TERMS] = {0};
+    for (size_t i = 0; i < term_total; ++i) {
+        double df = (double)index->live_df[terms[i]->id]; // Postings of removed documents do not count
+        idf[i] = log(1.0 + ((double)index->live_docs - df + 0.5) / (df + 0.5));
+        if (idf[i] < 0.01) idf[i] = 0.01;
+    }
+
+    size_t heap_capacity = offset + limit;
+    ScoredDoc* heap = heap_capacity ? malloc(heap_capacity * sizeof(ScoredDoc)) : NULL;
+    if (heap_capacity && !heap) {
+        perror("search_index_query: malloc failed for result heap");
+        return 0;
+    }
+    size_t heap_size = 0, total = 0;
+
+    const TermEntry* driver = terms[0];
+    for (size_t p = 0; p < driver->count; ++p) {
+        uint32_t doc_id = driver->postings[p].doc_id;
+        const SearchDoc* doc = &index->docs[doc_id];
+        if (!doc->alive || !(kind_mask & SEARCH_KIND_BIT(doc->kind))) continue;
+
+        double norm = BM25_K1 * (1.0 - BM25_B + BM25_B * (double)doc->length / avg_length);
+        double tf = (double)driver->postings[p].tf;
+        double score = idf[0] * tf * (BM25_K1 + 1.0) / (tf + norm);
+        int matched = 1;
+        for (size_t t = 1; t < term_total && matched; ++t) {
+            const TermEntry* entry = terms[t];
+            cursors[t] = gallop_to(entry->postings, cursors[t], entry->count, doc_id);
+            if (cursors[t] >= entry->count || entry->postings[cursors[t]].doc_id != doc_id) {
+                matched = 0;
+                break;
+            }
+            tf = (double)entry->postings[cursors[t]].tf;
+            score += idf[t] * tf * (BM25_K1 + 1.0) / (tf + norm);
+        }
+        if (!matched) continue;
+
+        total++;
+        ScoredDoc scored = { doc_id, score };
+        heap_push(heap, &heap_size, heap_capacity, scored);
+    }
+    if (total_out) *total_out = total;
+
+    if (heap_size > 1) qsort(heap, heap_size, sizeof(ScoredDoc), compare_scored_desc);
+    size_t written = 0;
+    for (size_t i = offset; i < heap_size && written < limit; ++i) {
+        const SearchDoc* doc = &index->docs[heap[i].doc_id];
+        out[written].kind = doc->kind;
+        out[written].owner_kind = doc->owner_kind;
+        out[written].owner_id = doc->owner_id;
+        out[written].ref = doc->ref;
+        out[written].score = heap[i].score;
+        written++;
+    }
+    free(heap);
+    return written;
+}
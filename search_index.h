@@ -0,0 +1,60 @@
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+#include <stddef.h>
+
+// --- Document Kinds ---
+typedef enum {
+    SEARCH_DOC_MENTEE,  // Mentee name + subject
+    SEARCH_DOC_MEETING, // Meeting notes
+    SEARCH_DOC_ISSUE,   // Issue description
+    SEARCH_DOC_NOTE     // General note (mentee) or response note (issue)
+} SearchDocKind;
+
+#define SEARCH_KIND_BIT(kind) (1u << (kind))
+#define SEARCH_KIND_ALL 0xFu
+
+// A ranked search result. 'ref' points at the live Mentee/Meeting/Issue/Note.
+typedef struct {
+    SearchDocKind kind;
+    SearchDocKind owner_kind; // For notes: SEARCH_DOC_MENTEE or SEARCH_DOC_ISSUE; otherwise == kind
+    int owner_id;             // ID of the entity (or of the note's parent)
+    const void* ref;
+    double score;
+} SearchHit;
+
+typedef struct SearchIndex SearchIndex;
+
+// --- Lifecycle ---
+SearchIndex* search_index_create(void);
+void search_index_free(SearchIndex* index);
+
+// --- Incremental Maintenance ---
+/**
+ * @brief Indexes the given text fields as one document identified by 'ref'.
+ * Re-adding an already indexed ref replaces the previous document.
+ * @return 1 on success, 0 on allocation failure.
+ */
+int search_index_add(SearchIndex* index, SearchDocKind kind, SearchDocKind owner_kind, int owner_id,
+                     const void* ref, const char* const* fields, int field_count);
+
+/**
+ * @brief Drops the document for 'ref' (no-op if not indexed). Must be called
+ * before the referenced struct is freed.
+ */
+void search_index_remove(SearchIndex* index, const void* ref);
+
+// --- Query ---
+/**
+ * @brief Ranked AND-query (BM25) over all terms in 'query'.
+ * Writes up to 'limit' hits starting at rank 'offset' into 'out', restricted
+ * to kinds in kind_mask (SEARCH_KIND_BIT flags). *total_out receives the total
+ * number of matching documents. Returns the number of hits written.
+ */
+size_t search_index_query(const SearchIndex* index, const char* query, unsigned int kind_mask,
+                          size_t offset, size_t limit, SearchHit* out, size_t* total_out);
+
+size_t search_index_document_count(const SearchIndex* index);
+size_t search_index_term_count(const SearchIndex* index);
+
+#endif // SEARCH_INDEX_H
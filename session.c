@@ -0,0 +1,238 @@
+#define _GNU_SOURCE // For getrandom()
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/random.h>
+#include "session.h"
+#include "logger.h"
+
+#define SESSION_BUCKETS 4096        // Hash buckets (power of two); chains stay short well past this many sessions
+#define SESSION_STRIPES 64          // Bucket locks; bucket i is guarded by stripe i % SESSION_STRIPES
+#define SESSION_WHEEL_SLOTS 512     // Timer wheel slots (power of two)
+#define SESSION_WHEEL_TICK 60       // Seconds per slot: one revolution spans ~8.5 hours
+
+// ========================================================================== //
+//                             DATA STRUCTURES                                //
+// ========================================================================== //
+
+/**
+ * Every session sits in two lists: its hash bucket (found by token) and the
+ * wheel slot of its expiry tick (found by time). The wheel lock is taken
+ * before any stripe lock; lookups only ever take their stripe.
+ */
+typedef struct SessionEntry {
+    unsigned char token[SESSION_TOKEN_BYTES];
+    SessionInfo info;
+    time_t expires_at;
+    struct SessionEntry* hash_next;
+    struct SessionEntry* wheel_prev;
+    struct SessionEntry* wheel_next;
+} SessionEntry;
+
+static SessionEntry* buckets[SESSION_BUCKETS];
+static pthread_mutex_t stripes[SESSION_STRIPES];
+static SessionEntry* wheel[SESSION_WHEEL_SLOTS];
+static pthread_mutex_t wheel_lock = PTHREAD_MUTEX_INITIALIZER;
+static time_t swept_tick = 0;       // Last tick whose slot was swept; read without the lock as a hint
+static size_t live_sessions = 0;    // Guarded by wheel_lock
+static pthread_once_t stripes_once = PTHREAD_ONCE_INIT;
+
+static void init_stripes(void) {
+    for (int i = 0; i < SESSION_STRIPES; ++i) pthread_mutex_init(&stripes[i], NULL);
+}
+
+// ========================================================================== //
+//                                 HELPERS                                    //
+// ========================================================================== //
+
+// Tokens are uniformly random, so their leading bytes already make a good hash
+static size_t token_bucket(const unsigned char* token) {
+    uint32_t h;
+    memcpy(&h, token, sizeof(h));
+    return h & (SESSION_BUCKETS - 1);
+}
+
+static pthread_mutex_t* bucket_stripe(size_t bucket) {
+    return &stripes[bucket % SESSION_STRIPES];
+}
+
+static int decode_token(const char* hex, unsigned char* out) {
+    if (!hex || strlen(hex) != SESSION_TOKEN_LENGTH) return 0;
+    for (int i = 0; i < SESSION_TOKEN_BYTES; ++i) {
+        unsigned int value = 0;
+        for (int k = 0; k < 2; ++k) {
+            char c = hex[i * 2 + k];
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= (unsigned int)(c - '0');
+            else if (c >= 'a' && c <= 'f') value |= (unsigned int)(c - 'a' + 10);
+            else return 0;
+        }
+        out[i] = (unsigned char)value;
+    }
+    return 1;
+}
+
+// Compares without an early exit, so timing says nothing about how much matched
+static int token_equal(const unsigned char* a, const unsigned char* b) {
+    unsigned char diff = 0;
+    for (int i = 0; i < SESSION_TOKEN_BYTES; ++i) diff |= (unsigned char)(a[i] ^ b[i]);
+    return diff == 0;
+}
+
+// Caller holds the entry's stripe. Returns the unlinked entry or NULL.
+static SessionEntry* bucket_remove(size_t bucket, const unsigned char* token) {
+    for (SessionEntry** link = &buckets[bucket]; *link; link = &(*link)->hash_next) {
+        if (token_equal((*link)->token, token)) {
+            SessionEntry* entry = *link;
+            *link = entry->hash_next;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Caller holds wheel_lock
+static void wheel_insert(SessionEntry* entry) {
+    size_t slot = (size_t)(entry->expires_at / SESSION_WHEEL_TICK) & (SESSION_WHEEL_SLOTS - 1);
+    entry->wheel_prev = NULL;
+    entry->wheel_next = wheel[slot];
+    if (wheel[slot]) wheel[slot]->wheel_prev = entry;
+    wheel[slot] = entry;
+}
+
+// Caller holds wheel_lock
+static void wheel_unlink(SessionEntry* entry) {
+    size_t slot = (size_t)(entry->expires_at / SESSION_WHEEL_TICK) & (SESSION_WHEEL_SLOTS - 1);
+    if (entry->wheel_prev) entry->wheel_prev->wheel_next = entry->wheel_next;
+    else wheel[slot] = entry->wheel_next;
+    if (entry->wheel_next) entry->wheel_next->wheel_prev = entry->wheel_prev;
+}
+
+/**
+ * @brief Frees the sessions of every tick that ended since the last sweep.
+ * Caller holds wheel_lock. Entries due on a later revolution stay put.
+ */
+static void wheel_advance(time_t now) {
+    time_t last_tick = now / SESSION_WHEEL_TICK - 1; // The current tick is still running
+    time_t from = swept_tick;
+    if (from == 0) from = last_tick; // First call: nothing can have expired yet
+    if (last_tick - from > SESSION_WHEEL_SLOTS) from = last_tick - SESSION_WHEEL_SLOTS;
+    size_t expired = 0;
+    for (time_t tick = from + 1; tick <= last_tick; ++tick) {
+        SessionEntry* entry = wheel[(size_t)tick & (SESSION_WHEEL_SLOTS - 1)];
+        while (entry) {
+            SessionEntry* next = entry->wheel_next;
+            if (entry->expires_at <= now) {
+                size_t bucket = token_bucket(entry->token);
+                pthread_mutex_lock(bucket_stripe(bucket));
+                bucket_remove(bucket, entry->token);
+                pthread_mutex_unlock(bucket_stripe(bucket));
+                wheel_unlink(entry);
+                free(entry);
+                expired++;
+            }
+            entry = next;
+        }
+    }
+    __atomic_store_n(&swept_tick, last_tick, __ATOMIC_RELAXED);
+    live_sessions -= expired;
+    if (expired) LOG_DEBUG("[SESSION] Expired %zu session(s); %zu live.", expired, live_sessions);
+}
+
+/**
+ * @brief Sweeps the wheel once a tick has ended. Lookups use trylock so they
+ * never queue behind a sweep; whoever gets the lock does the work.
+ */
+static void maybe_advance(time_t now) {
+    if (__atomic_load_n(&swept_tick, __ATOMIC_RELAXED) == now / SESSION_WHEEL_TICK - 1) return;
+    if (pthread_mutex_trylock(&wheel_lock) != 0) return;
+    wheel_advance(now);
+    pthread_mutex_unlock(&wheel_lock);
+}
+
+// ========================================================================== //
+//                                PUBLIC API                                  //
+// ========================================================================== //
+
+int session_create(const SessionInfo* info, char* token_out) {
+    if (!info || !token_out) return 0;
+    pthread_once(&stripes_once, init_stripes);
+    SessionEntry* entry = calloc(1, sizeof(SessionEntry));
+    if (!entry) return 0;
+    if (getrandom(entry->token, sizeof(entry->token), 0) != (ssize_t)sizeof(entry->token)) {
+        LOG_ERROR("[SESSION] getrandom failed; no session issued.");
+        free(entry);
+        return 0;
+    }
+    time_t now = time(NULL);
+    entry->info = *info;
+    entry->expires_at = now + SESSION_TTL_SECONDS;
+    // Encoded before publishing: once in the table the entry may be revoked at any time
+    static const char digits[] = "0123456789abcdef";
+    for (int i = 0; i < SESSION_TOKEN_BYTES; ++i) {
+        token_out[i * 2] = digits[entry->token[i] >> 4];
+        token_out[i * 2 + 1] = digits[entry->token[i] & 0xF];
+    }
+    token_out[SESSION_TOKEN_LENGTH] = '\0';
+
+    size_t bucket = token_bucket(entry->token);
+    pthread_mutex_lock(&wheel_lock);
+    wheel_advance(now);
+    pthread_mutex_lock(bucket_stripe(bucket));
+    entry->hash_next = buckets[bucket];
+    buckets[bucket] = entry;
+    pthread_mutex_unlock(bucket_stripe(bucket));
+    wheel_insert(entry);
+    live_sessions++;
+    pthread_mutex_unlock(&wheel_lock);
+    return 1;
+}
+
+int session_lookup(const char* token, SessionInfo* out) {
+    unsigned char raw[SESSION_TOKEN_BYTES];
+    if (!decode_token(token, raw)) return 0;
+    pthread_once(&stripes_once, init_stripes);
+    time_t now = time(NULL);
+    maybe_advance(now);
+
+    int found = 0;
+    size_t bucket = token_bucket(raw);
+    pthread_mutex_lock(bucket_stripe(bucket));
+    for (const SessionEntry* entry = buckets[bucket]; entry; entry = entry->hash_next) {
+        if (token_equal(entry->token, raw)) {
+            found = entry->expires_at > now; // Not yet swept is not the same as valid
+            if (found && out) *out = entry->info;
+            break;
+        }
+    }
+    pthread_mutex_unlock(bucket_stripe(bucket));
+    return found;
+}
+
+int session_revoke(const char* token) {
+    unsigned char raw[SESSION_TOKEN_BYTES];
+    if (!decode_token(token, raw)) return 0;
+    pthread_once(&stripes_once, init_stripes);
+
+    size_t bucket = token_bucket(raw);
+    pthread_mutex_lock(&wheel_lock);
+    pthread_mutex_lock(bucket_stripe(bucket));
+    SessionEntry* entry = bucket_remove(bucket, raw);
+    pthread_mutex_unlock(bucket_stripe(bucket));
+    int live = entry && entry->expires_at > time(NULL);
+    if (entry) {
+        wheel_unlink(entry);
+        free(entry);
+        live_sessions--;
+    }
+    pthread_mutex_unlock(&wheel_lock);
+    return live;
+}
+
+size_t session_count(void) {
+    pthread_mutex_lock(&wheel_lock);
+    size_t count = live_sessions;
+    pthread_mutex_unlock(&wheel_lock);
+    return count;
+}
@@ -0,0 +1,41 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <time.h>
+#include "mentorship_data.h"
+
+#define SESSION_TOKEN_BYTES 32                          // Random bytes per token
+#define SESSION_TOKEN_LENGTH (SESSION_TOKEN_BYTES * 2)  // Hex characters, without the NUL
+#define SESSION_TTL_SECONDS (8 * 60 * 60)               // Absolute lifetime from login
+
+/**
+ * @brief What a token grants, copied from the user at login so validating a
+ * request never touches the user collection.
+ */
+typedef struct {
+    int user_id;
+    UserRole role;
+    int associated_id;  // Mentee ID for mentee accounts, else 0
+} SessionInfo;
+
+/**
+ * @brief Issues a random token for 'info' and writes it, hex encoded and
+ * NUL-terminated, to 'token_out' (SESSION_TOKEN_LENGTH + 1 bytes).
+ * Returns 1 on success, 0 if no randomness or memory was available.
+ */
+int session_create(const SessionInfo* info, char* token_out);
+
+/**
+ * @brief O(1) validation: copies the session behind 'token' to 'out'.
+ * Returns 0 for unknown, malformed, revoked or expired tokens.
+ */
+int session_lookup(const char* token, SessionInfo* out);
+
+/**
+ * @brief Revokes 'token' (logout). Returns 1 if it was live.
+ */
+int session_revoke(const char* token);
+
+size_t session_count(void);
+
+#endif // SESSION_H
@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "skiplist.h"
+#include "memstats.h"
+
+#define SKIPLIST_MAX_LEVEL 24 // Comfortable for ~16M entries with p = 1/4
+
+struct SkipListNode {
+    void* item;
+    int level;                  // Number of forward pointers in use
+    SkipListNode* forward[];    // Flexible array, one pointer per level
+};
+
+struct SkipList {
+    SkipListCompare compare;
+    int level;                  // Highest level currently in use (>= 1)
+    size_t size;
+    unsigned int rng_state;     // xorshift state for level generation
+    SkipListNode* head;         // Sentinel with SKIPLIST_MAX_LEVEL pointers
+};
+
+static size_t skiplist_node_bytes(int level) {
+    return sizeof(SkipListNode) + (size_t)level * sizeof(SkipListNode*);
+}
+
+/**
+ * @brief Allocates a node with room for 'level' forward pointers.
+ */
+static SkipListNode* skiplist_node_create(void* item, int level) {
+    SkipListNode* node = malloc(skiplist_node_bytes(level));
+    if (!node) {
+        perror("skiplist_node_create: malloc failed");
+        return NULL;
+    }
+    node->item = item;
+    node->level = level;
+    for (int i = 0; i < level; ++i) node->forward[i] = NULL;
+    memstats_alloc(MEM_INDEXES, skiplist_node_bytes(level));
+    return node;
+}
+
+static void skiplist_node_free(SkipListNode* node) {
+    memstats_free(MEM_INDEXES, skiplist_node_bytes(node->level));
+    free(node);
+}
+
+/**
+ * @brief Picks a random level with P(level > k) = 1/4^k.
+ */
+static int skiplist_random_level(SkipList* list) {
+    unsigned int x = list->rng_state;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    list->rng_state = x;
+
+    int level = 1;
+    while ((x & 3u) == 0 && level < SKIPLIST_MAX_LEVEL) {
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+SkipList* skiplist_create(SkipListCompare compare) {
+    if (!compare) return NULL;
+    SkipList* list = malloc(sizeof(SkipList));
+    if (!list) {
+        perror("skiplist_create: malloc failed");
+        return NULL;
+    }
+    list->head = skiplist_node_create(NULL, SKIPLIST_MAX_LEVEL);
+    if (!list->head) {
+        free(list);
+        return NULL;
+    }
+    memstats_alloc(MEM_INDEXES, sizeof(SkipList));
+    list->compare = compare;
+    list->level = 1;
+    list->size = 0;
+    list->rng_state = 0x9E3779B9u ^ (unsigned int)(size_t)list; // Any non-zero seed works
+    if (list->rng_state == 0) list->rng_state = 1;
+    return list;
+}
+
+void skiplist_free(SkipList* list) {
+    if (!list) return;
+    SkipListNode* current = list->head->forward[0];
+    while (current) {
+        SkipListNode* next_node = current->forward[0];
+        skiplist_node_free(current);
+        current = next_node;
+    }
+    skiplist_node_free(list->head);
+    memstats_free(MEM_INDEXES, sizeof(SkipList));
+    free(list);
+}
+
+/**
+ * @brief Fills update[] with the last node before 'item' on every level.
+ */
+static void skiplist_find_predecessors(const SkipList* list, const void* item, SkipListNode** update) {
+    SkipListNode* x = list->head;
+    for (int i = list->level - 1; i >= 0; --i) {
+        while (x->forward[i] && list->compare(x->forward[i]->item, item) < 0) {
+            x = x->forward[i];
+        }
+        update[i] = x;
+    }
+}
+
+int skiplist_insert(SkipList* list, void* item) {
+    if (!list || !item) return 0;
+    SkipListNode* update[SKIPLIST_MAX_LEVEL];
+    skiplist_find_predecessors(list, item, update);
+
+    SkipListNode* candidate = update[0]->forward[0];
+    if (candidate && list->compare(candidate->item, item) == 0) {
+        return 0; // Duplicate key
+    }
+
+    int level = skiplist_random_level(list);
+    if (level > list->level) {
+        for (int i = list->level; i < level; ++i) update[i] = list->head;
+        list->level = level;
+    }
+
+    SkipListNode* node = skiplist_node_create(item, level);
+    if (!node) return 0;
+    for (int i = 0; i < level; ++i) {
+        node->forward[i] = update[i]->forward[i];
+        update[i]->forward[i] = node;
+    }
+    list->size++;
+    return 1;
+}
+
+int skiplist_remove(SkipList* list, const void* item) {
+    if (!list || !item) return 0;
+    SkipListNode* update[SKIPLIST_MAX_LEVEL];
+    skiplist_find_predecessors(list, item, update);
+
+    SkipListNode* node = update[0]->forward[0];
+    if (!node || list->compare(node->item, item) != 0) {
+        return 0; // Not found
+    }
+    for (int i = 0; i < node->level; ++i) {
+        if (update[i]->forward[i] == node) update[i]->forward[i] = node->forward[i];
+    }
+    skiplist_node_free(node);
+    while (list->level > 1 && list->head->forward[list->level - 1] == NULL) {
+        list->level--;
+    }
+    list->size--;
+    return 1;
+}
+
+SkipListNode* skiplist_lower_bound(const SkipList* list, const void* probe) {
+    if (!list || !probe) return NULL;
+    SkipListNode* x = list->head;
+    for (int i = list->level - 1; i >= 0; --i) {
+        while (x->forward[i] && list->compare(x->forward[i]->item, probe) < 0) {
+            x = x->forward[i];
+        }
+    }
+    return x->forward[0];
+}
+
+SkipListNode* skiplist_first(const SkipList* list) {
+    return list ? list->head->forward[0] : NULL;
+}
+
+SkipListNode* skiplist_next(const SkipListNode* node) {
+    return node ? node->forward[0] : NULL;
+}
+
+void* skiplist_value(const SkipListNode* node) {
+    return node ? node->item : NULL;
+}
+
+size_t skiplist_size(const SkipList* list) {
+    return list ? list->size : 0;
+}
@@ -0,0 +1,35 @@
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <stddef.h>
+
+/**
+ * @brief Ordering function for items stored in a SkipList.
+ * Must return <0, 0 or >0 like strcmp. Items comparing equal are treated as
+ * the same entry, so callers should include a unique tie-breaker (e.g. an ID).
+ */
+typedef int (*SkipListCompare)(const void* a, const void* b);
+
+typedef struct SkipList SkipList;
+typedef struct SkipListNode SkipListNode;
+
+// --- Lifecycle ---
+SkipList* skiplist_create(SkipListCompare compare);
+void skiplist_free(SkipList* list); // Frees nodes only; items are owned by the caller
+
+// --- Modification (O(log n) expected) ---
+int skiplist_insert(SkipList* list, void* item);       // 1 on success, 0 on failure/duplicate
+int skiplist_remove(SkipList* list, const void* item); // 1 if removed, 0 if not found
+
+// --- Lookup / Iteration ---
+/**
+ * @brief Returns the first node whose item compares >= probe, or NULL.
+ * The probe only has to carry the fields the comparator reads.
+ */
+SkipListNode* skiplist_lower_bound(const SkipList* list, const void* probe);
+SkipListNode* skiplist_first(const SkipList* list);
+SkipListNode* skiplist_next(const SkipListNode* node);
+void* skiplist_value(const SkipListNode* node);
+size_t skiplist_size(const SkipList* list);
+
+#endif // SKIPLIST_H
@@ -0,0 +1,319 @@
+/**
+ * Data-layer microbenchmarks (make bench).
+ *
+ * Builds synthetic AppData at each requested size and times the hot
+ * operations of mentorship_data.c and the list serializers of json_helpers.c.
+ * Prints a table and appends one JSON object per result to the --out file so
+ * runs can be diffed for regressions.
+ *
+ * Usage: bench_data [--sizes 1000,10000,100000] [--out FILE] [--min-time-ms 200]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <cjson/cJSON.h>
+#include "mentorship_data.h"
+#include "json_helpers.h"
+#include "logger.h"
+#include "metrics.h"
+#include "memstats.h"
+#include "password.h"
+
+#define MAX_SIZES 16
+#define DEFAULT_SIZES "1000,10000,100000"
+#define DEFAULT_OUT "bench_results.jsonl"
+#define MUTATION_BATCH 1000  // Adds/deletes per size, so the dataset stays ~N
+
+static const char* const subjects[] = { "Mathematics", "Physics", "Computer Science", "Chemistry", "Biology", "History" };
+#define SUBJECT_COUNT (sizeof(subjects) / sizeof(subjects[0]))
+
+// ========================================================================== //
+//                           ALLOCATION COUNTING                              //
+// ========================================================================== //
+
+// cJSON allocations are not in memstats; count them through its hooks
+static unsigned long long cjson_allocs = 0;
+
+static void* counting_malloc(size_t size) {
+    cjson_allocs++;
+    return malloc(size);
+}
+
+static unsigned long long allocation_count(void) {
+    MemCategoryStats stats[MEM_CATEGORY_COUNT];
+    memstats_snapshot(stats);
+    unsigned long long total = cjson_allocs;
+    for (int i = 0; i < MEM_CATEGORY_COUNT; ++i) total += stats[i].total_allocs;
+    return total;
+}
+
+// ========================================================================== //
+//                              BENCH HARNESS                                 //
+// ========================================================================== //
+
+typedef struct {
+    AppData* data;
+    size_t n;
+    Mentee** mentees;       // Snapshot of the generated records for O(1) picks
+    Issue** issues;
+    size_t mentee_count;
+    size_t issue_count;
+    unsigned int rng;
+    int next_added;         // Suffix for names created during the run
+    int added_ids[MUTATION_BATCH];
+    int added_count;
+    size_t delete_cursor;
+} BenchCtx;
+
+typedef void (*BenchOp)(BenchCtx* ctx);
+
+static FILE* results_file = NULL;
+static uint64_t min_time_ns = 200ULL * 1000000ULL;
+
+static unsigned int next_random(BenchCtx* ctx) {
+    unsigned int x = ctx->rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    ctx->rng = x;
+    return x;
+}
+
+static void report(const char* name, size_t n, unsigned long long ops, uint64_t elapsed_ns, unsigned long long allocs, size_t items_per_op) {
+    double ns_per_op = ops ? (double)elapsed_ns / (double)ops : 0.0;
+    double allocs_per_op = ops ? (double)allocs / (double)ops : 0.0;
+    printf("%-28s n=%-8zu %12.1f ns/op %10.2f allocs/op %10llu ops", name, n, ns_per_op, allocs_per_op, ops);
+    if (items_per_op > 1) printf("  (%.1f ns/item)", ns_per_op / (double)items_per_op);
+    printf("\n");
+    if (results_file) {
+        fprintf(results_file,
+                "{\"benchmark\":\"%s\",\"entities\":%zu,\"ops\":%llu,\"ns_per_op\":%.1f,\"allocs_per_op\":%.3f,\"items_per_op\":%zu,\"timestamp\":%ld}\n",
+                name, n, ops, ns_per_op, allocs_per_op, items_per_op, (long)time(NULL));
+    }
+}
+
+/**
+ * @brief Runs 'op' in growing batches until min_time_ns has passed or
+ * max_ops were done, then reports the average.
+ */
+static void run_bench(const char* name, BenchCtx* ctx, BenchOp op, unsigned long long max_ops, size_t items_per_op) {
+    unsigned long long ops = 0;
+    unsigned long long batch = 1;
+    uint64_t elapsed = 0;
+    unsigned long long allocs_before = allocation_count();
+    while (elapsed < min_time_ns && ops < max_ops) {
+        if (batch > max_ops - ops) batch = max_ops - ops;
+        uint64_t start = metrics_now_ns();
+        for (unsigned long long i = 0; i < batch; ++i) op(ctx);
+        elapsed += metrics_now_ns() - start;
+        ops += batch;
+        batch *= 2;
+    }
+    report(name, ctx->n, ops, elapsed, allocation_count() - allocs_before, items_per_op);
+}
+
+// ========================================================================== //
+//                               OPERATIONS                                   //
+// ========================================================================== //
+
+static volatile const void* sink; // Keeps lookups from being optimised away
+
+static void op_find_mentee_by_id(BenchCtx* ctx) {
+    sink = find_mentee_by_id(ctx->data, 1 + (int)(next_random(ctx) % ctx->n));
+}
+
+static void op_find_meeting_by_id(BenchCtx* ctx) {
+    sink = find_meeting_by_id(ctx->data, 1 + (int)(next_random(ctx) % ctx->n));
+}
+
+static void op_find_issue_by_id(BenchCtx* ctx) {
+    sink = find_issue_by_id(ctx->data, 1 + (int)(next_random(ctx) % ctx->n));
+}
+
+static void op_find_user_by_username(BenchCtx* ctx) {
+    char username[32];
+    snprintf(username, sizeof(username), "mentee%u", 1 + next_random(ctx) % (unsigned int)ctx->n);
+    sink = find_user_by_username(ctx->data, username);
+}
+
+static void op_suggest_mentees(BenchCtx* ctx) {
+    MenteeSuggestion out[10];
+    char prefix[16];
+    snprintf(prefix, sizeof(prefix), "mentee %u", 1 + next_random(ctx) % 9);
+    sink = (const void*)(size_t)suggest_mentees(ctx->data, prefix, out, 10);
+}
+
+static void op_update_issue_status(BenchCtx* ctx) {
+    Issue* issue = ctx->issues[next_random(ctx) % ctx->issue_count];
+    update_issue_status(ctx->data, issue, (IssueStatus)((issue->status + 1) % ISSUE_STATUS_COUNT), NULL);
+}
+
+static void op_add_mentee_note(BenchCtx* ctx) {
+    Mentee* mentee = ctx->mentees[next_random(ctx) % ctx->mentee_count];
+    add_mentee_note(ctx->data, mentee, "Discussed progress on the current assignment and next steps.");
+}
+
+static void op_add_mentee(BenchCtx* ctx) {
+    char name[64];
+    snprintf(name, sizeof(name), "Added Mentee %d", ctx->next_added++);
+    Mentee* mentee = add_mentee(ctx->data, name, subjects[ctx->next_added % SUBJECT_COUNT], "added@example.com");
+    if (mentee && ctx->added_count < MUTATION_BATCH) ctx->added_ids[ctx->added_count++] = mentee->id;
+}
+
+static void op_delete_mentee(BenchCtx* ctx) {
+    // Deletes the mentees added above, oldest first: they sit deep in the list
+    if (ctx->delete_cursor < (size_t)ctx->added_count) delete_mentee(ctx->data, ctx->added_ids[ctx->delete_cursor++]);
+}
+
+static void op_delete_meeting(BenchCtx* ctx) {
+    // Prime stride visits ids in scattered order without repeating one
+    int id = 1 + (int)((ctx->delete_cursor++ * 7919) % ctx->n);
+    delete_meeting(ctx->data, id);
+}
+
+static void op_serialize_mentees(BenchCtx* ctx) {
+    cJSON_Delete(mentee_list_to_json_array(ctx->data->mentees_head));
+}
+
+static void op_serialize_meetings(BenchCtx* ctx) {
+    cJSON_Delete(meeting_list_to_json_array(ctx->data->meetings_head));
+}
+
+static void op_serialize_issues(BenchCtx* ctx) {
+    cJSON_Delete(issue_list_to_json_array(ctx->data->issues_head));
+}
+
+static void op_print_mentees(BenchCtx* ctx) {
+    cJSON* array = mentee_list_to_json_array(ctx->data->mentees_head);
+    char* text = cJSON_PrintUnformatted(array);
+    cJSON_free(text);
+    cJSON_Delete(array);
+}
+
+// ========================================================================== //
+//                              DATA GENERATION                               //
+// ========================================================================== //
+
+/**
+ * @brief Fills a fresh AppData with n mentees (each with a user account),
+ * n meetings and n issues (every fourth one with a response note).
+ */
+static int populate(BenchCtx* ctx, size_t n) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->n = n;
+    ctx->rng = 0x2545F491u;
+    ctx->data = create_empty_app_data();
+    ctx->mentees = malloc(n * sizeof(Mentee*));
+    ctx->issues = malloc(n * sizeof(Issue*));
+    if (!ctx->data || !ctx->mentees || !ctx->issues) return 0;
+
+    char name[64], username[32], date[16], clock[8];
+    char hash[PASSWORD_HASH_SIZE]; // Shared by all users; per-account hashing would swamp the setup
+    if (!password_hash("password", hash, sizeof(hash))) return 0;
+    for (size_t i = 1; i <= n; ++i) {
+        snprintf(name, sizeof(name), "Mentee %zu Surname%zu", i, i % 997);
+        Mentee* mentee = add_mentee(ctx->data, name, subjects[i % SUBJECT_COUNT], "mentee@example.com");
+        if (!mentee) return 0;
+        ctx->mentees[ctx->mentee_count++] = mentee;
+        snprintf(username, sizeof(username), "mentee%zu", i);
+        add_user_with_hash(ctx->data, username, hash, ROLE_MENTEE, mentee->id);
+    }
+    for (size_t i = 1; i <= n; ++i) {
+        Mentee* mentee = ctx->mentees[(i * 7919) % n];
+        size_t slot = i * 2; // Two 30-minute slots per meeting keeps them disjoint
+        snprintf(date, sizeof(date), "2026-%02zu-%02zu", 1 + (slot / (28 * 16)) % 12, 1 + (slot / 16) % 28);
+        snprintf(clock, sizeof(clock), "%02zu:%02zu", 8 + (slot % 16) / 2, (slot % 2) * 30);
+        add_meeting(ctx->data, mentee->id, mentee->name, date, clock, 30, "Weekly check-in");
+        Issue* issue = add_issue(ctx->data, mentee->id, mentee->name, "Struggling with the latest problem set",
+                                 "2026-01-15", (IssuePriority)(i % ISSUE_PRIORITY_COUNT));
+        if (!issue) return 0;
+        ctx->issues[ctx->issue_count++] = issue;
+        if (i % 4 == 0) update_issue_status(ctx->data, issue, STATUS_IN_PROGRESS, "Scheduled a follow-up session.");
+    }
+    return 1;
+}
+
+static void release(BenchCtx* ctx) {
+    free_app_data(ctx->data);
+    free(ctx->mentees);
+    free(ctx->issues);
+}
+
+// ========================================================================== //
+//                                  MAIN                                      //
+// ========================================================================== //
+
+static int parse_sizes(const char* text, size_t* sizes) {
+    int count = 0;
+    char* copy = strdup(text);
+    if (!copy) return 0;
+    for (char* token = strtok(copy, ","); token && count < MAX_SIZES; token = strtok(NULL, ",")) {
+        long long value = atoll(token);
+        if (value > 0) sizes[count++] = (size_t)value;
+    }
+    free(copy);
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    const char* sizes_arg = DEFAULT_SIZES;
+    const char* out_path = DEFAULT_OUT;
+    for (int i = 1; i < argc; ++i) {
+        if (0 == strcmp(argv[i], "--sizes") && i + 1 < argc) sizes_arg = argv[++i];
+        else if (0 == strcmp(argv[i], "--out") && i + 1 < argc) out_path = argv[++i];
+        else if (0 == strcmp(argv[i], "--min-time-ms") && i + 1 < argc) min_time_ns = (uint64_t)atoll(argv[++i]) * 1000000ULL;
+        else {
+            fprintf(stderr, "Usage: %s [--sizes 1000,10000,...] [--out FILE] [--min-time-ms MS]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    size_t sizes[MAX_SIZES];
+    int size_count = parse_sizes(sizes_arg, sizes);
+    if (size_count == 0) {
+        fprintf(stderr, "No valid sizes in '%s'\n", sizes_arg);
+        return 2;
+    }
+
+    log_set_level(LOG_LEVEL_ERROR); // The data layer logs every save/delete miss
+    cJSON_Hooks hooks = { counting_malloc, free };
+    cJSON_InitHooks(&hooks);
+
+    results_file = fopen(out_path, "a");
+    if (!results_file) perror("bench_data: cannot open results file");
+
+    for (int s = 0; s < size_count; ++s) {
+        size_t n = sizes[s];
+        BenchCtx ctx;
+        uint64_t start = metrics_now_ns();
+        if (!populate(&ctx, n)) {
+            fprintf(stderr, "Failed to generate %zu entities\n", n);
+            release(&ctx);
+            return 1;
+        }
+        printf("--- %zu entities (generated in %.1f ms) ---\n", n, (double)(metrics_now_ns() - start) / 1e6);
+
+        run_bench("find_mentee_by_id", &ctx, op_find_mentee_by_id, 10000000ULL, 1);
+        run_bench("find_meeting_by_id", &ctx, op_find_meeting_by_id, 10000000ULL, 1);
+        run_bench("find_issue_by_id", &ctx, op_find_issue_by_id, 10000000ULL, 1);
+        run_bench("find_user_by_username", &ctx, op_find_user_by_username, 10000000ULL, 1);
+        run_bench("suggest_mentees", &ctx, op_suggest_mentees, 10000000ULL, 1);
+        run_bench("update_issue_status", &ctx, op_update_issue_status, 10000000ULL, 1);
+        run_bench("add_note", &ctx, op_add_mentee_note, MUTATION_BATCH, 1);
+        run_bench("serialize_mentees", &ctx, op_serialize_mentees, 1000, ctx.mentee_count);
+        run_bench("serialize_meetings", &ctx, op_serialize_meetings, 1000, n);
+        run_bench("serialize_issues", &ctx, op_serialize_issues, 1000, n);
+        run_bench("print_mentees_json", &ctx, op_print_mentees, 1000, ctx.mentee_count);
+        run_bench("add_mentee", &ctx, op_add_mentee, MUTATION_BATCH, 1);
+        run_bench("delete_mentee", &ctx, op_delete_mentee, (unsigned long long)ctx.added_count, 1);
+        ctx.delete_cursor = 0;
+        run_bench("delete_meeting", &ctx, op_delete_meeting, MUTATION_BATCH, 1);
+
+        release(&ctx);
+    }
+
+    if (results_file) {
+        fclose(results_file);
+        printf("Results appended to %s\n", out_path);
+    }
+    return 0;
+}
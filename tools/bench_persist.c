@@ -0,0 +1,284 @@
+/**
+ * Persistence and startup benchmark (make bench-persist).
+ *
+ * For each size: generates a dataset, then times load_data_from_file() and
+ * save_data_to_file() and records peak RSS. With --server it also starts
+ * mentor_backend on the file and times it until the first request succeeds.
+ * Every measurement runs in a fresh child process so peak RSS is per size.
+ *
+ * Usage: bench_persist [--sizes 1000,10000,100000] [--server ./mentor_backend]
+ *                      [--port 8080] [--dir /tmp] [--out FILE]
+ */
+#define _GNU_SOURCE // For wait4
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "dataset.h"
+#include "logger.h"
+#include "metrics.h"
+
+#define MAX_SIZES 16
+#define DEFAULT_SIZES "1000,10000,100000"
+#define DEFAULT_OUT "bench_results.jsonl"
+#define STARTUP_TIMEOUT_NS (300ULL * 1000000000ULL)
+
+// Filled in by a child and sent back over a pipe
+typedef struct {
+    int ok;
+    uint64_t generate_ns;
+    uint64_t load_ns;
+    uint64_t save_ns;
+    long load_peak_rss_kb;    // ru_maxrss right after loading
+} ChildResult;
+
+static FILE* results_file = NULL;
+
+static void report(const char* name, size_t n, double ms, long peak_rss_kb, long long file_bytes) {
+    printf("%-26s n=%-8zu %10.1f ms   peak RSS %8.1f MiB   file %8.1f MiB\n",
+           name, n, ms, peak_rss_kb / 1024.0, file_bytes / (1024.0 * 1024.0));
+    if (results_file) {
+        fprintf(results_file, "{\"benchmark\":\"%s\",\"entities\":%zu,\"ms\":%.1f,\"peak_rss_kb\":%ld,\"file_bytes\":%lld,\"timestamp\":%ld}\n",
+                name, n, ms, peak_rss_kb, file_bytes, (long)time(NULL));
+    }
+}
+
+/**
+ * @brief Runs 'fn' in a child, returns its ChildResult and the child's peak RSS.
+ */
+static int run_in_child(int (*fn)(size_t, const char*, ChildResult*), size_t n, const char* path, ChildResult* result, long* peak_rss_kb) {
+    int fds[2];
+    if (pipe(fds) != 0) return 0;
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return 0;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        ChildResult child = { 0, 0, 0, 0, 0 };
+        child.ok = fn(n, path, &child);
+        ssize_t written = write(fds[1], &child, sizeof(child));
+        _exit(written == (ssize_t)sizeof(child) && child.ok ? 0 : 1);
+    }
+    close(fds[1]);
+    ssize_t got = read(fds[0], result, sizeof(*result));
+    close(fds[0]);
+    int status = 0;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) < 0) return 0;
+    *peak_rss_kb = usage.ru_maxrss;
+    return got == (ssize_t)sizeof(*result) && result->ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static int child_generate(size_t n, const char* path, ChildResult* result) {
+    DatasetSpec spec;
+    dataset_default_spec(&spec, (int)n);
+    uint64_t start = metrics_now_ns();
+    AppData* data = generate_dataset(&spec);
+    if (!data) return 0;
+    int saved = save_data_to_file(data, path);
+    result->generate_ns = metrics_now_ns() - start;
+    free_app_data(data);
+    return saved;
+}
+
+static int child_load_save(size_t n, const char* path, ChildResult* result) {
+    (void)n;
+    char save_path[1024];
+    snprintf(save_path, sizeof(save_path), "%s.saved", path);
+
+    uint64_t start = metrics_now_ns();
+    AppData* data = load_data_from_file(path);
+    result->load_ns = metrics_now_ns() - start;
+    if (!data) return 0;
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    result->load_peak_rss_kb = usage.ru_maxrss;
+
+    start = metrics_now_ns();
+    int saved = save_data_to_file(data, save_path);
+    result->save_ns = metrics_now_ns() - start;
+    free_app_data(data);
+    unlink(save_path);
+    return saved;
+}
+
+// ========================================================================== //
+//                              SERVER STARTUP                                //
+// ========================================================================== //
+
+/**
+ * @brief One GET /api/metrics; returns 1 once the server answers with 200.
+ */
+static int probe_server(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return 0;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int ok = 0;
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0) {
+        const char* request = "GET /api/metrics HTTP/1.0\r\nHost: localhost\r\n\r\n";
+        char reply[64];
+        if (send(fd, request, strlen(request), MSG_NOSIGNAL) == (ssize_t)strlen(request)) {
+            ssize_t n = recv(fd, reply, sizeof(reply) - 1, 0);
+            if (n > 0) {
+                reply[n] = '\0';
+                int status = 0;
+                ok = sscanf(reply, "HTTP/%*d.%*d %d", &status) == 1 && status == 200;
+            }
+        }
+    }
+    close(fd);
+    return ok;
+}
+
+/**
+ * @brief Peak RSS (VmHWM) of a running process in KiB, or 0.
+ */
+static long process_peak_rss_kb(pid_t pid) {
+    char path[64], line[256];
+    snprintf(path, sizeof(path), "/proc/%d/status", (int)pid);
+    FILE* fp = fopen(path, "r");
+    if (!fp) return 0;
+    long kb = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "VmHWM: %ld kB", &kb) == 1) break;
+    }
+    fclose(fp);
+    return kb;
+}
+
+static void bench_startup(const char* server, int port, size_t n, const char* path, long long file_bytes) {
+    if (probe_server(port)) {
+        fprintf(stderr, "bench_persist: something already answers on port %d, skipping startup timing\n", port);
+        return;
+    }
+    uint64_t start = metrics_now_ns();
+    pid_t pid = fork();
+    if (pid < 0) return;
+    if (pid == 0) {
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDOUT_FILENO);
+            dup2(devnull, STDERR_FILENO);
+        }
+        execl(server, server, path, (char*)NULL);
+        _exit(127);
+    }
+
+    int ready = 0;
+    while (metrics_now_ns() - start < STARTUP_TIMEOUT_NS) {
+        if (probe_server(port)) { ready = 1; break; }
+        if (waitpid(pid, NULL, WNOHANG) == pid) { pid = -1; break; }
+        usleep(2000);
+    }
+    uint64_t elapsed = metrics_now_ns() - start;
+    if (ready) report("startup_to_first_request", n, elapsed / 1e6, process_peak_rss_kb(pid), file_bytes);
+    else fprintf(stderr, "bench_persist: server did not answer for %zu entities\n", n);
+
+    if (pid > 0) {
+        kill(pid, SIGTERM); // Its shutdown save rewrites 'path', which is deleted next anyway
+        waitpid(pid, NULL, 0);
+    }
+}
+
+// ========================================================================== //
+//                                  MAIN                                      //
+// ========================================================================== //
+
+static int parse_sizes(const char* text, size_t* sizes) {
+    int count = 0;
+    char* copy = strdup(text);
+    if (!copy) return 0;
+    for (char* token = strtok(copy, ","); token && count < MAX_SIZES; token = strtok(NULL, ",")) {
+        long long value = atoll(token);
+        if (value > 0) sizes[count++] = (size_t)value;
+    }
+    free(copy);
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    const char* sizes_arg = DEFAULT_SIZES;
+    const char* out_path = DEFAULT_OUT;
+    const char* server = NULL;
+    const char* dir = "/tmp";
+    int port = 8080;
+    for (int i = 1; i < argc; ++i) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) goto usage;
+        if (0 == strcmp(argv[i], "--sizes")) sizes_arg = value;
+        else if (0 == strcmp(argv[i], "--out")) out_path = value;
+        else if (0 == strcmp(argv[i], "--server")) server = value;
+        else if (0 == strcmp(argv[i], "--dir")) dir = value;
+        else if (0 == strcmp(argv[i], "--port")) port = atoi(value);
+        else goto usage;
+        i++;
+    }
+
+    size_t sizes[MAX_SIZES];
+    int size_count = parse_sizes(sizes_arg, sizes);
+    if (size_count == 0) goto usage;
+    if (server && access(server, X_OK) != 0) {
+        fprintf(stderr, "bench_persist: '%s' is not executable, skipping startup timing\n", server);
+        server = NULL;
+    }
+
+    setvbuf(stdout, NULL, _IOLBF, 0); // Keep progress lines in order with stderr notes
+    log_set_level(LOG_LEVEL_WARN);
+    results_file = fopen(out_path, "a");
+    if (!results_file) perror("bench_persist: cannot open results file");
+
+    for (int s = 0; s < size_count; ++s) {
+        size_t n = sizes[s];
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/mentor_bench_%d_%zu.json", dir, (int)getpid(), n);
+
+        ChildResult result;
+        long peak_kb = 0;
+        if (!run_in_child(child_generate, n, path, &result, &peak_kb)) {
+            fprintf(stderr, "bench_persist: failed to generate %zu entities into %s\n", n, path);
+            unlink(path);
+            continue;
+        }
+        struct stat st;
+        long long file_bytes = stat(path, &st) == 0 ? (long long)st.st_size : 0;
+        printf("--- %zu mentees (%s) ---\n", n, path);
+        report("generate_dataset", n, result.generate_ns / 1e6, peak_kb, file_bytes);
+
+        if (run_in_child(child_load_save, n, path, &result, &peak_kb)) {
+            report("load_data_from_file", n, result.load_ns / 1e6, result.load_peak_rss_kb, file_bytes);
+            report("save_data_to_file", n, result.save_ns / 1e6, peak_kb, file_bytes);
+        } else {
+            fprintf(stderr, "bench_persist: load/save failed for %zu entities\n", n);
+        }
+
+        if (server) bench_startup(server, port, n, path, file_bytes);
+        unlink(path);
+    }
+
+    if (results_file) {
+        fclose(results_file);
+        printf("Results appended to %s\n", out_path);
+    }
+    return 0;
+
+usage:
+    fprintf(stderr, "Usage: %s [--sizes 1000,10000,...] [--server ./mentor_backend] [--port 8080] [--dir DIR] [--out FILE]\n", argv[0]);
+    return 2;
+}
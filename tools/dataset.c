@@ -0,0 +1,137 @@
+#define _POSIX_C_SOURCE 200809L // For gmtime_r
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "dataset.h"
+#include "password.h"
+
+static const char* const first_names[] = {
+    "Amara", "Ben", "Chiara", "Dmitri", "Elena", "Farah", "Gabriel", "Hana", "Ibrahim", "Julia",
+    "Kenji", "Lucia", "Mateo", "Nadia", "Oscar", "Priya", "Quentin", "Rosa", "Samuel", "Tara",
+    "Umar", "Valentina", "William", "Ximena", "Yusuf", "Zoe", "Aditya", "Beatriz", "Connor", "Daniela",
+};
+static const char* const last_names[] = {
+    "Okafor", "Schmidt", "Rossi", "Ivanov", "Garcia", "Haddad", "Silva", "Tanaka", "Nguyen", "Kowalski",
+    "Andersson", "Moreau", "Fernandez", "Kaur", "O'Brien", "Papadopoulos", "Yilmaz", "Novak", "Mendes", "Kim",
+};
+static const char* const subjects[] = {
+    "Mathematics", "Physics", "Computer Science", "Chemistry", "Biology", "History",
+    "Economics", "English Literature", "Statistics", "Data Structures",
+};
+static const char* const fragments[] = {
+    "Had trouble following the proof in the last lecture",
+    "asked for extra practice problems on recursion",
+    "the lab report deadline overlaps with two exams",
+    "wants feedback on the project proposal before submitting",
+    "missed the previous session because of a scheduling clash",
+    "is making steady progress and needs fewer check-ins",
+    "struggles to manage time across the coursework",
+    "found the reading list overwhelming this week",
+    "requested help preparing for the internship interview",
+    "reviewed the midterm and went through every incorrect answer",
+};
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+static unsigned int next_random(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Joins random fragments into 'out' until it is at least min_len long.
+ */
+static void random_text(unsigned int* rng, char* out, size_t cap, size_t min_len) {
+    size_t len = 0;
+    out[0] = '\0';
+    while (len < min_len && len + 2 < cap) {
+        const char* fragment = fragments[next_random(rng) % COUNT_OF(fragments)];
+        int n = snprintf(out + len, cap - len, "%s%s", len ? "; " : "", fragment);
+        if (n < 0 || (size_t)n >= cap - len) break;
+        len += (size_t)n;
+    }
+    if (len + 1 < cap) strcat(out, ".");
+}
+
+/**
+ * @brief Formats the date 'day' days after 2026-01-01 (UTC).
+ */
+static void format_day(int day, char* out, size_t cap) {
+    time_t t = (time_t)1767225600 + (time_t)day * 86400; // 2026-01-01T00:00:00Z
+    struct tm tm_utc;
+    gmtime_r(&t, &tm_utc);
+    strftime(out, cap, "%Y-%m-%d", &tm_utc);
+}
+
+void dataset_default_spec(DatasetSpec* spec, int mentees) {
+    spec->mentees = mentees;
+    spec->mentors = mentees / 50 > 0 ? mentees / 50 : 1;
+    spec->meetings_per_mentee = 3;
+    spec->issues_per_mentee = 2;
+    spec->notes_per_mentee = 2;
+    spec->seed = 12345;
+}
+
+AppData* generate_dataset(const DatasetSpec* spec) {
+    AppData* data = create_empty_app_data();
+    if (!data) return NULL;
+    unsigned int rng = spec->seed ? spec->seed : 1;
+    char name[96], username[32], email[128], date[16], clock[8], text[512];
+    // Every login shares one hash of "password": hashing per account would dominate generation
+    char hash[PASSWORD_HASH_SIZE];
+    if (!password_hash("password", hash, sizeof(hash))) goto fail;
+
+    if (!add_user_with_hash(data, "admin", hash, ROLE_MENTOR, 0)) goto fail;
+    for (int i = 1; i <= spec->mentors; ++i) {
+        snprintf(username, sizeof(username), "mentor%d", i);
+        if (!add_user_with_hash(data, username, hash, ROLE_MENTOR, 0)) goto fail;
+    }
+
+    for (int i = 1; i <= spec->mentees; ++i) {
+        const char* first = first_names[next_random(&rng) % COUNT_OF(first_names)];
+        const char* last = last_names[next_random(&rng) % COUNT_OF(last_names)];
+        snprintf(name, sizeof(name), "%s %s %d", first, last, i); // Names must be unique
+        snprintf(email, sizeof(email), "%s.%s%d@students.example.edu", first, last, i);
+        Mentee* mentee = add_mentee(data, name, subjects[next_random(&rng) % COUNT_OF(subjects)], email);
+        if (!mentee) goto fail;
+
+        // The default mentee login maps to the first mentee, the rest get their own
+        if (i == 1) {
+            if (!add_user_with_hash(data, "user", hash, ROLE_MENTEE, mentee->id)) goto fail;
+        } else {
+            snprintf(username, sizeof(username), "mentee%d", i);
+            if (!add_user_with_hash(data, username, hash, ROLE_MENTEE, mentee->id)) goto fail;
+        }
+
+        for (int k = 0; k < spec->notes_per_mentee; ++k) {
+            random_text(&rng, text, sizeof(text), 30 + next_random(&rng) % 270);
+            add_mentee_note(data, mentee, text);
+        }
+        for (int k = 0; k < spec->meetings_per_mentee; ++k) {
+            // Weekly cadence from a per-mentee start day, half-hour slots 08:00-17:30
+            format_day((int)(next_random(&rng) % 60) + k * 7, date, sizeof(date));
+            unsigned int slot = next_random(&rng) % 20;
+            snprintf(clock, sizeof(clock), "%02u:%02u", 8 + slot / 2, (slot % 2) * 30);
+            random_text(&rng, text, sizeof(text), 20 + next_random(&rng) % 140);
+            if (!add_meeting(data, mentee->id, mentee->name, date, clock, 30 + 15 * (int)(next_random(&rng) % 3), text)) goto fail;
+        }
+        for (int k = 0; k < spec->issues_per_mentee; ++k) {
+            format_day((int)(next_random(&rng) % 300), date, sizeof(date));
+            random_text(&rng, text, sizeof(text), 40 + next_random(&rng) % 200);
+            Issue* issue = add_issue(data, mentee->id, mentee->name, text, date, (IssuePriority)(next_random(&rng) % ISSUE_PRIORITY_COUNT));
+            if (!issue) goto fail;
+            unsigned int roll = next_random(&rng) % 10; // 50% open, 30% in progress, 20% resolved
+            if (roll >= 5) {
+                random_text(&rng, text, sizeof(text), 30 + next_random(&rng) % 150);
+                update_issue_status(data, issue, roll >= 8 ? STATUS_RESOLVED : STATUS_IN_PROGRESS, text);
+            }
+        }
+    }
+    return data;
+
+fail:
+    free_app_data(data);
+    return NULL;
+}
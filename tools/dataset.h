@@ -0,0 +1,28 @@
+#ifndef TOOLS_DATASET_H
+#define TOOLS_DATASET_H
+
+#include "mentorship_data.h"
+
+// Shape of a generated dataset; per-mentee counts scale everything with 'mentees'
+typedef struct {
+    int mentees;
+    int mentors;                // Mentor accounts besides admin
+    int meetings_per_mentee;
+    int issues_per_mentee;
+    int notes_per_mentee;
+    unsigned int seed;          // Same seed and counts give the same dataset
+} DatasetSpec;
+
+/**
+ * @brief Fills 'spec' with the default mix for 'mentees' mentees.
+ */
+void dataset_default_spec(DatasetSpec* spec, int mentees);
+
+/**
+ * @brief Builds an AppData through the normal data-layer calls, so it saves
+ * in whatever format save_data_to_file() writes. Includes the admin/user
+ * logins the dashboards and tools/loadgen expect. Returns NULL on failure.
+ */
+AppData* generate_dataset(const DatasetSpec* spec);
+
+#endif // TOOLS_DATASET_H
@@ -0,0 +1,77 @@
+/**
+ * Synthetic dataset generator (make dataset).
+ *
+ * Writes a data file that mentor_backend loads like its own, with realistic
+ * names and text lengths, so startup and persistence can be tested at scale.
+ *
+ * Usage: gen_dataset --mentees N [--mentors N] [--meetings-per-mentee K]
+ *                    [--issues-per-mentee K] [--notes-per-mentee K]
+ *                    [--seed S] [--out FILE]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "dataset.h"
+#include "logger.h"
+#include "metrics.h"
+
+#define DEFAULT_OUT "generated_data.json"
+#define SEED_DATA_FILE "mentorship_data.json" // Tracked seed data; never overwritten
+
+int main(int argc, char* argv[]) {
+    DatasetSpec spec;
+    dataset_default_spec(&spec, 1000);
+    const char* out_path = DEFAULT_OUT;
+    int mentors_given = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) goto usage;
+        if (0 == strcmp(argv[i], "--mentees")) spec.mentees = atoi(value);
+        else if (0 == strcmp(argv[i], "--mentors")) { spec.mentors = atoi(value); mentors_given = 1; }
+        else if (0 == strcmp(argv[i], "--meetings-per-mentee")) spec.meetings_per_mentee = atoi(value);
+        else if (0 == strcmp(argv[i], "--issues-per-mentee")) spec.issues_per_mentee = atoi(value);
+        else if (0 == strcmp(argv[i], "--notes-per-mentee")) spec.notes_per_mentee = atoi(value);
+        else if (0 == strcmp(argv[i], "--seed")) spec.seed = (unsigned int)strtoul(value, NULL, 10);
+        else if (0 == strcmp(argv[i], "--out")) out_path = value;
+        else goto usage;
+        i++;
+    }
+    if (!mentors_given) spec.mentors = spec.mentees / 50 > 0 ? spec.mentees / 50 : 1;
+    if (spec.mentees <= 0 || spec.mentors < 0 || spec.meetings_per_mentee < 0 || spec.issues_per_mentee < 0 || spec.notes_per_mentee < 0) goto usage;
+    const char* out_name = strrchr(out_path, '/') ? strrchr(out_path, '/') + 1 : out_path;
+    if (0 == strcmp(out_name, SEED_DATA_FILE)) {
+        fprintf(stderr, "gen_dataset: refusing to overwrite the seed data file %s; use the default %s\n", out_path, DEFAULT_OUT);
+        return 2;
+    }
+
+    log_set_level(LOG_LEVEL_WARN);
+    uint64_t start = metrics_now_ns();
+    AppData* data = generate_dataset(&spec);
+    if (!data) {
+        fprintf(stderr, "gen_dataset: failed to generate %d mentees\n", spec.mentees);
+        return 1;
+    }
+    uint64_t generated = metrics_now_ns();
+    int saved = save_data_to_file(data, out_path);
+    uint64_t done = metrics_now_ns();
+    free_app_data(data);
+    if (!saved) {
+        fprintf(stderr, "gen_dataset: failed to write %s\n", out_path);
+        return 1;
+    }
+
+    struct stat st;
+    long long bytes = stat(out_path, &st) == 0 ? (long long)st.st_size : -1;
+    printf("Wrote %s: %d mentees, %d mentors, %d meetings, %d issues, %d notes (%lld bytes)\n",
+           out_path, spec.mentees, spec.mentors + 1, spec.mentees * spec.meetings_per_mentee,
+           spec.mentees * spec.issues_per_mentee, spec.mentees * spec.notes_per_mentee, bytes);
+    printf("Generated in %.1f ms, saved in %.1f ms\n", (generated - start) / 1e6, (done - generated) / 1e6);
+    return 0;
+
+usage:
+    fprintf(stderr, "Usage: %s --mentees N [--mentors N] [--meetings-per-mentee K] [--issues-per-mentee K]\n"
+                    "          [--notes-per-mentee K] [--seed S] [--out FILE]\n", argv[0]);
+    return 2;
+}
@@ -0,0 +1,169 @@
+#define _GNU_SOURCE // For strcasestr
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/tcp.h>
+#include "http_client.h"
+
+void http_conn_init(HttpConn* conn, const struct sockaddr_in* addr) {
+    memset(conn, 0, sizeof(*conn));
+    conn->fd = -1;
+    conn->addr = *addr;
+}
+
+static int http_connect(HttpConn* conn) {
+    conn->pos = conn->len = 0;
+    conn->fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (conn->fd < 0) return 0;
+    int one = 1;
+    setsockopt(conn->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(conn->fd, (struct sockaddr*)&conn->addr, sizeof(conn->addr)) != 0) {
+        close(conn->fd);
+        conn->fd = -1;
+        return 0;
+    }
+    return 1;
+}
+
+void http_close(HttpConn* conn) {
+    if (conn->fd >= 0) close(conn->fd);
+    conn->fd = -1;
+}
+
+static int send_all(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return 0;
+        data += n;
+        len -= (size_t)n;
+    }
+    return 1;
+}
+
+static int conn_fill(HttpConn* conn) {
+    if (conn->pos > 0 && conn->pos == conn->len) conn->pos = conn->len = 0;
+    if (conn->len == sizeof(conn->buf)) {
+        memmove(conn->buf, conn->buf + conn->pos, conn->len - conn->pos);
+        conn->len -= conn->pos;
+        conn->pos = 0;
+    }
+    ssize_t n;
+    do {
+        n = recv(conn->fd, conn->buf + conn->len, sizeof(conn->buf) - conn->len, 0);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) return 0;
+    conn->len += (size_t)n;
+    return 1;
+}
+
+/**
+ * @brief Reads one CRLF-terminated line (without the CRLF) into 'line'.
+ */
+static int conn_read_line(HttpConn* conn, char* line, size_t cap) {
+    size_t out = 0;
+    for (;;) {
+        while (conn->pos < conn->len) {
+            char c = conn->buf[conn->pos++];
+            if (c == '\n') {
+                if (out > 0 && line[out - 1] == '\r') out--;
+                line[out] = '\0';
+                return 1;
+            }
+            if (out + 1 < cap) line[out++] = c;
+        }
+        if (!conn_fill(conn)) return 0;
+    }
+}
+
+static int response_reserve(HttpResponse* resp, size_t extra) {
+    if (resp->body_len + extra + 1 <= resp->body_cap) return 1;
+    size_t cap = resp->body_cap ? resp->body_cap : 4096;
+    while (cap < resp->body_len + extra + 1) cap *= 2;
+    char* grown = realloc(resp->body, cap);
+    if (!grown) return 0;
+    resp->body = grown;
+    resp->body_cap = cap;
+    return 1;
+}
+
+static int conn_read_body(HttpConn* conn, HttpResponse* resp, size_t n) {
+    if (!response_reserve(resp, n)) return 0;
+    while (n > 0) {
+        if (conn->pos == conn->len && !conn_fill(conn)) return 0;
+        size_t take = conn->len - conn->pos < n ? conn->len - conn->pos : n;
+        memcpy(resp->body + resp->body_len, conn->buf + conn->pos, take);
+        resp->body_len += take;
+        conn->pos += take;
+        n -= take;
+    }
+    return 1;
+}
+
+static int read_response(HttpConn* conn, HttpResponse* resp) {
+    char line[1024];
+    resp->status = 0;
+    resp->body_len = 0;
+    resp->close_after = 0;
+    if (!conn_read_line(conn, line, sizeof(line))) return 0;
+    if (sscanf(line, "HTTP/%*d.%*d %d", &resp->status) != 1) return 0;
+
+    long long content_length = -1;
+    int chunked = 0;
+    while (conn_read_line(conn, line, sizeof(line))) {
+        if (line[0] == '\0') break;
+        char* value = strchr(line, ':');
+        if (!value) continue;
+        *value++ = '\0';
+        while (*value == ' ') value++;
+        if (strcasecmp(line, "Content-Length") == 0) content_length = atoll(value);
+        else if (strcasecmp(line, "Transfer-Encoding") == 0 && strcasestr(value, "chunked")) chunked = 1;
+        else if (strcasecmp(line, "Connection") == 0 && strcasecmp(value, "close") == 0) resp->close_after = 1;
+    }
+
+    if (chunked) {
+        for (;;) {
+            if (!conn_read_line(conn, line, sizeof(line))) return 0;
+            size_t size = (size_t)strtoull(line, NULL, 16);
+            if (size == 0) break;
+            if (!conn_read_body(conn, resp, size) || !conn_read_line(conn, line, sizeof(line))) return 0;
+        }
+        while (conn_read_line(conn, line, sizeof(line)) && line[0] != '\0') {} // Trailers
+    } else if (content_length >= 0) {
+        if (!conn_read_body(conn, resp, (size_t)content_length)) return 0;
+    } else {
+        while (conn->pos < conn->len || conn_fill(conn)) {
+            if (!conn_read_body(conn, resp, conn->len - conn->pos)) return 0;
+        }
+        resp->close_after = 1;
+    }
+    if (!response_reserve(resp, 0)) return 0;
+    resp->body[resp->body_len] = '\0';
+    return 1;
+}
+
+int http_request(HttpConn* conn, const char* method, const char* path, const char* auth, const char* body, HttpResponse* resp) {
+    char head[1024];
+    size_t body_len = body ? strlen(body) : 0;
+    int head_len = snprintf(head, sizeof(head),
+                            "%s %s HTTP/1.1\r\nHost: localhost\r\nConnection: keep-alive\r\n"
+                            "%s%s%s"
+                            "Content-Type: application/json\r\nContent-Length: %zu\r\n\r\n",
+                            method, path, auth ? AUTH_HEADER ": " AUTH_SCHEME : "", auth ? auth : "", auth ? "\r\n" : "", body_len);
+    if (head_len < 0 || (size_t)head_len >= sizeof(head)) return 0;
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (conn->fd < 0 && !http_connect(conn)) return 0;
+        if (send_all(conn->fd, head, (size_t)head_len) && (!body_len || send_all(conn->fd, body, body_len)) &&
+            read_response(conn, resp)) {
+            if (resp->close_after) http_close(conn);
+            return 1;
+        }
+        http_close(conn);
+    }
+    return 0;
+}
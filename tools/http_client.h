@@ -0,0 +1,43 @@
+#ifndef TOOLS_HTTP_CLIENT_H
+#define TOOLS_HTTP_CLIENT_H
+
+#include <stddef.h>
+#include <netinet/in.h>
+
+#define AUTH_HEADER "Authorization"  // Must match api_handler.c
+#define AUTH_SCHEME "Bearer "
+#define AUTH_TOKEN_SIZE 65           // Hex session token plus NUL (session.h)
+#define HTTP_READ_BUFFER_SIZE 16384
+
+// Minimal HTTP/1.1 keep-alive client for the tools that talk to mentor_backend
+typedef struct {
+    int fd;                         // -1 while disconnected
+    struct sockaddr_in addr;
+    char buf[HTTP_READ_BUFFER_SIZE];
+    size_t pos;                     // Next unread byte in buf
+    size_t len;                     // Bytes valid in buf
+} HttpConn;
+
+typedef struct {
+    int status;
+    char* body;                     // NUL-terminated, reused between requests; free() when done
+    size_t body_len;
+    size_t body_cap;
+    int close_after;                // Server sent Connection: close
+} HttpResponse;
+
+/**
+ * @brief Prepares a disconnected connection to 'addr'; http_request connects lazily.
+ */
+void http_conn_init(HttpConn* conn, const struct sockaddr_in* addr);
+void http_close(HttpConn* conn);
+
+/**
+ * @brief Sends one request (JSON body optional, 'auth' is a session
+ * token sent as a bearer credential) and
+ * reads the response, reconnecting once if the kept-alive connection was closed
+ * by the server in the meantime. Returns 0 on transport errors.
+ */
+int http_request(HttpConn* conn, const char* method, const char* path, const char* auth, const char* body, HttpResponse* resp);
+
+#endif // TOOLS_HTTP_CLIENT_H
@@ -0,0 +1,561 @@
+/**
+ * Localhost load generator (make loadgen).
+ *
+ * Drives a running mentor_backend the way the dashboards do: every worker
+ * logs in once over a keep-alive connection, then polls the notification and
+ * list endpoints (mentor) or the /api/mentee/me/ pages (mentee) with a share of
+ * POST/PATCH/DELETE traffic mixed in. Traffic can be recorded to a JSONL file
+ * and replayed later. Reports throughput and p50/p99/p999 latency per endpoint.
+ *
+ * Only loopback addresses are accepted; this is not a tool for remote hosts.
+ *
+ * Usage: loadgen [--port 8080] [--concurrency 8] [--duration 10] [--requests N]
+ *                [--mentee-share 0.3] [--write-share 0.1]
+ *                [--record FILE | --replay FILE] [--out FILE]
+ */
+#define _POSIX_C_SOURCE 200809L // For clock_gettime, strdup
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <cjson/cJSON.h>
+#include "http_client.h"
+
+#define MAX_ENDPOINTS 64
+#define REMEMBERED_IDS 32           // Created records each worker may PATCH/DELETE later
+
+typedef enum { ROLE_MENTOR_WORKER, ROLE_MENTEE_WORKER } WorkerRole;
+
+static const char* const role_names[] = { "mentor", "mentee" };
+
+// ========================================================================== //
+//                                 OPTIONS                                    //
+// ========================================================================== //
+
+static struct {
+    struct sockaddr_in addr;
+    int concurrency;
+    double duration_s;
+    long long max_requests;         // 0 = run for duration_s
+    double mentee_share;            // Fraction of workers acting as mentees
+    double write_share;             // Fraction of requests that modify data
+    const char* mentor_user;
+    const char* mentee_user;
+    const char* password;
+    const char* record_path;
+    const char* replay_path;
+    const char* out_path;
+} options = {
+    .concurrency = 8, .duration_s = 10.0, .mentee_share = 0.3, .write_share = 0.1,
+    .mentor_user = "admin", .mentee_user = "user", .password = "password",
+};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// ========================================================================== //
+//                           LATENCY STATISTICS                               //
+// ========================================================================== //
+
+typedef struct {
+    char label[96];                 // "GET /api/issues/{id}"
+    uint64_t* samples;              // Latencies in ns
+    size_t count;
+    size_t cap;
+    unsigned long long errors;      // Non-2xx responses
+    unsigned long long failures;    // No response at all
+} EndpointStats;
+
+typedef struct {
+    EndpointStats endpoints[MAX_ENDPOINTS];
+    int endpoint_count;
+} StatsTable;
+
+/**
+ * @brief Endpoint label: query string dropped, numeric path segments as {id}.
+ */
+static void endpoint_label(const char* method, const char* path, char* out, size_t cap) {
+    size_t len = (size_t)snprintf(out, cap, "%s ", method);
+    const char* p = path;
+    while (*p && *p != '?' && len + 5 < cap) {
+        if (p > path && p[-1] == '/' && isdigit((unsigned char)*p)) {
+            const char* end = p;
+            while (isdigit((unsigned char)*end)) end++;
+            if (*end == '\0' || *end == '/' || *end == '?') {
+                memcpy(out + len, "{id}", 4);
+                len += 4;
+                p = end;
+                continue;
+            }
+        }
+        out[len++] = *p++;
+    }
+    out[len] = '\0';
+}
+
+static EndpointStats* stats_for(StatsTable* table, const char* label) {
+    for (int i = 0; i < table->endpoint_count; ++i) {
+        if (0 == strcmp(table->endpoints[i].label, label)) return &table->endpoints[i];
+    }
+    if (table->endpoint_count == MAX_ENDPOINTS) return NULL;
+    EndpointStats* stats = &table->endpoints[table->endpoint_count++];
+    memset(stats, 0, sizeof(*stats));
+    snprintf(stats->label, sizeof(stats->label), "%s", label);
+    return stats;
+}
+
+static void stats_add_sample(EndpointStats* stats, uint64_t ns) {
+    if (stats->count == stats->cap) {
+        size_t cap = stats->cap ? stats->cap * 2 : 1024;
+        uint64_t* grown = realloc(stats->samples, cap * sizeof(uint64_t));
+        if (!grown) return;
+        stats->samples = grown;
+        stats->cap = cap;
+    }
+    stats->samples[stats->count++] = ns;
+}
+
+static void stats_merge(StatsTable* into, const StatsTable* from) {
+    for (int i = 0; i < from->endpoint_count; ++i) {
+        const EndpointStats* src = &from->endpoints[i];
+        EndpointStats* dst = stats_for(into, src->label);
+        if (!dst) continue;
+        for (size_t k = 0; k < src->count; ++k) stats_add_sample(dst, src->samples[k]);
+        dst->errors += src->errors;
+        dst->failures += src->failures;
+    }
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile_ms(const EndpointStats* stats, double q) {
+    if (stats->count == 0) return 0.0;
+    size_t rank = (size_t)(q * (double)stats->count + 0.999999);
+    if (rank == 0) rank = 1;
+    if (rank > stats->count) rank = stats->count;
+    return (double)stats->samples[rank - 1] / 1e6;
+}
+
+// ========================================================================== //
+//                            RECORD / REPLAY                                 //
+// ========================================================================== //
+
+typedef struct {
+    char* method;
+    char* path;
+    char* body;                     // NULL for requests without a body
+    WorkerRole role;
+} ReplayEntry;
+
+static FILE* record_file = NULL;
+static pthread_mutex_t record_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t run_start_ns = 0;
+
+static ReplayEntry* replay_entries = NULL;
+static size_t replay_count = 0;
+static size_t replay_next = 0;      // Shared cursor, taken with __atomic_fetch_add
+
+static void record_request(int worker, WorkerRole role, const char* method, const char* path, const char* body) {
+    if (!record_file) return;
+    cJSON* entry = cJSON_CreateObject();
+    if (!entry) return;
+    cJSON_AddNumberToObject(entry, "at_ms", (double)(now_ns() - run_start_ns) / 1e6);
+    cJSON_AddNumberToObject(entry, "worker", worker);
+    cJSON_AddStringToObject(entry, "role", role_names[role]);
+    cJSON_AddStringToObject(entry, "method", method);
+    cJSON_AddStringToObject(entry, "path", path);
+    if (body) cJSON_AddStringToObject(entry, "body", body);
+    char* line = cJSON_PrintUnformatted(entry);
+    cJSON_Delete(entry);
+    if (!line) return;
+    pthread_mutex_lock(&record_lock);
+    fprintf(record_file, "%s\n", line);
+    pthread_mutex_unlock(&record_lock);
+    cJSON_free(line);
+}
+
+static int load_replay(const char* path) {
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        perror("loadgen: cannot open replay file");
+        return 0;
+    }
+    size_t cap = 0;
+    char* line = NULL;
+    size_t line_cap = 0;
+    ssize_t n;
+    while ((n = getline(&line, &line_cap, fp)) > 0) {
+        cJSON* entry = cJSON_Parse(line);
+        const char* method = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(entry, "method"));
+        const char* req_path = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(entry, "path"));
+        const char* body = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(entry, "body"));
+        const char* role = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(entry, "role"));
+        if (method && req_path) {
+            if (replay_count == cap) {
+                cap = cap ? cap * 2 : 1024;
+                ReplayEntry* grown = realloc(replay_entries, cap * sizeof(ReplayEntry));
+                if (!grown) { cJSON_Delete(entry); break; }
+                replay_entries = grown;
+            }
+            ReplayEntry* e = &replay_entries[replay_count++];
+            e->method = strdup(method);
+            e->path = strdup(req_path);
+            e->body = body ? strdup(body) : NULL;
+            e->role = (role && 0 == strcmp(role, "mentee")) ? ROLE_MENTEE_WORKER : ROLE_MENTOR_WORKER;
+        }
+        cJSON_Delete(entry);
+    }
+    free(line);
+    fclose(fp);
+    printf("Loaded %zu requests from %s\n", replay_count, path);
+    return replay_count > 0;
+}
+
+// ========================================================================== //
+//                                 WORKERS                                    //
+// ========================================================================== //
+
+typedef struct {
+    int index;
+    WorkerRole role;
+    HttpConn conn;
+    HttpResponse resp;
+    char auth[2][AUTH_TOKEN_SIZE];  // Session token per role; empty if that login failed
+    unsigned int rng;
+    int seq;
+    char mentee_name[64];           // Mentee this mentor worker books meetings for
+    int meeting_ids[REMEMBERED_IDS];
+    int meeting_count;
+    int issue_ids[REMEMBERED_IDS];
+    int issue_count;
+    StatsTable stats;
+} Worker;
+
+static long long requests_issued = 0;
+static uint64_t deadline_ns = 0;
+
+static unsigned int next_random(Worker* w) {
+    unsigned int x = w->rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    w->rng = x;
+    return x;
+}
+
+static double random_unit(Worker* w) {
+    return (double)(next_random(w) & 0xFFFFFF) / (double)0x1000000;
+}
+
+/**
+ * @brief Issues one timed request and records it. Returns the HTTP status,
+ * or 0 if no response arrived.
+ */
+static int timed_request(Worker* w, WorkerRole role, const char* method, const char* path, const char* body) {
+    char label[96];
+    endpoint_label(method, path, label, sizeof(label));
+    EndpointStats* stats = stats_for(&w->stats, label);
+    record_request(w->index, role, method, path, body);
+
+    const char* auth = w->auth[role][0] ? w->auth[role] : NULL;
+    uint64_t start = now_ns();
+    int ok = http_request(&w->conn, method, path, auth, body, &w->resp);
+    uint64_t elapsed = now_ns() - start;
+    if (!stats) return ok ? w->resp.status : 0;
+    if (!ok) {
+        stats->failures++;
+        return 0;
+    }
+    stats_add_sample(stats, elapsed);
+    if (w->resp.status < 200 || w->resp.status >= 300) stats->errors++;
+    return w->resp.status;
+}
+
+static int response_id(const HttpResponse* resp, const char* key) {
+    cJSON* root = cJSON_ParseWithLength(resp->body, resp->body_len);
+    const cJSON* id = cJSON_GetObjectItemCaseSensitive(root, key);
+    int value = cJSON_IsNumber(id) ? id->valueint : 0;
+    cJSON_Delete(root);
+    return value;
+}
+
+static void login(Worker* w, WorkerRole role) {
+    char body[256];
+    snprintf(body, sizeof(body), "{\"username\":\"%s\",\"password\":\"%s\",\"role\":\"%s\"}",
+             role == ROLE_MENTOR_WORKER ? options.mentor_user : options.mentee_user, options.password, role_names[role]);
+    w->auth[role][0] = '\0';
+    if (timed_request(w, role, "POST", "/api/login", body) == 200) {
+        cJSON* root = cJSON_ParseWithLength(w->resp.body, w->resp.body_len);
+        const cJSON* token = cJSON_GetObjectItemCaseSensitive(root, "token");
+        if (cJSON_IsString(token)) snprintf(w->auth[role], sizeof(w->auth[role]), "%s", token->valuestring);
+        cJSON_Delete(root);
+    }
+    if (!w->auth[role][0]) fprintf(stderr, "worker %d: %s login failed (status %d)\n", w->index, role_names[role], w->resp.status);
+}
+
+static void remember_id(int* ids, int* count, int id) {
+    if (id <= 0) return;
+    if (*count < REMEMBERED_IDS) ids[(*count)++] = id;
+    else ids[id % REMEMBERED_IDS] = id;
+}
+
+static int take_id(Worker* w, int* ids, int* count) {
+    if (*count == 0) return 0;
+    int slot = (int)(next_random(w) % (unsigned int)*count);
+    int id = ids[slot];
+    ids[slot] = ids[--(*count)];
+    return id;
+}
+
+static void random_slot(Worker* w, char* date, size_t date_cap, char* clock, size_t clock_cap) {
+    // Next year, so generated meetings never land in the past
+    snprintf(date, date_cap, "2027-%02u-%02u", 1 + next_random(w) % 12, 1 + next_random(w) % 28);
+    snprintf(clock, clock_cap, "%02u:%02u", 8 + next_random(w) % 10, (next_random(w) % 4) * 15);
+}
+
+static void mentor_write(Worker* w) {
+    char path[64], body[512], date[16], clock[8];
+    switch (next_random(w) % 6) {
+    case 0: // New mentee
+        snprintf(body, sizeof(body), "{\"name\":\"Load Mentee %d-%d-%d\",\"subject\":\"Physics\",\"email\":\"load@example.com\"}",
+                 (int)getpid(), w->index, ++w->seq);
+        timed_request(w, ROLE_MENTOR_WORKER, "POST", "/api/mentees", body);
+        break;
+    case 1: // Book a meeting
+        random_slot(w, date, sizeof(date), clock, sizeof(clock));
+        snprintf(body, sizeof(body), "{\"mentee\":\"%s\",\"date\":\"%s\",\"time\":\"%s\",\"duration\":30,\"notes\":\"Load test session\",\"allow_conflict\":true}",
+                 w->mentee_name, date, clock);
+        if (timed_request(w, ROLE_MENTOR_WORKER, "POST", "/api/meetings", body) == 201) {
+            remember_id(w->meeting_ids, &w->meeting_count, response_id(&w->resp, "id"));
+        }
+        break;
+    case 2: // Reschedule
+        if (w->meeting_count == 0) { mentor_write(w); return; } // Nothing to act on yet
+        random_slot(w, date, sizeof(date), clock, sizeof(clock));
+        snprintf(path, sizeof(path), "/api/meetings/%d", w->meeting_ids[next_random(w) % (unsigned int)w->meeting_count]);
+        snprintf(body, sizeof(body), "{\"date\":\"%s\",\"time\":\"%s\"}", date, clock);
+        timed_request(w, ROLE_MENTOR_WORKER, "PATCH", path, body);
+        break;
+    case 3: // Cancel
+        if (w->meeting_count == 0) { mentor_write(w); return; } // Nothing to act on yet
+        snprintf(path, sizeof(path), "/api/meetings/%d", take_id(w, w->meeting_ids, &w->meeting_count));
+        timed_request(w, ROLE_MENTOR_WORKER, "DELETE", path, NULL);
+        break;
+    case 4: // Report an issue
+        snprintf(body, sizeof(body), "{\"mentee\":\"%s\",\"description\":\"Load test issue %d\",\"priority\":\"%s\",\"date\":\"2026-10-18\"}",
+                 w->mentee_name, ++w->seq, (next_random(w) & 1) ? "High" : "Medium");
+        if (timed_request(w, ROLE_MENTOR_WORKER, "POST", "/api/issues", body) == 201) {
+            remember_id(w->issue_ids, &w->issue_count, response_id(&w->resp, "id"));
+        }
+        break;
+    default: // Move an issue along
+        if (w->issue_count == 0) { mentor_write(w); return; } // Nothing to act on yet
+        snprintf(path, sizeof(path), "/api/issues/%d", w->issue_ids[next_random(w) % (unsigned int)w->issue_count]);
+        snprintf(body, sizeof(body), "{\"status\":\"%s\",\"notes\":\"Followed up during load test\"}",
+                 (next_random(w) & 1) ? "In Progress" : "Resolved");
+        timed_request(w, ROLE_MENTOR_WORKER, "PATCH", path, body);
+        break;
+    }
+}
+
+// Dashboard polling mix; repeated entries weight the frequent ones
+static const char* const mentor_polls[] = {
+    "/api/notifications", "/api/notifications", "/api/notifications",
+    "/api/mentees", "/api/mentees", "/api/meetings", "/api/meetings", "/api/issues", "/api/issues",
+    "/api/issues?status=Open", "/api/mentees/suggest?prefix=lo", "/api/search?q=load",
+};
+static const char* const mentee_polls[] = {
+    "/api/mentee/me/notifications", "/api/mentee/me/notifications", "/api/mentee/me/details",
+    "/api/mentee/me/meetings", "/api/mentee/me/issues", "/api/mentee/me/mentor", "/api/mentee/me/notes",
+};
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+static void generated_request(Worker* w) {
+    int write = random_unit(w) < options.write_share;
+    if (w->role == ROLE_MENTOR_WORKER) {
+        if (write) mentor_write(w);
+        else timed_request(w, w->role, "GET", mentor_polls[next_random(w) % COUNT_OF(mentor_polls)], NULL);
+    } else if (write) {
+        char body[256];
+        snprintf(body, sizeof(body), "{\"description\":\"Load test question %d\",\"priority\":\"Low\",\"date\":\"2026-10-18\"}", ++w->seq);
+        timed_request(w, w->role, "POST", "/api/mentee/me/issues", body);
+    } else {
+        timed_request(w, w->role, "GET", mentee_polls[next_random(w) % COUNT_OF(mentee_polls)], NULL);
+    }
+}
+
+static int keep_running(void) {
+    long long issued = __atomic_add_fetch(&requests_issued, 1, __ATOMIC_RELAXED);
+    if (options.max_requests > 0) return issued <= options.max_requests;
+    return now_ns() < deadline_ns;
+}
+
+static void* worker_main(void* arg) {
+    Worker* w = arg;
+    http_conn_init(&w->conn, &options.addr);
+
+    if (replay_entries) {
+        // Replayed traffic may use either role, so log in as both
+        login(w, ROLE_MENTOR_WORKER);
+        login(w, ROLE_MENTEE_WORKER);
+        while (keep_running()) {
+            size_t i = __atomic_fetch_add(&replay_next, 1, __ATOMIC_RELAXED);
+            if (i >= replay_count) break;
+            const ReplayEntry* e = &replay_entries[i];
+            timed_request(w, e->role, e->method, e->path, e->body);
+        }
+    } else {
+        login(w, w->role);
+        if (w->role == ROLE_MENTOR_WORKER) {
+            // Own mentee, so meetings and issues have a valid target
+            char body[256];
+            snprintf(w->mentee_name, sizeof(w->mentee_name), "Load Mentee %d-%d", (int)getpid(), w->index);
+            snprintf(body, sizeof(body), "{\"name\":\"%s\",\"subject\":\"Mathematics\",\"email\":\"load@example.com\"}", w->mentee_name);
+            timed_request(w, w->role, "POST", "/api/mentees", body);
+        }
+        while (keep_running()) generated_request(w);
+    }
+    http_close(&w->conn);
+    return NULL;
+}
+
+// ========================================================================== //
+//                                  MAIN                                      //
+// ========================================================================== //
+
+static int parse_host(const char* host) {
+    memset(&options.addr, 0, sizeof(options.addr));
+    options.addr.sin_family = AF_INET;
+    if (0 == strcmp(host, "localhost")) host = "127.0.0.1";
+    if (inet_pton(AF_INET, host, &options.addr.sin_addr) != 1) return 0;
+    return (ntohl(options.addr.sin_addr.s_addr) >> 24) == 127; // Loopback only
+}
+
+static void usage(const char* prog) {
+    fprintf(stderr,
+            "Usage: %s [--host 127.0.0.1] [--port 8080] [--concurrency N] [--duration SECONDS]\n"
+            "          [--requests N] [--mentee-share 0..1] [--write-share 0..1]\n"
+            "          [--mentor-user NAME] [--mentee-user NAME] [--password PASS]\n"
+            "          [--record FILE | --replay FILE] [--out FILE]\n", prog);
+}
+
+static void report(const StatsTable* total, double elapsed_s) {
+    unsigned long long all = 0;
+    printf("%-40s %9s %7s %9s %9s %9s %9s %9s\n", "endpoint", "requests", "errors", "req/s", "p50 ms", "p99 ms", "p999 ms", "max ms");
+    for (int i = 0; i < total->endpoint_count; ++i) {
+        const EndpointStats* s = &total->endpoints[i];
+        all += s->count;
+        printf("%-40s %9zu %7llu %9.1f %9.3f %9.3f %9.3f %9.3f\n", s->label, s->count, s->errors + s->failures,
+               (double)s->count / elapsed_s, percentile_ms(s, 0.50), percentile_ms(s, 0.99), percentile_ms(s, 0.999),
+               s->count ? (double)s->samples[s->count - 1] / 1e6 : 0.0);
+    }
+    printf("Total: %llu requests in %.2fs = %.1f req/s with %d connections\n", all, elapsed_s, (double)all / elapsed_s, options.concurrency);
+
+    if (!options.out_path) return;
+    FILE* out = fopen(options.out_path, "a");
+    if (!out) {
+        perror("loadgen: cannot open results file");
+        return;
+    }
+    for (int i = 0; i < total->endpoint_count; ++i) {
+        const EndpointStats* s = &total->endpoints[i];
+        fprintf(out, "{\"endpoint\":\"%s\",\"concurrency\":%d,\"requests\":%zu,\"errors\":%llu,\"rps\":%.1f,"
+                     "\"p50_ms\":%.3f,\"p99_ms\":%.3f,\"p999_ms\":%.3f,\"timestamp\":%ld}\n",
+                s->label, options.concurrency, s->count, s->errors + s->failures, (double)s->count / elapsed_s,
+                percentile_ms(s, 0.50), percentile_ms(s, 0.99), percentile_ms(s, 0.999), (long)time(NULL));
+    }
+    fclose(out);
+    printf("Results appended to %s\n", options.out_path);
+}
+
+int main(int argc, char* argv[]) {
+    const char* host = "127.0.0.1";
+    int port = 8080;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) { usage(argv[0]); return 2; }
+        if (0 == strcmp(arg, "--host")) host = value;
+        else if (0 == strcmp(arg, "--port")) port = atoi(value);
+        else if (0 == strcmp(arg, "--concurrency")) options.concurrency = atoi(value);
+        else if (0 == strcmp(arg, "--duration")) options.duration_s = atof(value);
+        else if (0 == strcmp(arg, "--requests")) options.max_requests = atoll(value);
+        else if (0 == strcmp(arg, "--mentee-share")) options.mentee_share = atof(value);
+        else if (0 == strcmp(arg, "--write-share")) options.write_share = atof(value);
+        else if (0 == strcmp(arg, "--mentor-user")) options.mentor_user = value;
+        else if (0 == strcmp(arg, "--mentee-user")) options.mentee_user = value;
+        else if (0 == strcmp(arg, "--password")) options.password = value;
+        else if (0 == strcmp(arg, "--record")) options.record_path = value;
+        else if (0 == strcmp(arg, "--replay")) options.replay_path = value;
+        else if (0 == strcmp(arg, "--out")) options.out_path = value;
+        else { usage(argv[0]); return 2; }
+        i++;
+    }
+    if (!parse_host(host)) {
+        fprintf(stderr, "loadgen: '%s' is not a loopback IPv4 address\n", host);
+        return 2;
+    }
+    options.addr.sin_port = htons((uint16_t)port);
+    if (options.concurrency <= 0 || port <= 0 || port > 65535 || (options.record_path && options.replay_path)) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (options.replay_path && !load_replay(options.replay_path)) return 1;
+    if (options.record_path && !(record_file = fopen(options.record_path, "w"))) {
+        perror("loadgen: cannot open record file");
+        return 1;
+    }
+
+    Worker* workers = calloc((size_t)options.concurrency, sizeof(Worker));
+    pthread_t* threads = calloc((size_t)options.concurrency, sizeof(pthread_t));
+    if (!workers || !threads) return 1;
+
+    int mentee_workers = (int)(options.mentee_share * options.concurrency + 0.5);
+    run_start_ns = now_ns();
+    deadline_ns = run_start_ns + (uint64_t)(options.duration_s * 1e9);
+    for (int i = 0; i < options.concurrency; ++i) {
+        workers[i].index = i;
+        workers[i].role = i < mentee_workers ? ROLE_MENTEE_WORKER : ROLE_MENTOR_WORKER;
+        workers[i].rng = 0x9E3779B9u ^ (unsigned int)(i * 2654435761u) ^ (unsigned int)getpid();
+        if (pthread_create(&threads[i], NULL, worker_main, &workers[i]) != 0) {
+            fprintf(stderr, "loadgen: failed to start worker %d\n", i);
+            options.concurrency = i;
+            break;
+        }
+    }
+    for (int i = 0; i < options.concurrency; ++i) pthread_join(threads[i], NULL);
+    double elapsed_s = (double)(now_ns() - run_start_ns) / 1e9;
+
+    StatsTable total = { .endpoint_count = 0 };
+    for (int i = 0; i < options.concurrency; ++i) {
+        stats_merge(&total, &workers[i].stats);
+        for (int k = 0; k < workers[i].stats.endpoint_count; ++k) free(workers[i].stats.endpoints[k].samples);
+        free(workers[i].resp.body);
+    }
+    for (int i = 0; i < total.endpoint_count; ++i) {
+        if (total.endpoints[i].count > 0) qsort(total.endpoints[i].samples, total.endpoints[i].count, sizeof(uint64_t), compare_u64);
+    }
+    report(&total, elapsed_s > 0 ? elapsed_s : 1e-9);
+
+    for (int i = 0; i < total.endpoint_count; ++i) free(total.endpoints[i].samples);
+    for (size_t i = 0; i < replay_count; ++i) {
+        free(replay_entries[i].method);
+        free(replay_entries[i].path);
+        free(replay_entries[i].body);
+    }
+    free(replay_entries);
+    free(workers);
+    free(threads);
+    if (record_file) fclose(record_file);
+    return 0;
+}
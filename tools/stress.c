@@ -0,0 +1,439 @@
+/**
+ * Concurrency stress test for the handler layer (make stress / tsan / asan).
+ *
+ * Runs request_handler in-process on a libmicrohttpd daemon and drives it from
+ * many client threads with a randomized mix of reads and writes. All threads
+ * share one pool of mentees, meetings and issues, so they update and delete
+ * each other's records. While it runs, a checker thread validates the indexes
+ * against the lists (check_app_data_consistency); afterwards it checks that
+ * every created id was unique and that exactly the records whose DELETE
+ * succeeded are gone. Built with -fsanitize=thread or address,undefined this
+ * also catches data races and use-after-free in the handlers.
+ *
+ * Handlers save to mentorship_data.json in the working directory, so the test
+ * runs inside a scratch directory (--dir, default a fresh one under /tmp).
+ *
+ * Usage: stress [--threads 16] [--duration 10] [--port 18080] [--seed S]
+ *               [--dir DIR] [--log-level 4]
+ */
+#define _GNU_SOURCE // For mkdtemp
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <microhttpd.h>
+#include <cjson/cJSON.h>
+#include "mentorship_data.h"
+#include "api_handler.h"
+#include "session.h"
+#include "logger.h"
+#include "metrics.h"
+#include "http_client.h"
+
+#define MAX_THREADS 256
+#define POOL_CAPACITY 4096          // Live records the clients pick targets from
+#define CHECK_INTERVAL_US 50000
+#define STRESS_DATA_FILE "mentorship_data.json" // Where the handlers save (api_handler.c DATA_FILE)
+
+typedef enum { KIND_MENTEE, KIND_MEETING, KIND_ISSUE, KIND_COUNT } RecordKind;
+
+static const char* const kind_names[KIND_COUNT] = { "mentee", "meeting", "issue" };
+
+static struct {
+    int threads;
+    double duration_s;
+    int port;
+    unsigned int seed;
+    const char* dir;
+    int log_level;
+} options = { .threads = 16, .duration_s = 10.0, .port = 18080, .seed = 1, .log_level = LOG_LEVEL_OFF };
+
+static AppData* app_data = NULL;
+static struct sockaddr_in server_addr;
+static char mentor_token[SESSION_TOKEN_LENGTH + 1];
+static char mentee_token[SESSION_TOKEN_LENGTH + 1];
+static int stop_flag = 0;           // Accessed with __atomic builtins
+static int check_failed = 0;
+
+// ========================================================================== //
+//                               SHARED RECORDS                               //
+// ========================================================================== //
+
+typedef struct {
+    int id;
+    char name[64];                  // Mentees only; meetings and issues are booked by name
+} PoolEntry;
+
+// Records some client created and nobody has deleted yet. Every created and
+// deleted id is also logged so the final state can be checked exactly.
+typedef struct {
+    pthread_mutex_t lock;
+    PoolEntry live[POOL_CAPACITY];
+    int live_count;
+    int* created;
+    size_t created_count, created_cap;
+    int* deleted;
+    size_t deleted_count, deleted_cap;
+} RecordPool;
+
+static RecordPool pools[KIND_COUNT];
+
+static int append_id(int** ids, size_t* count, size_t* cap, int id) {
+    if (*count == *cap) {
+        size_t new_cap = *cap ? *cap * 2 : 1024;
+        int* grown = realloc(*ids, new_cap * sizeof(int));
+        if (!grown) return 0;
+        *ids = grown;
+        *cap = new_cap;
+    }
+    (*ids)[(*count)++] = id;
+    return 1;
+}
+
+static void pool_created(RecordKind kind, int id, const char* name) {
+    RecordPool* pool = &pools[kind];
+    pthread_mutex_lock(&pool->lock);
+    append_id(&pool->created, &pool->created_count, &pool->created_cap, id);
+    if (pool->live_count < POOL_CAPACITY) {
+        PoolEntry* entry = &pool->live[pool->live_count++];
+        entry->id = id;
+        snprintf(entry->name, sizeof(entry->name), "%s", name ? name : "");
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Copies a random live record into 'out'. Another thread may delete it
+ * before our request arrives; the handlers must cope with that (404).
+ */
+static int pool_pick(RecordKind kind, unsigned int roll, PoolEntry* out) {
+    RecordPool* pool = &pools[kind];
+    pthread_mutex_lock(&pool->lock);
+    int found = pool->live_count > 0;
+    if (found) *out = pool->live[roll % (unsigned int)pool->live_count];
+    pthread_mutex_unlock(&pool->lock);
+    return found;
+}
+
+static void pool_deleted(RecordKind kind, int id) {
+    RecordPool* pool = &pools[kind];
+    pthread_mutex_lock(&pool->lock);
+    append_id(&pool->deleted, &pool->deleted_count, &pool->deleted_cap, id);
+    for (int i = 0; i < pool->live_count; ++i) {
+        if (pool->live[i].id == id) {
+            pool->live[i] = pool->live[--pool->live_count];
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// ========================================================================== //
+//                                  CLIENTS                                   //
+// ========================================================================== //
+
+typedef struct {
+    int index;
+    pthread_t thread;
+    HttpConn conn;
+    HttpResponse resp;
+    unsigned int rng;
+    int seq;
+    long long requests;
+    long long server_errors;        // 5xx: a handler failed on valid input
+    long long transport_errors;     // Connection lost: the server probably crashed
+} Client;
+
+static unsigned int next_random(Client* c) {
+    unsigned int x = c->rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    c->rng = x;
+    return x;
+}
+
+static int request(Client* c, const char* method, const char* path, const char* token, const char* body) {
+    c->requests++;
+    if (!http_request(&c->conn, method, path, token, body, &c->resp)) {
+        c->transport_errors++;
+        return 0;
+    }
+    if (c->resp.status >= 500) {
+        c->server_errors++;
+        fprintf(stderr, "stress: %s %s -> %d %s\n", method, path, c->resp.status, c->resp.body);
+    }
+    return c->resp.status;
+}
+
+static int response_id(const HttpResponse* resp) {
+    cJSON* root = cJSON_Parse(resp->body);
+    const cJSON* id = cJSON_GetObjectItemCaseSensitive(root, "id");
+    int value = cJSON_IsNumber(id) ? id->valueint : 0;
+    cJSON_Delete(root);
+    return value;
+}
+
+static void random_slot(Client* c, char* date, size_t date_cap, char* clock, size_t clock_cap) {
+    snprintf(date, date_cap, "2027-%02u-%02u", 1 + next_random(c) % 12, 1 + next_random(c) % 28);
+    snprintf(clock, clock_cap, "%02u:%02u", 8 + next_random(c) % 10, (next_random(c) % 4) * 15);
+}
+
+static const char* const read_paths[] = {
+    "/api/mentees", "/api/meetings", "/api/issues", "/api/issues?status=Open", "/api/notifications",
+    "/api/mentees/suggest?prefix=st", "/api/search?q=stress", "/api/availability?from=2027-03-01&to=2027-03-08",
+    "/api/diagnostics", "/api/metrics",
+};
+static const char* const mentee_paths[] = {
+    "/api/mentee/me/details", "/api/mentee/me/meetings", "/api/mentee/me/issues",
+    "/api/mentee/me/mentor", "/api/mentee/me/notes", "/api/mentee/me/notifications",
+};
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+static void random_operation(Client* c) {
+    char path[96], body[512], date[16], clock[8], name[64];
+    PoolEntry target;
+    unsigned int op = next_random(c) % 20;
+
+    if (op < 6) { // Mentor dashboard reads
+        request(c, "GET", read_paths[next_random(c) % COUNT_OF(read_paths)], mentor_token, NULL);
+    } else if (op < 8) { // Mentee dashboard reads and reports
+        if (op == 7) {
+            snprintf(body, sizeof(body), "{\"description\":\"Stress question %d-%d\",\"priority\":\"Low\",\"date\":\"2026-10-18\"}", c->index, ++c->seq);
+            if (request(c, "POST", "/api/mentee/me/issues", mentee_token, body) == 201) pool_created(KIND_ISSUE, response_id(&c->resp), NULL);
+        } else {
+            request(c, "GET", mentee_paths[next_random(c) % COUNT_OF(mentee_paths)], mentee_token, NULL);
+        }
+    } else if (op < 10) { // New mentee
+        snprintf(name, sizeof(name), "Stress Mentee %d %d", c->index, ++c->seq);
+        snprintf(body, sizeof(body), "{\"name\":\"%s\",\"subject\":\"Physics\",\"email\":\"stress@example.com\"}", name);
+        if (request(c, "POST", "/api/mentees", mentor_token, body) == 201) pool_created(KIND_MENTEE, response_id(&c->resp), name);
+    } else if (op < 11) { // Delete someone's mentee
+        if (!pool_pick(KIND_MENTEE, next_random(c), &target)) return;
+        snprintf(path, sizeof(path), "/api/mentees/%d", target.id);
+        int status = request(c, "DELETE", path, mentor_token, NULL);
+        if (status >= 200 && status < 300) pool_deleted(KIND_MENTEE, target.id);
+    } else if (op < 13) { // Book a meeting for someone's mentee
+        if (!pool_pick(KIND_MENTEE, next_random(c), &target)) return;
+        random_slot(c, date, sizeof(date), clock, sizeof(clock));
+        snprintf(body, sizeof(body), "{\"mentee\":\"%s\",\"date\":\"%s\",\"time\":\"%s\",\"duration\":%u,\"notes\":\"Stress session %d\",\"allow_conflict\":%s}",
+                 target.name, date, clock, 15 + 15 * (next_random(c) % 4), ++c->seq, (next_random(c) & 1) ? "true" : "false");
+        if (request(c, "POST", "/api/meetings", mentor_token, body) == 201) pool_created(KIND_MEETING, response_id(&c->resp), NULL);
+    } else if (op < 15) { // Reschedule
+        if (!pool_pick(KIND_MEETING, next_random(c), &target)) return;
+        random_slot(c, date, sizeof(date), clock, sizeof(clock));
+        snprintf(path, sizeof(path), "/api/meetings/%d", target.id);
+        snprintf(body, sizeof(body), "{\"date\":\"%s\",\"time\":\"%s\"}", date, clock);
+        request(c, "PATCH", path, mentor_token, body);
+    } else if (op < 16) { // Cancel
+        if (!pool_pick(KIND_MEETING, next_random(c), &target)) return;
+        snprintf(path, sizeof(path), "/api/meetings/%d", target.id);
+        int status = request(c, "DELETE", path, mentor_token, NULL);
+        if (status >= 200 && status < 300) pool_deleted(KIND_MEETING, target.id);
+    } else if (op < 18) { // Report an issue
+        if (!pool_pick(KIND_MENTEE, next_random(c), &target)) return;
+        snprintf(body, sizeof(body), "{\"mentee\":\"%s\",\"description\":\"Stress issue %d-%d\",\"priority\":\"%s\",\"date\":\"2026-10-18\"}",
+                 target.name, c->index, ++c->seq, (next_random(c) & 1) ? "High" : "Medium");
+        if (request(c, "POST", "/api/issues", mentor_token, body) == 201) pool_created(KIND_ISSUE, response_id(&c->resp), NULL);
+    } else { // Move an issue along
+        if (!pool_pick(KIND_ISSUE, next_random(c), &target)) return;
+        static const char* const statuses[] = { "Open", "In Progress", "Resolved" };
+        snprintf(path, sizeof(path), "/api/issues/%d", target.id);
+        snprintf(body, sizeof(body), "{\"status\":\"%s\",\"notes\":\"Stress follow-up %d\"}", statuses[next_random(c) % 3], ++c->seq);
+        request(c, "PATCH", path, mentor_token, body);
+    }
+}
+
+static void* client_main(void* arg) {
+    Client* c = arg;
+    http_conn_init(&c->conn, &server_addr);
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_RELAXED) && c->transport_errors < 10) random_operation(c);
+    http_close(&c->conn);
+    return NULL;
+}
+
+static void* checker_main(void* arg) {
+    long long* checks = arg;
+    char problem[256];
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_RELAXED)) {
+        if (!api_check_consistency(app_data, problem, sizeof(problem))) {
+            fprintf(stderr, "stress: inconsistent data while running: %s\n", problem);
+            __atomic_store_n(&check_failed, 1, __ATOMIC_RELAXED);
+            __atomic_store_n(&stop_flag, 1, __ATOMIC_RELAXED);
+            break;
+        }
+        (*checks)++;
+        usleep(CHECK_INTERVAL_US);
+    }
+    return NULL;
+}
+
+// ========================================================================== //
+//                              FINAL CHECKS                                  //
+// ========================================================================== //
+
+static int compare_int(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int record_exists(RecordKind kind, int id) {
+    switch (kind) {
+    case KIND_MENTEE: return find_mentee_by_id(app_data, id) != NULL;
+    case KIND_MEETING: return find_meeting_by_id(app_data, id) != NULL;
+    default: return find_issue_by_id(app_data, id) != NULL;
+    }
+}
+
+/**
+ * @brief Created ids must be unique; a record must exist iff no DELETE of it succeeded.
+ */
+static int check_pool(RecordKind kind) {
+    RecordPool* pool = &pools[kind];
+    int ok = 1;
+    if (pool->created_count > 0) qsort(pool->created, pool->created_count, sizeof(int), compare_int);
+    if (pool->deleted_count > 0) qsort(pool->deleted, pool->deleted_count, sizeof(int), compare_int);
+    for (size_t i = 0; i < pool->created_count; ++i) {
+        int id = pool->created[i];
+        if (id <= 0 || (i > 0 && id == pool->created[i - 1])) {
+            fprintf(stderr, "stress: %s id %d was handed out twice (or is invalid)\n", kind_names[kind], id);
+            ok = 0;
+            continue;
+        }
+        int deleted = pool->deleted_count > 0 && bsearch(&id, pool->deleted, pool->deleted_count, sizeof(int), compare_int);
+        if (deleted == record_exists(kind, id)) {
+            fprintf(stderr, "stress: %s %d %s\n", kind_names[kind], id, deleted ? "was deleted but still exists" : "is missing");
+            ok = 0;
+        }
+    }
+    for (size_t i = 1; i < pool->deleted_count; ++i) {
+        if (pool->deleted[i] == pool->deleted[i - 1]) {
+            fprintf(stderr, "stress: %s %d was deleted successfully twice\n", kind_names[kind], pool->deleted[i]);
+            ok = 0;
+        }
+    }
+    printf("  %-8s created %6zu  deleted %6zu\n", kind_names[kind], pool->created_count, pool->deleted_count);
+    return ok;
+}
+
+// ========================================================================== //
+//                                  MAIN                                      //
+// ========================================================================== //
+
+static int seed_data(void) {
+    User* mentor = add_user(app_data, "admin", "password", ROLE_MENTOR, 0);
+    Mentee* home = add_mentee(app_data, "Stress Home Mentee", "Mathematics", "home@example.com");
+    User* mentee = home ? add_user(app_data, "user", "password", ROLE_MENTEE, home->id) : NULL;
+    if (!mentor || !mentee) return 0;
+    // Sessions are issued directly so the run does not depend on the login handler
+    SessionInfo mentor_session = { mentor->id, mentor->role, mentor->associated_id };
+    SessionInfo mentee_session = { mentee->id, mentee->role, mentee->associated_id };
+    return session_create(&mentor_session, mentor_token) && session_create(&mentee_session, mentee_token);
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) goto usage;
+        if (0 == strcmp(argv[i], "--threads")) options.threads = atoi(value);
+        else if (0 == strcmp(argv[i], "--duration")) options.duration_s = atof(value);
+        else if (0 == strcmp(argv[i], "--port")) options.port = atoi(value);
+        else if (0 == strcmp(argv[i], "--seed")) options.seed = (unsigned int)strtoul(value, NULL, 10);
+        else if (0 == strcmp(argv[i], "--dir")) options.dir = value;
+        else if (0 == strcmp(argv[i], "--log-level")) options.log_level = atoi(value);
+        else goto usage;
+        i++;
+    }
+    if (options.threads <= 0 || options.threads > MAX_THREADS || options.duration_s <= 0 || options.port <= 0) goto usage;
+
+    char scratch[] = "/tmp/mentor_stress_XXXXXX";
+    const char* dir = options.dir ? options.dir : mkdtemp(scratch);
+    if (!dir || chdir(dir) != 0) {
+        perror("stress: cannot enter scratch directory");
+        return 1;
+    }
+    log_set_level(options.log_level);
+    for (int k = 0; k < KIND_COUNT; ++k) pthread_mutex_init(&pools[k].lock, NULL);
+
+    app_data = create_empty_app_data();
+    if (!app_data || !seed_data()) {
+        fprintf(stderr, "stress: failed to set up data\n");
+        return 1;
+    }
+    struct MHD_Daemon* daemon = MHD_start_daemon(MHD_USE_SELECT_INTERNALLY | MHD_USE_THREAD_PER_CONNECTION,
+                                                 (uint16_t)options.port, NULL, NULL,
+                                                 &request_handler, app_data,
+                                                 MHD_OPTION_NOTIFY_COMPLETED, &request_completed, NULL,
+                                                 MHD_OPTION_NOTIFY_CONNECTION, &connection_notify, NULL,
+                                                 MHD_OPTION_END);
+    if (!daemon) {
+        fprintf(stderr, "stress: failed to start the daemon on port %d\n", options.port);
+        free_app_data(app_data);
+        return 1;
+    }
+    memset(&server_addr, 0, sizeof(server_addr));
+    server_addr.sin_family = AF_INET;
+    server_addr.sin_port = htons((uint16_t)options.port);
+    server_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    printf("stress: %d threads for %.1f s on port %d (in %s)\n", options.threads, options.duration_s, options.port, dir);
+    static Client clients[MAX_THREADS];
+    for (int i = 0; i < options.threads; ++i) {
+        clients[i].index = i;
+        clients[i].rng = (options.seed * 2654435761u) ^ (unsigned int)(i + 1) * 40503u;
+        if (!clients[i].rng) clients[i].rng = 1;
+        if (pthread_create(&clients[i].thread, NULL, client_main, &clients[i]) != 0) {
+            fprintf(stderr, "stress: failed to start client %d\n", i);
+            options.threads = i;
+            break;
+        }
+    }
+    long long checks = 0;
+    pthread_t checker;
+    int checker_started = pthread_create(&checker, NULL, checker_main, &checks) == 0;
+
+    uint64_t deadline = metrics_now_ns() + (uint64_t)(options.duration_s * 1e9);
+    while (!__atomic_load_n(&stop_flag, __ATOMIC_RELAXED) && metrics_now_ns() < deadline) usleep(10000);
+    __atomic_store_n(&stop_flag, 1, __ATOMIC_RELAXED);
+    long long requests = 0, server_errors = 0, transport_errors = 0;
+    for (int i = 0; i < options.threads; ++i) {
+        pthread_join(clients[i].thread, NULL);
+        requests += clients[i].requests;
+        server_errors += clients[i].server_errors;
+        transport_errors += clients[i].transport_errors;
+        free(clients[i].resp.body);
+    }
+    if (checker_started) pthread_join(checker, NULL);
+    MHD_stop_daemon(daemon);
+
+    // Quiescent now: check the final state without the handlers' lock
+    char problem[256];
+    int ok = !__atomic_load_n(&check_failed, __ATOMIC_RELAXED) && server_errors == 0 && transport_errors == 0;
+    printf("stress: %lld requests, %lld consistency checks, %lld server errors, %lld transport errors\n",
+           requests, checks, server_errors, transport_errors);
+    if (!check_app_data_consistency(app_data, problem, sizeof(problem))) {
+        fprintf(stderr, "stress: inconsistent data after the run: %s\n", problem);
+        ok = 0;
+    }
+    for (int k = 0; k < KIND_COUNT; ++k) ok &= check_pool((RecordKind)k);
+
+    free_app_data(app_data);
+    if (log_memory_leaks() > 0) ok = 0;
+    for (int k = 0; k < KIND_COUNT; ++k) {
+        free(pools[k].created);
+        free(pools[k].deleted);
+        pthread_mutex_destroy(&pools[k].lock);
+    }
+    if (!options.dir) {
+        unlink(STRESS_DATA_FILE);
+        rmdir(dir);
+    }
+    printf("stress: %s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+
+usage:
+    fprintf(stderr, "Usage: %s [--threads N] [--duration S] [--port 18080] [--seed S] [--dir DIR] [--log-level 0-4]\n", argv[0]);
+    return 2;
+}
@@ -0,0 +1,297 @@
+#define _GNU_SOURCE // For syscall(SYS_gettid)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "trace.h"
+#include "metrics.h"
+#include "logger.h"
+
+#define TRACE_RING_SLOTS 1024        // Most recent events kept per thread (power of two)
+#define TRACE_DEFAULT_SLOW_MS 500
+
+// ========================================================================== //
+//                             DATA STRUCTURES                                //
+// ========================================================================== //
+
+typedef struct {
+    const char* name;
+    const char* route;      // Set on whole-request events only
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    long tid;               // Stored per event: a recycled ring may change owner
+    int status;
+} TraceEvent;
+
+/**
+ * Per-thread ring that overwrites its oldest events. Only the owning thread
+ * writes; the lock is uncontended except while a dump copies the ring out.
+ * Rings are recycled through a free pool when threads exit, like the log rings.
+ */
+typedef struct TraceRing {
+    TraceEvent slots[TRACE_RING_SLOTS];
+    size_t head;                  // Total events ever written
+    pthread_mutex_t lock;
+    struct TraceRing* next_all;
+    struct TraceRing* next_free;
+} TraceRing;
+
+static TraceRing* all_rings = NULL;
+static TraceRing* free_rings = NULL;
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t ring_key;
+static pthread_once_t ring_key_once = PTHREAD_ONCE_INIT;
+static __thread TraceRing* tls_ring = NULL;
+static __thread long tls_tid = 0;
+static __thread int tls_depth = 0;
+static __thread TraceRequest* tls_request = NULL;
+
+static int tracing_enabled = 1;
+static int64_t slow_threshold_ns = (int64_t)TRACE_DEFAULT_SLOW_MS * 1000000;
+static uint64_t epoch_ns = 0;         // Chrome timestamps are relative to this
+
+// ========================================================================== //
+//                              RING REGISTRY                                 //
+// ========================================================================== //
+
+static void release_ring(void* ptr) {
+    TraceRing* ring = ptr;
+    tls_ring = NULL;
+    pthread_mutex_lock(&registry_lock);
+    ring->next_free = free_rings;
+    free_rings = ring;
+    pthread_mutex_unlock(&registry_lock);
+}
+
+static void create_ring_key(void) {
+    pthread_key_create(&ring_key, release_ring);
+}
+
+static TraceRing* acquire_ring(void) {
+    if (tls_ring) return tls_ring;
+    pthread_once(&ring_key_once, create_ring_key);
+
+    pthread_mutex_lock(&registry_lock);
+    TraceRing* ring = free_rings;
+    if (ring) {
+        free_rings = ring->next_free;
+    } else {
+        ring = calloc(1, sizeof(TraceRing));
+        if (ring) {
+            pthread_mutex_init(&ring->lock, NULL);
+            ring->next_all = all_rings;
+            all_rings = ring;
+        }
+    }
+    pthread_mutex_unlock(&registry_lock);
+    if (!ring) return NULL;
+
+    tls_tid = (long)syscall(SYS_gettid);
+    pthread_setspecific(ring_key, ring);
+    tls_ring = ring;
+    return ring;
+}
+
+static void ring_push(const char* name, const char* route, int status, uint64_t start_ns, uint64_t duration_ns) {
+    TraceRing* ring = acquire_ring();
+    if (!ring) return;
+    pthread_mutex_lock(&ring->lock);
+    TraceEvent* event = &ring->slots[ring->head & (TRACE_RING_SLOTS - 1)];
+    event->name = name;
+    event->route = route;
+    event->start_ns = start_ns;
+    event->duration_ns = duration_ns;
+    event->tid = tls_tid;
+    event->status = status;
+    ring->head++;
+    pthread_mutex_unlock(&ring->lock);
+}
+
+// ========================================================================== //
+//                                 SPANS                                      //
+// ========================================================================== //
+
+void trace_init(void) {
+    epoch_ns = metrics_now_ns();
+    const char* enabled = getenv("MENTOR_TRACE");
+    if (enabled && 0 == strcmp(enabled, "0")) tracing_enabled = 0;
+    const char* slow_ms = getenv("MENTOR_SLOW_REQUEST_MS");
+    if (slow_ms && *slow_ms) {
+        char* end;
+        long ms = strtol(slow_ms, &end, 10);
+        if (*end != '\0') LOG_WARN("Ignoring invalid MENTOR_SLOW_REQUEST_MS '%s'", slow_ms);
+        else slow_threshold_ns = ms < 0 ? -1 : (int64_t)ms * 1000000;
+    }
+    if (slow_threshold_ns >= 0) LOG_INFO("Slow-request log threshold: %lld ms", (long long)(slow_threshold_ns / 1000000));
+}
+
+TraceSpan trace_begin(const char* name) {
+    TraceSpan span = { name, 0 };
+    if (!tracing_enabled) return span;
+    tls_depth++;
+    span.start_ns = metrics_now_ns();
+    return span;
+}
+
+/**
+ * @brief Adds a finished span to the thread ring and the attached request.
+ * 'depth' is the nesting level the span started at.
+ */
+static void record_span(const char* name, uint64_t start_ns, uint64_t end_ns, int depth) {
+    uint64_t duration = end_ns > start_ns ? end_ns - start_ns : 0;
+    ring_push(name, NULL, 0, start_ns, duration);
+    TraceRequest* request = tls_request;
+    if (request && request->span_count < TRACE_MAX_REQUEST_SPANS) {
+        TraceSpanRecord* record = &request->spans[request->span_count++];
+        record->name = name;
+        record->start_ns = start_ns;
+        record->duration_ns = duration;
+        record->depth = depth;
+    }
+}
+
+void trace_end(TraceSpan span) {
+    if (!tracing_enabled || span.start_ns == 0) return;
+    tls_depth--;
+    record_span(span.name, span.start_ns, metrics_now_ns(), tls_depth);
+}
+
+void trace_record(const char* name, uint64_t start_ns, uint64_t end_ns) {
+    if (!tracing_enabled) return;
+    record_span(name, start_ns, end_ns, tls_depth);
+}
+
+void trace_attach_request(TraceRequest* request) {
+    tls_request = request;
+}
+
+/**
+ * @brief Time spent in span 'index' that none of its direct children cover.
+ */
+static uint64_t span_self_time(const TraceRequest* request, int index) {
+    const TraceSpanRecord* parent = &request->spans[index];
+    uint64_t end = parent->start_ns + parent->duration_ns;
+    uint64_t children = 0;
+    for (int i = 0; i < request->span_count; ++i) {
+        const TraceSpanRecord* child = &request->spans[i];
+        if (child->depth == parent->depth + 1 && child->start_ns >= parent->start_ns && child->start_ns < end) {
+            children += child->duration_ns;
+        }
+    }
+    return children < parent->duration_ns ? parent->duration_ns - children : 0;
+}
+
+void trace_finish_request(TraceRequest* request, const char* route_label, int status, uint64_t start_ns, uint64_t end_ns) {
+    uint64_t total = end_ns > start_ns ? end_ns - start_ns : 0;
+    if (tracing_enabled) ring_push("request", route_label, status, start_ns, total);
+    if (!request || slow_threshold_ns < 0 || total < (uint64_t)slow_threshold_ns) return;
+
+    // Spans were recorded as they ended; list them in start order for reading
+    int order[TRACE_MAX_REQUEST_SPANS];
+    for (int i = 0; i < request->span_count; ++i) {
+        int j = i;
+        while (j > 0 && request->spans[order[j - 1]].start_ns > request->spans[i].start_ns) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    char breakdown[768];
+    size_t len = 0;
+    breakdown[0] = '\0';
+    for (int k = 0; k < request->span_count && len < sizeof(breakdown); ++k) {
+        int i = order[k];
+        const TraceSpanRecord* span = &request->spans[i];
+        uint64_t self = span_self_time(request, i);
+        int n;
+        if (self != span->duration_ns) {
+            n = snprintf(breakdown + len, sizeof(breakdown) - len, " %s=%.2fms(self %.2fms)",
+                         span->name, span->duration_ns / 1e6, self / 1e6);
+        } else {
+            n = snprintf(breakdown + len, sizeof(breakdown) - len, " %s=%.2fms",
+                         span->name, span->duration_ns / 1e6);
+        }
+        if (n < 0) break;
+        len += (size_t)n;
+    }
+    LOG_WARN("[SLOW] %s -> %d in %.2fms:%s", route_label ? route_label : "?", status, total / 1e6, breakdown);
+}
+
+// ========================================================================== //
+//                              CHROME EXPORT                                 //
+// ========================================================================== //
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    int failed;
+} TraceText;
+
+static void trace_appendf(TraceText* text, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+static void trace_appendf(TraceText* text, const char* fmt, ...) {
+    if (text->failed) return;
+    for (;;) {
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(text->data + text->length, text->capacity - text->length, fmt, args);
+        va_end(args);
+        if (n < 0) { text->failed = 1; return; }
+        if (text->length + (size_t)n < text->capacity) {
+            text->length += (size_t)n;
+            return;
+        }
+        size_t new_capacity = text->capacity * 2 + (size_t)n;
+        char* grown = realloc(text->data, new_capacity);
+        if (!grown) { text->failed = 1; return; }
+        text->data = grown;
+        text->capacity = new_capacity;
+    }
+}
+
+char* trace_dump_chrome_json(size_t* length_out) {
+    TraceText text = { malloc(65536), 0, 65536, 0 };
+    if (!text.data) return NULL;
+    TraceEvent* copy = malloc(sizeof(TraceEvent) * TRACE_RING_SLOTS);
+    if (!copy) { free(text.data); return NULL; }
+
+    trace_appendf(&text, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    int first = 1;
+    pthread_mutex_lock(&registry_lock);
+    TraceRing* rings = all_rings;
+    pthread_mutex_unlock(&registry_lock);
+
+    // Rings are never freed, so the list can be walked after dropping the lock
+    for (TraceRing* ring = rings; ring; ring = ring->next_all) {
+        pthread_mutex_lock(&ring->lock);
+        size_t count = ring->head < TRACE_RING_SLOTS ? ring->head : TRACE_RING_SLOTS;
+        size_t start = ring->head - count;
+        for (size_t i = 0; i < count; ++i) copy[i] = ring->slots[(start + i) & (TRACE_RING_SLOTS - 1)];
+        pthread_mutex_unlock(&ring->lock);
+
+        for (size_t i = 0; i < count; ++i) {
+            const TraceEvent* event = &copy[i];
+            double ts_us = event->start_ns >= epoch_ns ? (double)(event->start_ns - epoch_ns) / 1e3 : 0.0;
+            trace_appendf(&text, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%ld,\"ts\":%.3f,\"dur\":%.3f",
+                          first ? "" : ",", event->route ? event->route : event->name,
+                          event->route ? "request" : "phase", event->tid, ts_us, (double)event->duration_ns / 1e3);
+            if (event->route) trace_appendf(&text, ",\"args\":{\"status\":%d}", event->status);
+            trace_appendf(&text, "}");
+            first = 0;
+        }
+    }
+    trace_appendf(&text, "]}");
+    free(copy);
+
+    if (text.failed) {
+        free(text.data);
+        return NULL;
+    }
+    if (length_out) *length_out = text.length;
+    return text.data;
+}
@@ -0,0 +1,67 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TRACE_MAX_REQUEST_SPANS 16 // Spans kept per request for the slow-request log
+
+// A span in progress; pass it back to trace_end(). 'name' must be a static string.
+typedef struct {
+    const char* name;
+    uint64_t start_ns;
+} TraceSpan;
+
+// One finished span as remembered for the slow-request log
+typedef struct {
+    const char* name;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    int depth;              // Nesting level when the span began (0 = top level)
+} TraceSpanRecord;
+
+/**
+ * @brief Spans belonging to one request. Lives in the request's own state so
+ * it survives across the MHD callbacks of that request.
+ */
+typedef struct {
+    int span_count;
+    TraceSpanRecord spans[TRACE_MAX_REQUEST_SPANS];
+} TraceRequest;
+
+/**
+ * @brief Reads MENTOR_SLOW_REQUEST_MS (default 500, negative disables the slow
+ * log) and MENTOR_TRACE (0 disables span recording). Call once at startup.
+ */
+void trace_init(void);
+
+// --- Spans ---
+TraceSpan trace_begin(const char* name);
+void trace_end(TraceSpan span);
+
+/**
+ * @brief Records a span whose start was captured earlier (e.g. body upload
+ * spread over several callbacks).
+ */
+void trace_record(const char* name, uint64_t start_ns, uint64_t end_ns);
+
+/**
+ * @brief Makes 'request' the target for spans recorded on this thread until
+ * the next call (NULL detaches). Spans still go to the thread buffer either way.
+ */
+void trace_attach_request(TraceRequest* request);
+
+/**
+ * @brief Records the whole-request span and, when it took longer than the
+ * slow threshold, logs the request's phase breakdown.
+ */
+void trace_finish_request(TraceRequest* request, const char* route_label, int status, uint64_t start_ns, uint64_t end_ns);
+
+/**
+ * @brief Renders every buffered span (all threads, most recent
+ * events per thread) as Chrome trace-event JSON, loadable in chrome://tracing
+ * or Perfetto. Returns a malloc'd string (caller frees) or NULL on OOM.
+ */
+char* trace_dump_chrome_json(size_t* length_out);
+
+#endif // TRACE_H